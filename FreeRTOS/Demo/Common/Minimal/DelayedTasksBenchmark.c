@@ -0,0 +1,189 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+
+
+
+/*
+ * Measures the cost of blocking with a timeout when hundreds of tasks are
+ * already blocked with one.
+ *
+ * dtbNUMBER_OF_SLEEPERS tasks do nothing but call vTaskDelayUntil(), each
+ * with its own period, so every job ends by adding a task to the delayed
+ * tasks and every tick interrupt that unblocks one takes it out again.  As
+ * the sleepers do no other work, the run time stats counter of a sleeper is
+ * the time spent switching to it and blocking it again, the cost of the
+ * insertion into the delayed tasks growing with the number of tasks already
+ * blocked when they are held in a list sorted by wake time.  Unblocking is
+ * done in the tick interrupt, so is charged to whichever task the tick
+ * interrupted, usually the idle task.
+ *
+ * Each sleeper also checks it was never unblocked before its wake time.
+ * Comparing the run time per job with configUSE_DELAY_WHEEL set to 0 and to 1
+ * shows the effect of the timing wheel.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo app includes. */
+#include "DelayedTasksBenchmark.h"
+
+#if( ( configGENERATE_RUN_TIME_STATS != 1 ) || ( configUSE_TRACE_FACILITY != 1 ) )
+	#error configGENERATE_RUN_TIME_STATS and configUSE_TRACE_FACILITY must be 1 to use this demo file.
+#endif
+
+/* The number of tasks blocked with a timeout.  Each has its own stack, so
+boards with little RAM can define a smaller number in FreeRTOSConfig.h. */
+#ifndef dtbNUMBER_OF_SLEEPERS
+	#define dtbNUMBER_OF_SLEEPERS		( 200 )
+#endif
+
+/* Periods are spread between dtbMINIMUM_PERIOD and dtbMINIMUM_PERIOD +
+dtbPERIOD_SPREAD - 1 ticks, multiplying by a number that shares no factor
+with dtbPERIOD_SPREAD so neighbouring sleepers have unrelated periods. */
+#define dtbMINIMUM_PERIOD			( ( TickType_t ) 20 )
+#define dtbPERIOD_SPREAD			( ( TickType_t ) 200 )
+
+#define dtbSLEEPER_PRIORITY			( tskIDLE_PRIORITY + 1 )
+
+#ifndef dtbBENCHMARK_TASK_STACK_SIZE
+	#define dtbBENCHMARK_TASK_STACK_SIZE	configMINIMAL_STACK_SIZE
+#endif
+
+/* Under EDF tasks are created with a period instead of a priority. */
+#if( configUSE_EDF_SCHEDULER == 1 )
+	#define dtbCREATE_TASK( pxCode, pcName, pvParameters, uxPriority, pxHandle, xPeriod ) \
+		xTaskCreatePeriodic( ( pxCode ), ( pcName ), dtbBENCHMARK_TASK_STACK_SIZE, ( pvParameters ), ( uxPriority ), ( pxHandle ), ( xPeriod ) )
+#else
+	#define dtbCREATE_TASK( pxCode, pcName, pvParameters, uxPriority, pxHandle, xPeriod ) \
+		xTaskCreate( ( pxCode ), ( pcName ), dtbBENCHMARK_TASK_STACK_SIZE, ( pvParameters ), ( uxPriority ), ( pxHandle ) )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The period of sleeper uxSleeper.
+ */
+static TickType_t prvSleeperPeriod( UBaseType_t uxSleeper );
+
+/*
+ * Each sleeper blocks until the start of its next period, counting the number
+ * of times it is unblocked.
+ */
+static void prvSleeperTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xSleeperHandles[ dtbNUMBER_OF_SLEEPERS ];
+
+/* The total number of times the sleepers have been unblocked. */
+static volatile uint32_t ulSleeperJobs = 0;
+
+/* Set if a sleeper is unblocked before its wake time. */
+static volatile BaseType_t xErrorDetected = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vStartDelayedTasksBenchmarkTasks( void )
+{
+UBaseType_t uxSleeper;
+
+	for( uxSleeper = 0; uxSleeper < dtbNUMBER_OF_SLEEPERS; uxSleeper++ )
+	{
+		dtbCREATE_TASK( prvSleeperTask, "DTSleep", ( void * ) uxSleeper, dtbSLEEPER_PRIORITY, &( xSleeperHandles[ uxSleeper ] ), prvSleeperPeriod( uxSleeper ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvSleeperPeriod( UBaseType_t uxSleeper )
+{
+	return dtbMINIMUM_PERIOD + ( ( ( TickType_t ) uxSleeper * ( TickType_t ) 37 ) % dtbPERIOD_SPREAD );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSleeperTask( void *pvParameters )
+{
+const TickType_t xPeriod = prvSleeperPeriod( ( UBaseType_t ) pvParameters );
+TickType_t xLastWakeTime, xExpectedWakeTime;
+
+	xLastWakeTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		xExpectedWakeTime = xLastWakeTime + xPeriod;
+		vTaskDelayUntil( &xLastWakeTime, xPeriod );
+
+		/* The tick count can be later than the wake time if other sleepers
+		ran first, but never earlier. */
+		if( ( xTaskGetTickCount() - xExpectedWakeTime ) > xPeriod )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulSleeperJobs++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vGetDelayedTasksBenchmarkResults( DelayedTasksBenchmarkResults_t *pxResults )
+{
+TaskStatus_t xStatus;
+UBaseType_t uxSleeper;
+
+	pxResults->ulSleeperRunTime = 0;
+
+	vTaskSuspendAll();
+	{
+		pxResults->ulJobs = ulSleeperJobs;
+
+		for( uxSleeper = 0; uxSleeper < dtbNUMBER_OF_SLEEPERS; uxSleeper++ )
+		{
+			vTaskGetInfo( xSleeperHandles[ uxSleeper ], &xStatus, pdFALSE, eBlocked );
+			pxResults->ulSleeperRunTime += xStatus.ulRunTimeCounter;
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreDelayedTasksBenchmarkTasksStillRunning( void )
+{
+static uint32_t ulPreviousSleeperJobs = 0;
+BaseType_t xStatus = pdPASS;
+
+	/* Check the sleepers are still being unblocked, and never early. */
+	if( ( ulPreviousSleeperJobs == ulSleeperJobs ) || ( xErrorDetected != pdFALSE ) )
+	{
+		xStatus = pdFAIL;
+	}
+	ulPreviousSleeperJobs = ulSleeperJobs;
+
+	return xStatus;
+}
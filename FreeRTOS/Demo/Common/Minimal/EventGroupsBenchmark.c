@@ -0,0 +1,286 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+
+
+/*
+ * Measures the cost of xEventGroupSetBits() when many tasks are blocked on one
+ * event group but each task only waits for a few of its bits.
+ *
+ * ebbNUMBER_OF_WAITERS tasks block on the same event group.  Each waits for one
+ * bit, and every other task waits for a second bit too (with xWaitForAllBits
+ * set), the bits being spread across the whole group so few tasks share a bit.
+ * The controller task sets a sparse pattern of bits in each round, timing the
+ * call to xEventGroupSetBits() with the scheduler suspended so the time taken
+ * by the tasks it unblocks is not included in the measurement.  It then checks
+ * that exactly the tasks whose wait condition was met ran, before clearing any
+ * bits no task consumed ready for the next round.
+ *
+ * The timer used for the measurement defaults to the run time stats counter
+ * and can be set separately by defining ebbBENCHMARK_TIMER_VALUE().  Comparing
+ * the results with configEVENT_GROUP_WAITER_BUCKETS set to 1 and set to 8 shows
+ * the effect of only visiting the waiters that are interested in the bits set.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+/* Demo app includes. */
+#include "EventGroupsBenchmark.h"
+
+#ifndef ebbBENCHMARK_TIMER_VALUE
+	#if( ( configGENERATE_RUN_TIME_STATS == 1 ) && defined( portGET_RUN_TIME_COUNTER_VALUE ) )
+		#define ebbBENCHMARK_TIMER_VALUE()	( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+	#else
+		#error Define ebbBENCHMARK_TIMER_VALUE() or enable run time stats to use this demo file.
+	#endif
+#endif
+
+/* The number of tasks blocked on the event group.  Each has its own stack, so
+boards with little RAM can define a smaller number in FreeRTOSConfig.h. */
+#ifndef ebbNUMBER_OF_WAITERS
+	#define ebbNUMBER_OF_WAITERS		( 32 )
+#endif
+
+/* The number of bits that can be used in an event group. */
+#if( configUSE_16_BIT_TICKS == 1 )
+	#define ebbEVENT_BITS			( 8 )
+#else
+	#define ebbEVENT_BITS			( 24 )
+#endif
+
+/* The controller runs after the waiters it unblocks have blocked again. */
+#define ebbWAITER_PRIORITY			( tskIDLE_PRIORITY + 2 )
+#define ebbCONTROLLER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define ebbWAITER_PERIOD			pdMS_TO_TICKS( ( TickType_t ) 20 )
+#define ebbCONTROLLER_PERIOD		pdMS_TO_TICKS( ( TickType_t ) 100 )
+#define ebbROUND_DELAY				pdMS_TO_TICKS( ( TickType_t ) 10 )
+
+#ifndef ebbBENCHMARK_TASK_STACK_SIZE
+	#define ebbBENCHMARK_TASK_STACK_SIZE	configMINIMAL_STACK_SIZE
+#endif
+
+/* Under EDF tasks are created with a period instead of a priority. */
+#if( configUSE_EDF_SCHEDULER == 1 )
+	#define ebbCREATE_TASK( pxCode, pcName, pvParameters, uxPriority, xPeriod ) \
+		xTaskCreatePeriodic( ( pxCode ), ( pcName ), ebbBENCHMARK_TASK_STACK_SIZE, ( pvParameters ), ( uxPriority ), NULL, ( xPeriod ) )
+#else
+	#define ebbCREATE_TASK( pxCode, pcName, pvParameters, uxPriority, xPeriod ) \
+		xTaskCreate( ( pxCode ), ( pcName ), ebbBENCHMARK_TASK_STACK_SIZE, ( pvParameters ), ( uxPriority ), NULL )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The bits waited for by waiter uxWaiter.  Multiplying by a number that shares
+ * no factor with ebbEVENT_BITS spreads consecutive waiters across the group.
+ */
+static EventBits_t prvWaiterBits( UBaseType_t uxWaiter );
+
+/*
+ * Each waiter blocks on the bits returned by prvWaiterBits(), clearing them on
+ * exit, and counts the number of times it is unblocked.
+ */
+static void prvWaiterTask( void *pvParameters );
+
+/*
+ * Sets a different sparse pattern of bits in each round, timing each call and
+ * checking the right waiters ran.
+ */
+static void prvControllerTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static EventGroupHandle_t xBenchmarkEventGroup = NULL;
+
+/* The number of times each waiter has been unblocked. */
+static volatile uint32_t ulWaiterCycles[ ebbNUMBER_OF_WAITERS ];
+
+/* Measurements, and a count of the rounds completed without error. */
+static EventGroupBenchmarkResults_t xResults;
+static volatile uint32_t ulControllerCycles = 0;
+
+/*-----------------------------------------------------------*/
+
+void vStartEventGroupBenchmarkTasks( void )
+{
+UBaseType_t uxWaiter;
+
+	xBenchmarkEventGroup = xEventGroupCreate();
+	configASSERT( xBenchmarkEventGroup );
+
+	xResults.ulMinimumSetBitsTime = UINT32_MAX;
+
+	for( uxWaiter = 0; uxWaiter < ebbNUMBER_OF_WAITERS; uxWaiter++ )
+	{
+		ebbCREATE_TASK( prvWaiterTask, "EBWait", ( void * ) uxWaiter, ebbWAITER_PRIORITY, ebbWAITER_PERIOD );
+	}
+
+	ebbCREATE_TASK( prvControllerTask, "EBCtrl", NULL, ebbCONTROLLER_PRIORITY, ebbCONTROLLER_PERIOD );
+}
+/*-----------------------------------------------------------*/
+
+static EventBits_t prvWaiterBits( UBaseType_t uxWaiter )
+{
+EventBits_t uxBits;
+
+	uxBits = ( EventBits_t ) 1 << ( ( uxWaiter * 5U ) % ebbEVENT_BITS );
+
+	if( ( uxWaiter & 0x01U ) != 0U )
+	{
+		uxBits |= ( EventBits_t ) 1 << ( ( uxWaiter * 11U + 3U ) % ebbEVENT_BITS );
+	}
+
+	return uxBits;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+UBaseType_t uxWaiter = ( UBaseType_t ) pvParameters;
+EventBits_t uxBits = prvWaiterBits( uxWaiter );
+BaseType_t xWaitForAllBits = ( ( uxWaiter & 0x01U ) != 0U ) ? pdTRUE : pdFALSE;
+
+	for( ;; )
+	{
+		( void ) xEventGroupWaitBits( xBenchmarkEventGroup, uxBits, pdTRUE, xWaitForAllBits, portMAX_DELAY );
+		ulWaiterCycles[ uxWaiter ]++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvControllerTask( void *pvParameters )
+{
+uint32_t ulRound = 0, ulStartTime, ulElapsed, ulBefore[ ebbNUMBER_OF_WAITERS ];
+EventBits_t uxPattern, uxWaiterBits;
+UBaseType_t uxWaiter, uxExpected;
+BaseType_t xError = pdFALSE;
+
+	/* Avoid compiler warnings. */
+	( void ) pvParameters;
+
+	/* Let every waiter block before the first round. */
+	vTaskDelay( ebbROUND_DELAY );
+
+	for( ;; )
+	{
+		/* Set two bits in most rounds so some of the tasks that wait for two
+		bits are unblocked, and one bit in every fourth round. */
+		uxPattern = ( EventBits_t ) 1 << ( ulRound % ebbEVENT_BITS );
+
+		if( ( ulRound & 0x03UL ) != 0UL )
+		{
+			uxPattern |= ( EventBits_t ) 1 << ( ( ulRound * 7UL + 1UL ) % ebbEVENT_BITS );
+		}
+
+		for( uxWaiter = 0; uxWaiter < ebbNUMBER_OF_WAITERS; uxWaiter++ )
+		{
+			ulBefore[ uxWaiter ] = ulWaiterCycles[ uxWaiter ];
+		}
+
+		vTaskSuspendAll();
+		{
+			ulStartTime = ebbBENCHMARK_TIMER_VALUE();
+			( void ) xEventGroupSetBits( xBenchmarkEventGroup, uxPattern );
+			ulElapsed = ebbBENCHMARK_TIMER_VALUE() - ulStartTime;
+		}
+		( void ) xTaskResumeAll();
+
+		/* Give the unblocked waiters time to run and block again. */
+		vTaskDelay( ebbROUND_DELAY );
+
+		for( uxWaiter = 0; uxWaiter < ebbNUMBER_OF_WAITERS; uxWaiter++ )
+		{
+			uxWaiterBits = prvWaiterBits( uxWaiter );
+
+			if( ( uxWaiter & 0x01U ) != 0U )
+			{
+				uxExpected = ( ( uxPattern & uxWaiterBits ) == uxWaiterBits ) ? 1U : 0U;
+			}
+			else
+			{
+				uxExpected = ( ( uxPattern & uxWaiterBits ) != 0U ) ? 1U : 0U;
+			}
+
+			if( ( ulWaiterCycles[ uxWaiter ] - ulBefore[ uxWaiter ] ) != ( uint32_t ) uxExpected )
+			{
+				xError = pdTRUE;
+			}
+		}
+
+		( void ) xEventGroupClearBits( xBenchmarkEventGroup, uxPattern );
+
+		if( ulElapsed < xResults.ulMinimumSetBitsTime )
+		{
+			xResults.ulMinimumSetBitsTime = ulElapsed;
+		}
+
+		if( ulElapsed > xResults.ulMaximumSetBitsTime )
+		{
+			xResults.ulMaximumSetBitsTime = ulElapsed;
+		}
+
+		xResults.ulTotalSetBitsTime += ulElapsed;
+		xResults.ulSetBitsCalls++;
+		ulRound++;
+
+		/* Only increment the cycle variable if no errors have been detected. */
+		if( xError == pdFALSE )
+		{
+			ulControllerCycles++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vGetEventGroupBenchmarkResults( EventGroupBenchmarkResults_t *pxResults )
+{
+	taskENTER_CRITICAL();
+	{
+		*pxResults = xResults;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreEventGroupBenchmarkTasksStillRunning( void )
+{
+static uint32_t ulPreviousControllerCycles = 0;
+BaseType_t xStatus = pdPASS;
+
+	/* Check the controller is still cycling without finding any errors. */
+	if( ulPreviousControllerCycles == ulControllerCycles )
+	{
+		xStatus = pdFAIL;
+	}
+	ulPreviousControllerCycles = ulControllerCycles;
+
+	return xStatus;
+}
@@ -0,0 +1,375 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+
+/*
+ * Measures the worst case time taken by pvPortMalloc() and vPortFree(), and
+ * how fragmented the heap becomes, when tasks and queues are created and
+ * deleted at run time.
+ *
+ * One task repeatedly allocates and frees blocks the size of a task control
+ * block, a task stack and a queue storage area, picked by a pseudo random
+ * sequence that starts from the same seed in every pass, so every heap
+ * implementation is given exactly the same requests.  No more than
+ * hpbMAXIMUM_LIVE_BYTES are allocated at once, so the benchmark can run
+ * alongside an application that shares the heap.  Each call is timed with
+ * interrupts disabled so the time of any interrupt is not included.
+ *
+ * An allocation that fails although the heap has more free bytes than were
+ * requested, with room for a block header, is counted as a fragmentation
+ * failure.  At the end of each pass, with the pass's blocks still allocated,
+ * the free bytes are compared with the largest block that can still be
+ * allocated, found by a binary search of trial allocations.  heap_2.c does not
+ * combine freed blocks, so the trial allocations fragment it a little further,
+ * as any other request would.  Everything is then freed, and the number of
+ * free bytes must be back to where the pass started.
+ *
+ * The timer used for the measurement defaults to the run time stats counter
+ * and can be set separately by defining hpbBENCHMARK_TIMER_VALUE().  Only one
+ * heap can be linked at a time, so build with heap_2.c, heap_4.c and
+ * heap_tlsf.c in turn and compare the results.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo app includes. */
+#include "HeapBenchmark.h"
+
+#ifndef hpbBENCHMARK_TIMER_VALUE
+	#if( ( configGENERATE_RUN_TIME_STATS == 1 ) && defined( portGET_RUN_TIME_COUNTER_VALUE ) )
+		#define hpbBENCHMARK_TIMER_VALUE()	( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+	#else
+		#error Define hpbBENCHMARK_TIMER_VALUE() or enable run time stats to use this demo file.
+	#endif
+#endif
+
+/* The number of blocks that can be allocated at once, and the most bytes they
+can take between them. */
+#define hpbNUMBER_OF_BLOCKS			( 24 )
+#ifndef hpbMAXIMUM_LIVE_BYTES
+	#define hpbMAXIMUM_LIVE_BYTES	( ( size_t ) 4096 )
+#endif
+
+/* More than the block header and alignment padding of any of the heaps, so a
+failure to allocate a block this much smaller than the free bytes is down to
+fragmentation. */
+#define hpbHEAP_OVERHEAD			( ( size_t ) 32 )
+
+/* Each job does hpbOPERATIONS_PER_JOB allocations or frees, and a pass is
+hpbJOBS_PER_PASS jobs. */
+#define hpbOPERATIONS_PER_JOB		( 16 )
+#define hpbJOBS_PER_PASS			( 64 )
+
+#define hpbPRIORITY					( tskIDLE_PRIORITY + 1 )
+#define hpbPERIOD					pdMS_TO_TICKS( ( TickType_t ) 100 )
+
+/* The seed of the pseudo random sequence, used again at the start of each
+pass. */
+#define hpbSEED						( 0x2545F491UL )
+
+#ifndef hpbBENCHMARK_TASK_STACK_SIZE
+	#define hpbBENCHMARK_TASK_STACK_SIZE	configMINIMAL_STACK_SIZE
+#endif
+
+/* Under EDF tasks are created with a period instead of a priority. */
+#if( configUSE_EDF_SCHEDULER == 1 )
+	#define hpbCREATE_TASK( pxCode, pcName, pvParameters, uxPriority, xPeriod ) \
+		xTaskCreatePeriodic( ( pxCode ), ( pcName ), hpbBENCHMARK_TASK_STACK_SIZE, ( pvParameters ), ( uxPriority ), NULL, ( xPeriod ) )
+#else
+	#define hpbCREATE_TASK( pxCode, pcName, pvParameters, uxPriority, xPeriod ) \
+		xTaskCreate( ( pxCode ), ( pcName ), hpbBENCHMARK_TASK_STACK_SIZE, ( pvParameters ), ( uxPriority ), NULL )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the next number of the pseudo random sequence.
+ */
+static uint32_t prvRand( void );
+
+/*
+ * The size of the next block to allocate - a task control block, a stack of
+ * one to four times the minimal size, or a queue storage area of up to 256
+ * bytes.
+ */
+static size_t prvNextBlockSize( void );
+
+/*
+ * Allocates or frees the block in slot uxBlock, timing the call.
+ */
+static void prvAllocateBlock( UBaseType_t uxBlock );
+static void prvFreeBlock( UBaseType_t uxBlock );
+
+/*
+ * Returns the size of the largest block pvPortMalloc() can still return.
+ */
+static size_t prvLargestAllocation( void );
+
+/*
+ * Runs the passes, one chunk of operations per period.
+ */
+static void prvHeapBenchmarkTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static void *pvBlocks[ hpbNUMBER_OF_BLOCKS ];
+static size_t xBlockSizes[ hpbNUMBER_OF_BLOCKS ];
+static size_t xLiveBytes = 0;
+
+static uint32_t ulRandState = hpbSEED;
+
+/* Measurements, and a count of the passes completed without error. */
+static HeapBenchmarkResults_t xResults;
+static volatile uint32_t ulBenchmarkCycles = 0;
+
+/*-----------------------------------------------------------*/
+
+void vStartHeapBenchmarkTasks( void )
+{
+	hpbCREATE_TASK( prvHeapBenchmarkTask, "HeapBm", NULL, hpbPRIORITY, hpbPERIOD );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+	/* A linear congruential generator, so the sequence is the same on every
+	target. */
+	ulRandState = ( ulRandState * 1664525UL ) + 1013904223UL;
+
+	return ulRandState >> 8;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvNextBlockSize( void )
+{
+uint32_t ulRand = prvRand();
+size_t xSize;
+
+	switch( ulRand % 3UL )
+	{
+		case 0	:	xSize = sizeof( StaticTask_t );
+					break;
+
+		case 1	:	xSize = ( size_t ) configMINIMAL_STACK_SIZE * sizeof( StackType_t ) * ( size_t ) ( ( ( ulRand >> 4 ) & 0x03UL ) + 1UL );
+					break;
+
+		default	:	xSize = ( size_t ) ( ( ( ulRand >> 4 ) & 0xFFUL ) + 1UL );
+					break;
+	}
+
+	return xSize;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAllocateBlock( UBaseType_t uxBlock )
+{
+size_t xSize, xFreeBytes;
+uint32_t ulStartTime, ulElapsed;
+
+	xSize = prvNextBlockSize();
+
+	if( ( xLiveBytes + xSize ) <= hpbMAXIMUM_LIVE_BYTES )
+	{
+		xFreeBytes = xPortGetFreeHeapSize();
+
+		taskENTER_CRITICAL();
+		{
+			ulStartTime = hpbBENCHMARK_TIMER_VALUE();
+			pvBlocks[ uxBlock ] = pvPortMalloc( xSize );
+			ulElapsed = hpbBENCHMARK_TIMER_VALUE() - ulStartTime;
+		}
+		taskEXIT_CRITICAL();
+
+		if( ulElapsed > xResults.ulMaximumMallocTime )
+		{
+			xResults.ulMaximumMallocTime = ulElapsed;
+		}
+
+		xResults.ulMallocCalls++;
+
+		if( pvBlocks[ uxBlock ] != NULL )
+		{
+			xBlockSizes[ uxBlock ] = xSize;
+			xLiveBytes += xSize;
+		}
+		else if( xFreeBytes >= ( xSize + hpbHEAP_OVERHEAD ) )
+		{
+			xResults.ulFragmentationFailures++;
+		}
+		else
+		{
+			/* The heap is full, which is not a fault of the allocator. */
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeBlock( UBaseType_t uxBlock )
+{
+uint32_t ulStartTime, ulElapsed;
+
+	taskENTER_CRITICAL();
+	{
+		ulStartTime = hpbBENCHMARK_TIMER_VALUE();
+		vPortFree( pvBlocks[ uxBlock ] );
+		ulElapsed = hpbBENCHMARK_TIMER_VALUE() - ulStartTime;
+	}
+	taskEXIT_CRITICAL();
+
+	if( ulElapsed > xResults.ulMaximumFreeTime )
+	{
+		xResults.ulMaximumFreeTime = ulElapsed;
+	}
+
+	xResults.ulFreeCalls++;
+	xLiveBytes -= xBlockSizes[ uxBlock ];
+	pvBlocks[ uxBlock ] = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvLargestAllocation( void )
+{
+size_t xLow = 0, xHigh, xSize;
+void *pvBlock;
+
+	/* No block can be larger than the free bytes. */
+	xHigh = xPortGetFreeHeapSize();
+
+	while( xLow < xHigh )
+	{
+		xSize = xHigh - ( ( xHigh - xLow ) / 2 );
+		pvBlock = pvPortMalloc( xSize );
+
+		if( pvBlock != NULL )
+		{
+			vPortFree( pvBlock );
+			xLow = xSize;
+		}
+		else
+		{
+			xHigh = xSize - 1;
+		}
+	}
+
+	return xLow;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapBenchmarkTask( void *pvParameters )
+{
+TickType_t xLastWakeTime;
+UBaseType_t uxJob, uxOperation, uxBlock;
+size_t xFreeBytesAtStart;
+BaseType_t xError = pdFALSE;
+
+	/* Avoid compiler warnings. */
+	( void ) pvParameters;
+
+	xLastWakeTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		ulRandState = hpbSEED;
+		xFreeBytesAtStart = xPortGetFreeHeapSize();
+
+		for( uxJob = 0; uxJob < hpbJOBS_PER_PASS; uxJob++ )
+		{
+			for( uxOperation = 0; uxOperation < hpbOPERATIONS_PER_JOB; uxOperation++ )
+			{
+				uxBlock = ( UBaseType_t ) ( prvRand() % ( uint32_t ) hpbNUMBER_OF_BLOCKS );
+
+				if( pvBlocks[ uxBlock ] == NULL )
+				{
+					prvAllocateBlock( uxBlock );
+				}
+				else
+				{
+					prvFreeBlock( uxBlock );
+				}
+			}
+
+			vTaskDelayUntil( &xLastWakeTime, hpbPERIOD );
+		}
+
+		/* The heap is at its most fragmented with the blocks still
+		allocated. */
+		xResults.xFreeBytes = xPortGetFreeHeapSize();
+		xResults.xLargestAllocation = prvLargestAllocation();
+
+		for( uxBlock = 0; uxBlock < hpbNUMBER_OF_BLOCKS; uxBlock++ )
+		{
+			if( pvBlocks[ uxBlock ] != NULL )
+			{
+				prvFreeBlock( uxBlock );
+			}
+		}
+
+		/* Every byte allocated by the pass must have been returned. */
+		if( xPortGetFreeHeapSize() != xFreeBytesAtStart )
+		{
+			xError = pdTRUE;
+		}
+
+		xResults.ulPasses++;
+
+		/* Only increment the cycle variable if no errors have been detected. */
+		if( xError == pdFALSE )
+		{
+			ulBenchmarkCycles++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vGetHeapBenchmarkResults( HeapBenchmarkResults_t *pxResults )
+{
+	taskENTER_CRITICAL();
+	{
+		*pxResults = xResults;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreHeapBenchmarkTasksStillRunning( void )
+{
+static uint32_t ulPreviousBenchmarkCycles = 0;
+BaseType_t xStatus = pdPASS;
+
+	/* Check a pass has completed without error since the last call.  A pass
+	takes hpbJOBS_PER_PASS periods. */
+	if( ulPreviousBenchmarkCycles == ulBenchmarkCycles )
+	{
+		xStatus = pdFAIL;
+	}
+	ulPreviousBenchmarkCycles = ulBenchmarkCycles;
+
+	return xStatus;
+}
@@ -0,0 +1,52 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+
+
+/*
+ * Times xEventGroupSetBits() with many tasks blocked on one event group, each
+ * waiting for a sparse set of its bits.  See EventGroupsBenchmark.c.
+ */
+
+#ifndef EVENT_GROUPS_BENCHMARK_H
+#define EVENT_GROUPS_BENCHMARK_H
+
+/* Times are in counts of ebbBENCHMARK_TIMER_VALUE(). */
+typedef struct xEVENT_GROUP_BENCHMARK_RESULTS
+{
+	uint32_t ulSetBitsCalls;
+	uint32_t ulMinimumSetBitsTime;
+	uint32_t ulMaximumSetBitsTime;
+	uint32_t ulTotalSetBitsTime;
+} EventGroupBenchmarkResults_t;
+
+void vStartEventGroupBenchmarkTasks( void );
+BaseType_t xAreEventGroupBenchmarkTasksStillRunning( void );
+void vGetEventGroupBenchmarkResults( EventGroupBenchmarkResults_t *pxResults );
+
+#endif /* EVENT_GROUPS_BENCHMARK_H */
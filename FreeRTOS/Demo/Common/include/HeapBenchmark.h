@@ -0,0 +1,58 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+
+/*
+ * Times pvPortMalloc() and vPortFree(), and measures fragmentation, under the
+ * allocations made by creating and deleting tasks and queues.  See
+ * HeapBenchmark.c.
+ */
+
+#ifndef HEAP_BENCHMARK_H
+#define HEAP_BENCHMARK_H
+
+/* Times are in counts of hpbBENCHMARK_TIMER_VALUE().  The free bytes and the
+largest allocation are taken at the end of the last pass, before its blocks are
+freed. */
+typedef struct xHEAP_BENCHMARK_RESULTS
+{
+	uint32_t ulPasses;
+	uint32_t ulMallocCalls;
+	uint32_t ulFreeCalls;
+	uint32_t ulMaximumMallocTime;
+	uint32_t ulMaximumFreeTime;
+	uint32_t ulFragmentationFailures;
+	size_t xFreeBytes;
+	size_t xLargestAllocation;
+} HeapBenchmarkResults_t;
+
+void vStartHeapBenchmarkTasks( void );
+BaseType_t xAreHeapBenchmarkTasksStillRunning( void );
+void vGetHeapBenchmarkResults( HeapBenchmarkResults_t *pxResults );
+
+#endif /* HEAP_BENCHMARK_H */
@@ -63,7 +63,8 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 typedef struct EventGroupDef_t
 {
 	EventBits_t uxEventBits;
-	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
+	List_t xTasksWaitingForBits[ configEVENT_GROUP_WAITER_BUCKETS ];		/*< Lists of tasks waiting for a bit to be set, indexed by a hash of the bits each task waits for. */
+	EventBits_t uxBitsWaitedForInBucket[ configEVENT_GROUP_WAITER_BUCKETS ];	/*< All the bits waited for by the tasks in each list - may include bits of tasks that have since left the list. */
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxEventGroupNumber;
@@ -76,6 +77,18 @@ typedef struct EventGroupDef_t
 
 /*-----------------------------------------------------------*/
 
+/*
+ * Initialises the lists of tasks waiting for bits.
+ */
+static void prvInitialiseWaiterBuckets( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task on the waiter list indexed by the sum of the
+ * positions of the bits in uxBitsToWaitFor.  Must be called with the scheduler
+ * suspended.
+ */
+static void prvPlaceOnWaiterBucket( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor, const EventBits_t uxControlBits, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /*
  * Test the bits set in uxCurrentEventBits to see if the wait condition is met.
  * The wait condition is defined by xWaitForAllBits.  If xWaitForAllBits is
@@ -113,7 +126,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaiterBuckets( pxEventBits );
 
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
@@ -164,7 +177,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaiterBuckets( pxEventBits );
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -229,7 +242,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				prvPlaceOnWaiterBucket( pxEventBits, uxBitsToWaitFor, ( eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -384,7 +397,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			prvPlaceOnWaiterBucket( pxEventBits, uxBitsToWaitFor, uxControlBits, xTicksToWait );
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -521,85 +534,119 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
 ListItem_t *pxListItem, *pxNext;
 ListItem_t const *pxListEnd;
 List_t const * pxList;
-EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+List_t xReadiedTasks;
+EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits, uxBitsStillWaitedFor;
 EventGroup_t *pxEventBits = xEventGroup;
 BaseType_t xMatchFound = pdFALSE;
+UBaseType_t uxBucket;
 
 	/* Check the user is not attempting to set the bits used by the kernel
 	itself. */
 	configASSERT( xEventGroup );
 	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-	pxList = &( pxEventBits->xTasksWaitingForBits );
-	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 	vTaskSuspendAll();
 	{
 		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-		pxListItem = listGET_HEAD_ENTRY( pxList );
+		/* Tasks unblocked below are collected here and added to the ready
+		list together once every list has been checked. */
+		vListInitialise( &xReadiedTasks );
 
 		/* Set the bits. */
 		pxEventBits->uxEventBits |= uxBitsToSet;
 
-		/* See if the new bit value should unblock any tasks. */
-		while( pxListItem != pxListEnd )
+		/* A waiting task's condition was not met when it blocked, and
+		clearing bits cannot meet it, so only a task waiting for one of the
+		bits being set now can be unblocked.  Skip the lists that hold no such
+		task. */
+		for( uxBucket = 0; uxBucket < ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS; uxBucket++ )
 		{
-			pxNext = listGET_NEXT( pxListItem );
-			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-			xMatchFound = pdFALSE;
+			if( ( pxEventBits->uxBitsWaitedForInBucket[ uxBucket ] & uxBitsToSet ) != ( EventBits_t ) 0 )
+			{
+				pxList = &( pxEventBits->xTasksWaitingForBits[ uxBucket ] );
+				pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+				pxListItem = listGET_HEAD_ENTRY( pxList );
 
-			/* Split the bits waited for from the control bits. */
-			uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-			uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+				/* The bits waited for by the tasks that stay in the list, which
+				also drops the bits of tasks that timed out since the list was last
+				walked. */
+				uxBitsStillWaitedFor = 0;
 
-			if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-			{
-				/* Just looking for single bit being set. */
-				if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+				/* See if the new bit value should unblock any tasks. */
+				while( pxListItem != pxListEnd )
 				{
-					xMatchFound = pdTRUE;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
+					pxNext = listGET_NEXT( pxListItem );
+					uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+					xMatchFound = pdFALSE;
+
+					/* Split the bits waited for from the control bits. */
+					uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+					uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+					if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+					{
+						/* Just looking for single bit being set. */
+						if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+						{
+							xMatchFound = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+					{
+						/* All bits are set. */
+						xMatchFound = pdTRUE;
+					}
+					else
+					{
+						/* Need all bits to be set, but not all the bits were set. */
+					}
+
+					if( xMatchFound != pdFALSE )
+					{
+						/* The bits match.  Should the bits be cleared on exit? */
+						if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+						{
+							uxBitsToClear |= uxBitsWaitedFor;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						/* Store the actual event flag value in the task's event list
+						item before removing the task from the event list.  The
+						eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+						that is was unblocked due to its required bits matching, rather
+						than because it timed out. */
+						vTaskStageFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET, &xReadiedTasks );
+					}
+					else
+					{
+						uxBitsStillWaitedFor |= uxBitsWaitedFor;
+					}
+
+					/* Move onto the next list item.  Note pxListItem->pxNext is not
+					used here as the list item may have been removed from the event list
+					and inserted into the ready/pending reading list. */
+					pxListItem = pxNext;
 				}
-			}
-			else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-			{
-				/* All bits are set. */
-				xMatchFound = pdTRUE;
+
+				pxEventBits->uxBitsWaitedForInBucket[ uxBucket ] = uxBitsStillWaitedFor;
 			}
 			else
 			{
-				/* Need all bits to be set, but not all the bits were set. */
-			}
-
-			if( xMatchFound != pdFALSE )
-			{
-				/* The bits match.  Should the bits be cleared on exit? */
-				if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-				{
-					uxBitsToClear |= uxBitsWaitedFor;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-
-				/* Store the actual event flag value in the task's event list
-				item before removing the task from the event list.  The
-				eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-				that is was unblocked due to its required bits matching, rather
-				than because it timed out. */
-				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+				mtCOVERAGE_TEST_MARKER();
 			}
-
-			/* Move onto the next list item.  Note pxListItem->pxNext is not
-			used here as the list item may have been removed from the event list
-			and inserted into the ready/pending reading list. */
-			pxListItem = pxNext;
 		}
 
+		/* One pass over the ready list for every task unblocked above. */
+		vTaskAddStagedTasksToReadyList( &xReadiedTasks );
+
 		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
 		bit was set in the control word. */
 		pxEventBits->uxEventBits &= ~uxBitsToClear;
@@ -613,20 +660,31 @@ BaseType_t xMatchFound = pdFALSE;
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
 EventGroup_t *pxEventBits = xEventGroup;
-const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+const List_t *pxTasksWaitingForBits;
+List_t xReadiedTasks;
+UBaseType_t uxBucket;
 
 	vTaskSuspendAll();
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
-		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+		vListInitialise( &xReadiedTasks );
+
+		for( uxBucket = 0; uxBucket < ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS; uxBucket++ )
 		{
-			/* Unblock the task, returning 0 as the event list is being deleted
-			and cannot therefore have any bits set. */
-			configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits[ uxBucket ] );
+
+			while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+			{
+				/* Unblock the task, returning 0 as the event list is being deleted
+				and cannot therefore have any bits set. */
+				configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+				vTaskStageFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET, &xReadiedTasks );
+			}
 		}
 
+		vTaskAddStagedTasksToReadyList( &xReadiedTasks );
+
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
 			/* The event group can only have been allocated dynamically - free
@@ -668,6 +726,52 @@ void vEventGroupClearBitsCallback( void *pvEventGroup, const uint32_t ulBitsToCl
 }
 /*-----------------------------------------------------------*/
 
+static void prvInitialiseWaiterBuckets( EventGroup_t *pxEventBits )
+{
+UBaseType_t uxBucket;
+
+	for( uxBucket = 0; uxBucket < ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS; uxBucket++ )
+	{
+		vListInitialise( &( pxEventBits->xTasksWaitingForBits[ uxBucket ] ) );
+		pxEventBits->uxBitsWaitedForInBucket[ uxBucket ] = 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPlaceOnWaiterBucket( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor, const EventBits_t uxControlBits, const TickType_t xTicksToWait )
+{
+UBaseType_t uxBucket = 0, uxBitPosition = 0;
+EventBits_t uxBits = uxBitsToWaitFor;
+
+	configASSERT( uxBits != ( EventBits_t ) 0 );
+
+	/* Index the task by the sum of the positions of all the bits it waits
+	for.  Tasks waiting for different single bits land in different lists, and
+	tasks that share one bit but wait for different others are still spread
+	across the lists.  The list's record of the bits its tasks wait for is what
+	xEventGroupSetBits() tests. */
+	while( uxBits != ( EventBits_t ) 0 )
+	{
+		if( ( uxBits & ( EventBits_t ) 1 ) != ( EventBits_t ) 0 )
+		{
+			uxBucket += uxBitPosition;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxBits >>= 1;
+		uxBitPosition++;
+	}
+
+	uxBucket %= ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS;
+	pxEventBits->uxBitsWaitedForInBucket[ uxBucket ] |= uxBitsToWaitFor;
+
+	vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits[ uxBucket ] ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits )
 {
 BaseType_t xWaitConditionMet = pdFALSE;
@@ -58,6 +58,11 @@ extern "C" {
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
+/* Must be defaulted before portable.h is included. */
+#ifndef configUSE_HEAP_INSTRUMENTATION
+	#define configUSE_HEAP_INSTRUMENTATION 0
+#endif
+
 /* Definitions specific to the port being used. */
 #include "portable.h"
 
@@ -194,6 +199,56 @@ extern "C" {
 	#define configUSE_APPLICATION_TASK_TAG 0
 #endif
 
+#ifndef configUSE_EDF_SCHEDULER
+	#define configUSE_EDF_SCHEDULER 0
+#endif
+
+#ifndef configUSE_EDF_SLACK_STEALING
+	#define configUSE_EDF_SLACK_STEALING 0
+#endif
+
+#if ( ( configUSE_EDF_SLACK_STEALING == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
+	#error configUSE_EDF_SLACK_STEALING requires configUSE_EDF_SCHEDULER to be set to 1.
+#endif
+
+#ifndef configEDF_SLACK_MAX_DEADLINE_CHECKS
+	/* The most deadlines visited each time the slack is calculated.  The
+	slack is reported as zero if the busy period has more.  Raise it for task
+	sets with a utilisation close to one or with very different periods. */
+	#define configEDF_SLACK_MAX_DEADLINE_CHECKS 64
+#endif
+
+#ifndef configUSE_EDF_HIGH_RES_TIME
+	/* Set to 1 to release EDF jobs and measure their deadlines on a free
+	running high resolution timer instead of the tick.  The port then provides
+	portEDF_GET_HIGH_RES_TIME() and portEDF_SET_HIGH_RES_ALARM(), and calls
+	xTaskHighResTimeAlarm() when the alarm fires.  The tick still times
+	everything else, such as the timeouts of blocking API functions. */
+	#define configUSE_EDF_HIGH_RES_TIME 0
+#endif
+
+#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+	#if ( configUSE_EDF_SCHEDULER == 0 )
+		#error configUSE_EDF_HIGH_RES_TIME requires configUSE_EDF_SCHEDULER to be set to 1.
+	#endif
+
+	#if ( configUSE_EDF_SLACK_STEALING == 1 )
+		#error configUSE_EDF_SLACK_STEALING measures execution time in ticks so cannot be used with configUSE_EDF_HIGH_RES_TIME.
+	#endif
+
+	#ifndef configEDF_HIGH_RES_TIME_HZ
+		#error configEDF_HIGH_RES_TIME_HZ must be set to the count rate of the high resolution timer.
+	#endif
+
+	#ifndef portEDF_GET_HIGH_RES_TIME
+		#error The port does not provide portEDF_GET_HIGH_RES_TIME(), needed by configUSE_EDF_HIGH_RES_TIME.
+	#endif
+
+	#ifndef portEDF_SET_HIGH_RES_ALARM
+		#error The port does not provide portEDF_SET_HIGH_RES_ALARM(), needed by configUSE_EDF_HIGH_RES_TIME.
+	#endif
+#endif
+
 #ifndef configNUM_THREAD_LOCAL_STORAGE_POINTERS
 	#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 0
 #endif
@@ -778,6 +833,133 @@ hold explicit before calling the code. */
 	#define configUSE_QUEUE_SETS 0
 #endif
 
+#ifndef configUSE_QUEUE_LOANS
+	#define configUSE_QUEUE_LOANS 0
+#endif
+
+#ifndef configUSE_QUEUE_OVERWRITE_OLDEST
+	#define configUSE_QUEUE_OVERWRITE_OLDEST 0
+#endif
+
+#ifndef configUSE_QUEUE_DEADLINE_ORDER
+	#define configUSE_QUEUE_DEADLINE_ORDER 0
+#endif
+
+#ifndef configEVENT_GROUP_WAITER_BUCKETS
+	/* Tasks waiting on an event group are kept in this many lists, chosen by
+	the positions of the bits each task waits for, so setting bits only visits
+	the lists that hold tasks interested in them. */
+	#define configEVENT_GROUP_WAITER_BUCKETS 1
+#endif
+
+#if( configEVENT_GROUP_WAITER_BUCKETS < 1 )
+	#error configEVENT_GROUP_WAITER_BUCKETS must be at least 1
+#endif
+
+#ifndef configUSE_DELAY_WHEEL
+	/* Set to 1 to hold tasks that are blocked with a timeout in a hierarchical
+	timing wheel instead of a list sorted by wake time, so blocking and waking
+	take constant time however many tasks are blocked. */
+	#define configUSE_DELAY_WHEEL 0
+#endif
+
+#ifndef configDELAY_WHEEL_SLOT_BITS
+	/* Each level of the wheel has 2^configDELAY_WHEEL_SLOT_BITS slots. */
+	#define configDELAY_WHEEL_SLOT_BITS 5
+#endif
+
+#ifndef configDELAY_WHEEL_LEVELS
+	/* Tasks that wake more than 2^( configDELAY_WHEEL_SLOT_BITS *
+	configDELAY_WHEEL_LEVELS ) ticks ahead are held in a separate list that is
+	checked once per rotation of the top level. */
+	#define configDELAY_WHEEL_LEVELS 3
+#endif
+
+#if( configUSE_DELAY_WHEEL == 1 )
+	#if( ( configDELAY_WHEEL_SLOT_BITS < 1 ) || ( configDELAY_WHEEL_SLOT_BITS > 5 ) )
+		#error configDELAY_WHEEL_SLOT_BITS must be between 1 and 5
+	#endif
+
+	#if( configDELAY_WHEEL_LEVELS < 1 )
+		#error configDELAY_WHEEL_LEVELS must be at least 1
+	#endif
+
+	#if( ( ( configUSE_16_BIT_TICKS == 1 ) && ( ( configDELAY_WHEEL_SLOT_BITS * configDELAY_WHEEL_LEVELS ) >= 16 ) ) || ( ( configDELAY_WHEEL_SLOT_BITS * configDELAY_WHEEL_LEVELS ) >= 32 ) )
+		#error The delay wheel must cover fewer ticks than TickType_t can hold
+	#endif
+#endif
+
+#ifndef configUSE_TIMER_COALESCING
+	/* Set to 1 to let a software timer be given a slack window, within which
+	it can expire late so it runs together with other timers instead of
+	waking the timer service task on its own. */
+	#define configUSE_TIMER_COALESCING 0
+#endif
+
+#ifndef configTIMER_BUCKETS
+	/* With configUSE_TIMER_COALESCING set to 1, active timers are hashed on
+	their expiry time into this many lists. */
+	#define configTIMER_BUCKETS 32
+#endif
+
+#if( configUSE_TIMER_COALESCING == 1 )
+	#if( ( configTIMER_BUCKETS < 1 ) || ( configTIMER_BUCKETS > 32 ) || ( ( configTIMER_BUCKETS & ( configTIMER_BUCKETS - 1 ) ) != 0 ) )
+		#error configTIMER_BUCKETS must be a power of two no greater than 32
+	#endif
+#endif
+
+#ifndef configUSE_STACK_PROFILER
+	/* Set to 1 to have the idle task track the peak stack usage of every task,
+	a few words at a time, so uxTaskGetStackProfile() can recommend stack
+	sizes. */
+	#define configUSE_STACK_PROFILER 0
+#endif
+
+#ifndef configSTACK_PROFILER_WORDS_PER_CALL
+	/* The most stack words the idle task checks on each pass of its loop. */
+	#define configSTACK_PROFILER_WORDS_PER_CALL 8
+#endif
+
+#ifndef configSTACK_PROFILER_MARGIN_PERCENT
+	/* The margin added to the peak stack usage of a task to give its
+	recommended stack size. */
+	#define configSTACK_PROFILER_MARGIN_PERCENT 25
+#endif
+
+#if( configUSE_STACK_PROFILER == 1 )
+	#if( configSTACK_PROFILER_WORDS_PER_CALL < 1 )
+		#error configSTACK_PROFILER_WORDS_PER_CALL must be at least 1
+	#endif
+#endif
+
+#ifndef configUSE_WCET_PROFILER
+	/* Set to 1 to measure the execution time of every job of every task, from
+	the run time stats counter, so xTaskGetWcetProfile() can report it. */
+	#define configUSE_WCET_PROFILER 0
+#endif
+
+#ifndef configWCET_HISTOGRAM_BUCKETS
+	/* The number of buckets in the job execution time histogram of each task. */
+	#define configWCET_HISTOGRAM_BUCKETS 16
+#endif
+
+#ifndef configWCET_COUNTER_HZ
+	/* The frequency of the run time stats counter, written into the frame
+	produced by xTaskGetWcetFrame() so execution times can be converted to
+	seconds.  0 if it is not known. */
+	#define configWCET_COUNTER_HZ 0
+#endif
+
+#if( configUSE_WCET_PROFILER == 1 )
+	#if( configGENERATE_RUN_TIME_STATS != 1 )
+		#error configUSE_WCET_PROFILER requires configGENERATE_RUN_TIME_STATS to be set to 1
+	#endif
+
+	#if( ( configWCET_HISTOGRAM_BUCKETS < 2 ) || ( configWCET_HISTOGRAM_BUCKETS > 254 ) || ( ( configWCET_HISTOGRAM_BUCKETS & 1 ) != 0 ) )
+		#error configWCET_HISTOGRAM_BUCKETS must be an even number between 2 and 254
+	#endif
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
 	#define portTASK_USES_FLOATING_POINT()
 #endif
@@ -834,6 +1016,17 @@ hold explicit before calling the code. */
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	/* The number of independent notification values and states each task
+	has.  Index 0 is the one used by the API functions without the Indexed
+	suffix, by stream buffers and by the sporadic release. */
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#if( configTASK_NOTIFICATION_ARRAY_ENTRIES < 1 )
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
 #ifndef configUSE_POSIX_ERRNO
 	#define configUSE_POSIX_ERRNO 0
 #endif
@@ -1125,6 +1318,14 @@ typedef struct xSTATIC_TCB
 	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
 		UBaseType_t		uxDummy9;
 	#endif
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+		TickType_t		xDummy23[ 6 ];
+		UBaseType_t		uxDummy30[ 2 ];
+		uint8_t			ucDummy31;
+	#endif
+	#if ( configUSE_EDF_SLACK_STEALING == 1 )
+		TickType_t		xDummy24[ 2 ];
+	#endif
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t		uxDummy10[ 2 ];
 	#endif
@@ -1140,12 +1341,23 @@ typedef struct xSTATIC_TCB
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		uint32_t		ulDummy16;
 	#endif
+	#if ( ( configUSE_STACK_PROFILER == 1 ) || ( configUSE_WCET_PROFILER == 1 ) || ( configUSE_EDF_SLACK_STEALING == 1 ) )
+		void			*pxDummy25;
+	#endif
+	#if ( configUSE_STACK_PROFILER == 1 )
+		configSTACK_DEPTH_TYPE	uxDummy26[ 3 ];
+	#endif
+	#if ( configUSE_WCET_PROFILER == 1 )
+		uint32_t		ulDummy27[ 4 ];
+		uint16_t		usDummy28[ configWCET_HISTOGRAM_BUCKETS ];
+		uint8_t			ucDummy29;
+	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
 		uint8_t			uxDummy20;
@@ -1195,6 +1407,20 @@ typedef struct xSTATIC_QUEUE
 		void *pvDummy7;
 	#endif
 
+	#if ( configUSE_QUEUE_LOANS == 1 )
+		void *pvDummy10[ 2 ];
+	#endif
+
+	#if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+		UBaseType_t uxDummy11;
+		uint8_t ucDummy12;
+	#endif
+
+	#if ( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+		void *pvDummy13;
+		UBaseType_t uxDummy14;
+	#endif
+
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy8;
 		uint8_t ucDummy9;
@@ -1220,7 +1446,8 @@ typedef StaticQueue_t StaticSemaphore_t;
 typedef struct xSTATIC_EVENT_GROUP
 {
 	TickType_t xDummy1;
-	StaticList_t xDummy2;
+	StaticList_t xDummy2[ configEVENT_GROUP_WAITER_BUCKETS ];
+	TickType_t xDummy5[ configEVENT_GROUP_WAITER_BUCKETS ];
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy3;
@@ -1251,6 +1478,9 @@ typedef struct xSTATIC_TIMER
 	void				*pvDummy1;
 	StaticListItem_t	xDummy2;
 	TickType_t			xDummy3;
+	#if( configUSE_TIMER_COALESCING == 1 )
+		TickType_t		xDummy4;
+	#endif
 	void 				*pvDummy5;
 	TaskFunction_t		pvDummy6;
 	#if( configUSE_TRACE_FACILITY == 1 )
@@ -0,0 +1,252 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef MEMPOOL_H
+#define MEMPOOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include mempool.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "semphr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A memory pool is a fixed number of equally sized blocks.  Allocating a block
+ * and freeing a block both take constant time and can be done from tasks and
+ * from interrupts.  A task can optionally enter the Blocked state to wait for
+ * a block to be freed when the pool is empty.
+ *
+ * Blocks are meant to be passed between tasks by reference.  A producer fills
+ * a block and sends the block's address through a queue, message buffer or
+ * stream buffer (see xMemPoolSendBlockToQueue() and
+ * xMemPoolSendBlockToStreamBuffer() below).  The consumer receives the address,
+ * uses the block in place, then frees it back to the pool.  Only a pointer is
+ * copied however large the message is.
+ *
+ * Memory pools require configUSE_COUNTING_SEMAPHORES to be set to 1.
+ *
+ * \defgroup MemPool
+ */
+
+/**
+ * mempool.h
+ *
+ * Type by which memory pools are referenced.
+ *
+ * \defgroup MemPoolHandle_t MemPoolHandle_t
+ * \ingroup MemPool
+ */
+struct MemPoolDef_t;
+typedef struct MemPoolDef_t * MemPoolHandle_t;
+
+/*
+ * The size of the storage an application must provide to
+ * xMemPoolCreateStatic() to hold uxBlockCount blocks of xBlockSize bytes.
+ * Block sizes are rounded up so every block is aligned to portBYTE_ALIGNMENT.
+ */
+#define mempoolBLOCK_STRIDE( xBlockSize )	( ( ( ( ( xBlockSize ) < sizeof( void * ) ) ? sizeof( void * ) : ( xBlockSize ) ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+#define mempoolSTORAGE_SIZE( xBlockSize, uxBlockCount )	( mempoolBLOCK_STRIDE( xBlockSize ) * ( size_t ) ( uxBlockCount ) )
+
+/*
+ * A structure the same size and alignment as the memory pool control
+ * structure, so memory pools can be created without dynamic memory
+ * allocation.  Its members are deliberately obfuscated and must not be used.
+ */
+typedef struct xSTATIC_MEM_POOL
+{
+	void *pvDummy1[ 3 ];
+	size_t xDummy2;
+	UBaseType_t uxDummy3;
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		StaticSemaphore_t xDummy4;
+	#endif
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy5;
+	#endif
+} StaticMemPool_t;
+
+/**
+ * mempool.h
+ *<pre>
+ MemPoolHandle_t xMemPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount );
+ </pre>
+ *
+ * Creates a memory pool of uxBlockCount blocks, each able to hold xBlockSize
+ * bytes.  The control structure and the blocks are taken from the FreeRTOS
+ * heap in a single allocation.
+ *
+ * @return The handle of the new pool, or NULL if there was not enough heap.
+ *
+ * \defgroup xMemPoolCreate xMemPoolCreate
+ * \ingroup MemPool
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	MemPoolHandle_t xMemPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mempool.h
+ *<pre>
+ MemPoolHandle_t xMemPoolCreateStatic( size_t xBlockSize,
+                                       UBaseType_t uxBlockCount,
+                                       uint8_t *pucPoolStorage,
+                                       StaticMemPool_t *pxStaticMemPool );
+ </pre>
+ *
+ * As xMemPoolCreate(), but the blocks are carved from pucPoolStorage, which
+ * must be aligned to portBYTE_ALIGNMENT and at least
+ * mempoolSTORAGE_SIZE( xBlockSize, uxBlockCount ) bytes, and the control
+ * structure is held in *pxStaticMemPool.
+ *
+ * \defgroup xMemPoolCreateStatic xMemPoolCreateStatic
+ * \ingroup MemPool
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	MemPoolHandle_t xMemPoolCreateStatic( size_t xBlockSize, UBaseType_t uxBlockCount, uint8_t *pucPoolStorage, StaticMemPool_t *pxStaticMemPool ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mempool.h
+ *<pre>
+ void *pvMemPoolAlloc( MemPoolHandle_t xMemPool, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Takes a block from the pool.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state for a
+ * block to be freed if the pool is empty.  Zero returns immediately.
+ *
+ * @return The block, or NULL if the pool stayed empty for xTicksToWait ticks.
+ *
+ * \defgroup pvMemPoolAlloc pvMemPoolAlloc
+ * \ingroup MemPool
+ */
+void *pvMemPoolAlloc( MemPoolHandle_t xMemPool, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *<pre>
+ void *pvMemPoolAllocFromISR( MemPoolHandle_t xMemPool );
+ </pre>
+ *
+ * A version of pvMemPoolAlloc() that can be called from an interrupt service
+ * routine.  It never blocks.
+ *
+ * \defgroup pvMemPoolAllocFromISR pvMemPoolAllocFromISR
+ * \ingroup MemPool
+ */
+void *pvMemPoolAllocFromISR( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *<pre>
+ void vMemPoolFree( MemPoolHandle_t xMemPool, void *pvBlock );
+ </pre>
+ *
+ * Returns a block obtained from xMemPool to xMemPool.  If a task is blocked
+ * waiting for a block it is unblocked.
+ *
+ * \defgroup vMemPoolFree vMemPoolFree
+ * \ingroup MemPool
+ */
+void vMemPoolFree( MemPoolHandle_t xMemPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *<pre>
+ void vMemPoolFreeFromISR( MemPoolHandle_t xMemPool, void *pvBlock, BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of vMemPoolFree() that can be called from an interrupt service
+ * routine.  *pxHigherPriorityTaskWoken is set to pdTRUE if freeing the block
+ * unblocked a task that should run before the interrupted task, in which case
+ * a context switch should be requested before the interrupt is exited.
+ *
+ * \defgroup vMemPoolFreeFromISR vMemPoolFreeFromISR
+ * \ingroup MemPool
+ */
+void vMemPoolFreeFromISR( MemPoolHandle_t xMemPool, void *pvBlock, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *<pre>
+ UBaseType_t uxMemPoolGetFreeBlockCount( MemPoolHandle_t xMemPool );
+ </pre>
+ *
+ * Returns the number of blocks that are currently free in the pool.
+ *
+ * \defgroup uxMemPoolGetFreeBlockCount uxMemPoolGetFreeBlockCount
+ * \ingroup MemPool
+ */
+UBaseType_t uxMemPoolGetFreeBlockCount( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *<pre>
+ void vMemPoolDelete( MemPoolHandle_t xMemPool );
+ </pre>
+ *
+ * Deletes a memory pool.  All blocks must have been freed first.
+ *
+ * \defgroup vMemPoolDelete vMemPoolDelete
+ * \ingroup MemPool
+ */
+void vMemPoolDelete( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Helpers for passing pool blocks by reference.  The queue must have been
+ * created with an item size of sizeof( void * ), and only the address of the
+ * block is copied.  pvBlock must be an lvalue holding the block address.
+ */
+#define xMemPoolSendBlockToQueue( xQueue, pvBlock, xTicksToWait )			xQueueSend( ( xQueue ), &( pvBlock ), ( xTicksToWait ) )
+#define xMemPoolSendBlockToQueueFromISR( xQueue, pvBlock, pxWoken )		xQueueSendFromISR( ( xQueue ), &( pvBlock ), ( pxWoken ) )
+#define xMemPoolReceiveBlockFromQueue( xQueue, ppvBlock, xTicksToWait )		xQueueReceive( ( xQueue ), ( ppvBlock ), ( xTicksToWait ) )
+
+/*
+ * As above, for message buffers, which include message_buffer.h to use.  Each
+ * block address is written as one sizeof( void * ) message, so it is always
+ * received whole.  A stream buffer cannot be used as it can send or receive
+ * part of an address.  Each macro evaluates to pdPASS if a whole address was
+ * sent or received, otherwise pdFAIL.
+ */
+#define xMemPoolSendBlockToMessageBuffer( xMessageBuffer, pvBlock, xTicksToWait )						\
+	( ( xMessageBufferSend( ( xMessageBuffer ), &( pvBlock ), sizeof( void * ), ( xTicksToWait ) ) == sizeof( void * ) ) ? pdPASS : pdFAIL )
+#define xMemPoolSendBlockToMessageBufferFromISR( xMessageBuffer, pvBlock, pxWoken )						\
+	( ( xMessageBufferSendFromISR( ( xMessageBuffer ), &( pvBlock ), sizeof( void * ), ( pxWoken ) ) == sizeof( void * ) ) ? pdPASS : pdFAIL )
+#define xMemPoolReceiveBlockFromMessageBuffer( xMessageBuffer, ppvBlock, xTicksToWait )				\
+	( ( xMessageBufferReceive( ( xMessageBuffer ), ( ppvBlock ), sizeof( void * ), ( xTicksToWait ) ) == sizeof( void * ) ) ? pdPASS : pdFAIL )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMPOOL_H */
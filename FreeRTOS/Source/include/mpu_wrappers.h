@@ -53,6 +53,7 @@ only for ports that are using the MPU. */
 		#define vTaskDelete								MPU_vTaskDelete
 		#define vTaskDelay								MPU_vTaskDelay
 		#define vTaskDelayUntil							MPU_vTaskDelayUntil
+		#define vTaskDelayUntilNextRelease				MPU_vTaskDelayUntilNextRelease
 		#define xTaskAbortDelay							MPU_xTaskAbortDelay
 		#define uxTaskPriorityGet						MPU_uxTaskPriorityGet
 		#define eTaskGetState							MPU_eTaskGetState
@@ -76,13 +77,18 @@ only for ports that are using the MPU. */
 		#define xTaskGetIdleTaskHandle					MPU_xTaskGetIdleTaskHandle
 		#define uxTaskGetSystemState					MPU_uxTaskGetSystemState
 		#define vTaskList								MPU_vTaskList
+		#define uxTaskGetStackProfile					MPU_uxTaskGetStackProfile
+		#define vTaskGetStackProfileReport				MPU_vTaskGetStackProfileReport
+		#define xTaskGetWcetProfile						MPU_xTaskGetWcetProfile
+		#define xTaskGetWcetFrame						MPU_xTaskGetWcetFrame
+		#define uxTaskGetInterArrivalViolations			MPU_uxTaskGetInterArrivalViolations
 		#define vTaskGetRunTimeStats					MPU_vTaskGetRunTimeStats
 		#define ulTaskGetIdleRunTimeCounter				MPU_ulTaskGetIdleRunTimeCounter
 		#define xTaskGenericNotify						MPU_xTaskGenericNotify
-		#define xTaskNotifyWait							MPU_xTaskNotifyWait
-		#define ulTaskNotifyTake						MPU_ulTaskNotifyTake
-		#define xTaskNotifyStateClear					MPU_xTaskNotifyStateClear
-		#define ulTaskNotifyValueClear					MPU_ulTaskNotifyValueClear
+		#define xTaskGenericNotifyWait					MPU_xTaskGenericNotifyWait
+		#define ulTaskGenericNotifyTake					MPU_ulTaskGenericNotifyTake
+		#define xTaskGenericNotifyStateClear			MPU_xTaskGenericNotifyStateClear
+		#define ulTaskGenericNotifyValueClear			MPU_ulTaskGenericNotifyValueClear
 		#define xTaskCatchUpTicks						MPU_xTaskCatchUpTicks
 
 		#define xTaskGetCurrentTaskHandle				MPU_xTaskGetCurrentTaskHandle
@@ -130,6 +136,8 @@ only for ports that are using the MPU. */
 		#define pcTimerGetName							MPU_pcTimerGetName
 		#define vTimerSetReloadMode						MPU_vTimerSetReloadMode
 		#define uxTimerGetReloadMode					MPU_uxTimerGetReloadMode
+		#define vTimerSetSlack							MPU_vTimerSetSlack
+		#define xTimerGetSlack							MPU_xTimerGetSlack
 		#define xTimerGetPeriod							MPU_xTimerGetPeriod
 		#define xTimerGetExpiryTime						MPU_xTimerGetExpiryTime
 		#define xTimerGenericCommand					MPU_xTimerGenericCommand
@@ -166,6 +166,109 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Optional heap instrumentation, enabled by setting configUSE_HEAP_INSTRUMENTATION
+ * to 1 in FreeRTOSConfig.h and building heap_instrumentation.c alongside
+ * heap_2.c, heap_4.c or heap_tlsf.c.
+ *
+ * pvPortMalloc() and vPortFree() are then routed through wrappers that count
+ * allocations per call site (source file and line) and, when
+ * configGENERATE_RUN_TIME_STATS is 1, record how long each call took in run
+ * time counter units.  Latencies are kept in histograms with power of two
+ * bucket widths: bucket 0 counts calls that took no measurable time, bucket n
+ * counts calls that took from 2^(n-1) up to 2^n - 1 units, and the last bucket
+ * also counts everything longer.
+ */
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	/* Free block size classes.  Class 0 counts free blocks smaller than
+	2^portHEAP_SMALLEST_SIZE_CLASS_LOG2 bytes, class n counts blocks from
+	2^(n+portHEAP_SMALLEST_SIZE_CLASS_LOG2-1) up to twice that, and the last
+	class also counts every larger block. */
+	#ifndef configHEAP_SIZE_CLASS_COUNT
+		#define configHEAP_SIZE_CLASS_COUNT		10
+	#endif
+
+	#ifndef configHEAP_LATENCY_BUCKET_COUNT
+		#define configHEAP_LATENCY_BUCKET_COUNT	8
+	#endif
+
+	/* The maximum number of distinct call sites tracked.  Allocations from
+	further call sites are only counted in ulUntrackedCallSiteAllocations. */
+	#ifndef configHEAP_CALL_SITE_COUNT
+		#define configHEAP_CALL_SITE_COUNT		16
+	#endif
+
+	#define portHEAP_SMALLEST_SIZE_CLASS_LOG2	5
+
+	/* Used to pass a snapshot of the heap instrumentation out of
+	vPortGetHeapInstrumentation(). */
+	typedef struct xHEAP_INSTRUMENTATION
+	{
+		size_t xAvailableHeapSpaceInBytes;						/* The sum of all the free blocks. */
+		size_t xMinimumEverFreeBytesRemaining;					/* The low water mark of xAvailableHeapSpaceInBytes since boot. */
+		size_t xSizeOfLargestFreeBlockInBytes;					/* The largest allocation that could currently succeed, plus the block header.  heap_tlsf.c rounds requests up to the next size class, so this is the start of the class of its largest free block, not the size of the block.  heap_4.c and heap_5.c give the size of the block, except after it was allocated and before another free block is known to be the largest, when they give the start of its power of two size class. */
+		size_t xNumberOfFreeBlocks;
+		size_t xFreeBlocksPerSizeClass[ configHEAP_SIZE_CLASS_COUNT ];
+		uint32_t ulMallocLatency[ configHEAP_LATENCY_BUCKET_COUNT ];
+		uint32_t ulFreeLatency[ configHEAP_LATENCY_BUCKET_COUNT ];
+		uint32_t ulMaxMallocLatency;
+		uint32_t ulMaxFreeLatency;
+		uint32_t ulFailedAllocations;
+		uint32_t ulUntrackedCallSiteAllocations;
+	} HeapInstrumentation_t;
+
+	/* One entry of the call site table read by uxPortGetHeapCallSites(). */
+	typedef struct xHEAP_CALL_SITE
+	{
+		const char *pcFile;
+		uint32_t ulLine;
+		uint32_t ulAllocations;		/* Successful calls to pvPortMalloc() from this site. */
+		uint32_t ulFailures;		/* Calls from this site that returned NULL. */
+		size_t xBytesRequested;		/* The total of the sizes successfully requested from this site. */
+	} HeapCallSite_t;
+
+	void *pvPortMallocFromCallSite( size_t xSize, const char *pcFile, uint32_t ulLine ) PRIVILEGED_FUNCTION;
+	void vPortFreeTimed( void *pv ) PRIVILEGED_FUNCTION;
+
+	/* Copies the current instrumentation into *pxSnapshot, with the scheduler
+	suspended.  Every figure is kept up to date as blocks are allocated and
+	freed, so no walk of the free blocks is needed. */
+	void vPortGetHeapInstrumentation( HeapInstrumentation_t *pxSnapshot ) PRIVILEGED_FUNCTION;
+
+	/* Copies up to uxArraySize entries of the call site table into
+	pxCallSites and returns the number copied. */
+	UBaseType_t uxPortGetHeapCallSites( HeapCallSite_t *pxCallSites, UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+	/* Clears the latency histograms and call site table. */
+	void vPortResetHeapInstrumentation( void ) PRIVILEGED_FUNCTION;
+
+	/* Called by the heap, with the scheduler suspended, each time a block is
+	added to or taken out of its free blocks. */
+	void vPortHeapFreeBlockAdded( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+	void vPortHeapFreeBlockRemoved( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+	#define portHEAP_FREE_BLOCK_ADDED( xBlockSize )		vPortHeapFreeBlockAdded( xBlockSize )
+	#define portHEAP_FREE_BLOCK_REMOVED( xBlockSize )	vPortHeapFreeBlockRemoved( xBlockSize )
+
+	/* Implemented by the heap.  Returns the value of
+	xSizeOfLargestFreeBlockInBytes, and is called with the scheduler
+	suspended.  Must not walk the free blocks - each heap keeps what it needs
+	up to date as blocks are allocated and freed. */
+	size_t xPortGetLargestFreeBlockSize( void ) PRIVILEGED_FUNCTION;
+
+	/* The heap implementations must see the real function names. */
+	#ifndef portHEAP_IMPLEMENTATION
+		#define pvPortMalloc( xSize )	pvPortMallocFromCallSite( ( xSize ), __FILE__, ( uint32_t ) __LINE__ )
+		#define vPortFree( pv )			vPortFreeTimed( pv )
+	#endif
+
+#else
+
+	#define portHEAP_FREE_BLOCK_ADDED( xBlockSize )
+	#define portHEAP_FREE_BLOCK_REMOVED( xBlockSize )
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
@@ -561,6 +561,153 @@ typedef struct QueueDefinition * QueueSetMemberHandle_t;
  */
 #define xQueueOverwrite( xQueue, pvItemToQueue ) xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), 0, queueOVERWRITE )
 
+#if( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+
+/**
+ * queue. h
+ * <pre>
+ void vQueueSetOverwriteOldest( QueueHandle_t xQueue, BaseType_t xOverwriteOldest );
+ * </pre>
+ *
+ * Switch a queue of any length into, or out of, overwrite-oldest mode.  In
+ * this mode a send to the back of a full queue (xQueueSend(),
+ * xQueueSendToBack(), xQueueSendMultiple() and their ISR versions) discards
+ * the oldest item in the queue to make room, instead of blocking or failing.
+ * The queue therefore always holds the most recent items posted to it, and
+ * senders never block waiting for space.
+ *
+ * Each discarded item is added to the count returned by
+ * uxQueueGetOverwriteCount().  Sends to the front of the queue are not
+ * affected by the mode.  If the oldest item is on loan (see pvQueuePeekSlot())
+ * it cannot be discarded, so a send to a full queue behaves as normal until
+ * the loan is released.  In a deadline ordered queue (see
+ * xQueueCreateDeadlineOrdered()) the item with the latest deadline is
+ * discarded instead, which is the item being sent if none is later.
+ *
+ * configUSE_QUEUE_OVERWRITE_OLDEST must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param xQueue The handle of the queue.
+ *
+ * @param xOverwriteOldest pdTRUE to enable overwrite-oldest mode, pdFALSE to
+ * return the queue to the normal behaviour.
+ *
+ * \defgroup vQueueSetOverwriteOldest vQueueSetOverwriteOldest
+ * \ingroup QueueManagement
+ */
+void vQueueSetOverwriteOldest( QueueHandle_t xQueue, BaseType_t xOverwriteOldest ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t uxQueueGetOverwriteCount( const QueueHandle_t xQueue );
+ * </pre>
+ *
+ * @return The number of items that have been discarded from a queue in
+ * overwrite-oldest mode since the queue was created or last reset.
+ *
+ * \defgroup uxQueueGetOverwriteCount uxQueueGetOverwriteCount
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueGetOverwriteCount( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_OVERWRITE_OLDEST */
+
+#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+
+/**
+ * queue. h
+ * <pre>
+ QueueHandle_t xQueueCreateDeadlineOrdered(
+							  UBaseType_t uxQueueLength,
+							  UBaseType_t uxItemSize
+						  );
+ * </pre>
+ *
+ * Creates a queue that gives its items to receivers in order of deadline,
+ * earliest first, rather than in the order they were sent.  Items with the
+ * same deadline are received in the order they were sent.
+ *
+ * Each item carries an absolute deadline in ticks.  xQueueSendWithDeadline()
+ * sets it explicitly.  Items sent with any other send function take the
+ * deadline of the sending task's current job (see xTaskGetCurrentDeadline()),
+ * or the current tick count if the EDF scheduler is not in use or the item is
+ * sent from an interrupt.  Whether an item is sent to the front or the back of
+ * the queue makes no difference.  With configUSE_EDF_HIGH_RES_TIME set to 1
+ * the deadlines are in high resolution time rather than ticks, like the
+ * deadlines of the jobs.
+ *
+ * Items are never moved once queued.  A min-max heap of item indexes keyed by
+ * deadline is kept alongside them, so sending and receiving take O(log n)
+ * time in the number of items queued, including when a full queue in
+ * overwrite-oldest mode discards its latest item, and each item costs three
+ * extra words of RAM.  The item with the earliest deadline can be loaned with
+ * pvQueuePeekSlot(), but slots cannot be reserved with pvQueueReserveSlot().
+ *
+ * configUSE_QUEUE_DEADLINE_ORDER and configSUPPORT_DYNAMIC_ALLOCATION must be
+ * set to 1 in FreeRTOSConfig.h for this function to be available.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must be greater than zero.
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then 0 is
+ * returned.
+ *
+ * Example usage:
+   <pre>
+ // An urgent message that must go out within 5 ticks is received ahead of
+ // routine messages queued earlier with later deadlines.
+ xQueue = xQueueCreateDeadlineOrdered( 10, sizeof( xMessage ) );
+
+ xQueueSendWithDeadline( xQueue, &xMessage, xTaskGetTickCount() + 5, 0 );
+ </pre>
+ *
+ * \defgroup xQueueCreateDeadlineOrdered xQueueCreateDeadlineOrdered
+ * \ingroup QueueManagement
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	QueueHandle_t xQueueCreateDeadlineOrdered( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendWithDeadline(
+								   QueueHandle_t xQueue,
+								   const void *pvItemToQueue,
+								   TickType_t xDeadline,
+								   TickType_t xTicksToWait
+							   );
+ * </pre>
+ *
+ * Post an item to a deadline ordered queue with the absolute deadline
+ * xDeadline, in ticks.  Behaves as xQueueSendToBack() in all other respects.
+ * xQueue must have been created with xQueueCreateDeadlineOrdered(); a FIFO
+ * queue cannot keep the deadline, so passing one fails configASSERT().
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param xDeadline The tick count by which the item should be received.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already be
+ * full.
+ *
+ * @return pdTRUE if the item was successfully posted, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xQueueSendWithDeadline xQueueSendWithDeadline
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendWithDeadline( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xDeadline, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+
 
 /**
  * queue. h
@@ -867,6 +1014,231 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue, void * const pvBuffer ) PRIV
  */
 BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendMultiple(
+							   QueueHandle_t xQueue,
+							   const void * const pvItems,
+							   UBaseType_t uxItemCount,
+							   TickType_t xTicksToWait
+						   );
+ * </pre>
+ *
+ * Post up to uxItemCount items, stored contiguously at pvItems, to the back of
+ * a queue.  The items are copied under a single critical section, and waiting
+ * receivers are unblocked and a context switch considered once for the whole
+ * batch rather than once per item.
+ *
+ * The call blocks only while the queue has no space at all.  As soon as there
+ * is space for at least one item, as many items as fit are posted and the
+ * call returns, so fewer than uxItemCount items may be sent.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to an array of uxItemCount items, each the size
+ * defined when the queue was created.
+ *
+ * @param uxItemCount The number of items in the pvItems array.  Must be at least
+ * 1.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space to become available on the queue.
+ *
+ * @return The number of items posted, which is 0 if the queue remained full
+ * for xTicksToWait ticks.
+ *
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReceiveMultiple(
+								  QueueHandle_t xQueue,
+								  void * const pvBuffer,
+								  UBaseType_t uxMaxItems,
+								  TickType_t xTicksToWait
+							  );
+ * </pre>
+ *
+ * Receive up to uxMaxItems items from the front of a queue into a contiguous
+ * buffer, under a single critical section and with one pass of unblocking
+ * waiting senders.  The call blocks only while the queue is empty, and
+ * returns as soon as at least one item has been received.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.  Must be at least
+ * 1.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to arrive.
+ *
+ * @return The number of items received, which is 0 if the queue remained
+ * empty for xTicksToWait ticks.
+ *
+ * Example usage:
+   <pre>
+ #define mainBATCH_SIZE	4
+
+ void vConsumer( void *pvParameters )
+ {
+ uint8_t ucMessages[ mainBATCH_SIZE ][ 15 ];
+ BaseType_t xReceived, x;
+
+	for( ;; )
+	{
+		// Drain everything that arrived since the last period, up to the
+		// batch size, with one call.
+		xReceived = xQueueReceiveMultiple( xQueue, ucMessages, mainBATCH_SIZE, 0 );
+
+		for( x = 0; x < xReceived; x++ )
+		{
+			// Process ucMessages[ x ].
+		}
+	}
+ }
+ </pre>
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_QUEUE_LOANS == 1 )
+
+/**
+ * queue. h
+ * <pre>void *pvQueueReserveSlot( QueueHandle_t xQueue, TickType_t xTicksToWait );</pre>
+ *
+ * Reserve the next free slot at the back of a queue so an item can be built
+ * directly in the queue storage, rather than built in a local buffer and then
+ * copied in by xQueueSend().  The item does not become visible to receivers
+ * until vQueueCommitSlot() is called.
+ *
+ * Only one slot of a queue can be reserved at a time.  While a slot is
+ * reserved, other tasks that attempt to send to the queue, or reserve a slot
+ * in it, block as if the queue were full.  The reservation must therefore be
+ * committed or cancelled promptly.
+ *
+ * This function must not be called from an interrupt service routine, and
+ * cannot be used with semaphores.
+ *
+ * configUSE_QUEUE_LOANS must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * @param xQueue The handle to the queue in which the slot is to be reserved.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for a slot to become available.
+ *
+ * @return A pointer to uxItemSize bytes of queue storage, or NULL if no slot
+ * became available before xTicksToWait expired.
+ *
+ * Example usage:
+   <pre>
+ void vProducer( void *pvParameters )
+ {
+ struct AMessage *pxMessage;
+
+	// ... Create xQueue to hold struct AMessage items.
+
+	for( ;; )
+	{
+		pxMessage = pvQueueReserveSlot( xQueue, portMAX_DELAY );
+
+		// Fill in the message in place.
+		pxMessage->ucMessageID = 0x10;
+
+		// Make the message available to receivers.
+		vQueueCommitSlot( xQueue );
+	}
+ }
+ </pre>
+ * \defgroup pvQueueReserveSlot pvQueueReserveSlot
+ * \ingroup QueueManagement
+ */
+void *pvQueueReserveSlot( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>void vQueueCommitSlot( QueueHandle_t xQueue );</pre>
+ *
+ * Post the item written into the slot returned by pvQueueReserveSlot() to the
+ * back of the queue, unblocking a task waiting to receive from the queue if
+ * there is one.  The slot pointer must not be used after this call.
+ *
+ * \defgroup vQueueCommitSlot vQueueCommitSlot
+ * \ingroup QueueManagement
+ */
+void vQueueCommitSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>void vQueueCancelSlot( QueueHandle_t xQueue );</pre>
+ *
+ * Give back a slot returned by pvQueueReserveSlot() without posting anything
+ * to the queue.
+ *
+ * \defgroup vQueueCancelSlot vQueueCancelSlot
+ * \ingroup QueueManagement
+ */
+void vQueueCancelSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>const void *pvQueuePeekSlot( QueueHandle_t xQueue, TickType_t xTicksToWait );</pre>
+ *
+ * Obtain a pointer to the item at the front of a queue so it can be processed
+ * in place, rather than copied out by xQueueReceive().  The item stays in the
+ * queue storage until vQueueReleaseSlot() is called, at which point it is
+ * removed from the queue.
+ *
+ * Only one item of a queue can be peeked this way at a time.  Until the slot
+ * is released, other tasks that attempt to receive from the queue or peek a
+ * slot block as if the queue were empty, and writes to the front of the queue
+ * (including xQueueOverwrite()) block as if the queue were full.  xQueuePeek()
+ * is unaffected and copies the item that is on loan.  In a deadline ordered
+ * queue the item on loan is the one that had the earliest deadline when this
+ * function was called, and items sent during the loan are received after it
+ * whatever their deadlines.
+ *
+ * This function must not be called from an interrupt service routine, and
+ * cannot be used with semaphores.
+ *
+ * @param xQueue The handle to the queue from which the item is to be peeked.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to arrive.
+ *
+ * @return A pointer to the item, or NULL if the queue remained empty for
+ * xTicksToWait ticks.
+ *
+ * \defgroup pvQueuePeekSlot pvQueuePeekSlot
+ * \ingroup QueueManagement
+ */
+const void *pvQueuePeekSlot( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>void vQueueReleaseSlot( QueueHandle_t xQueue );</pre>
+ *
+ * Remove the item returned by pvQueuePeekSlot() from the queue, unblocking a
+ * task waiting to send to the queue if there is one.  The slot pointer must
+ * not be used after this call.
+ *
+ * \defgroup vQueueReleaseSlot vQueueReleaseSlot
+ * \ingroup QueueManagement
+ */
+void vQueueReleaseSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_LOANS */
+
 /**
  * queue. h
  * <pre>UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue );</pre>
@@ -1384,6 +1756,39 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherP
  */
 BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, UBaseType_t uxItemCount, BaseType_t *pxHigherPriorityTaskWoken );
+ BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Versions of xQueueSendMultiple() and xQueueReceiveMultiple() that can be
+ * called from an interrupt service routine.  They never block, and return the
+ * number of items moved.  *pxHigherPriorityTaskWoken is set to pdTRUE if the
+ * batch unblocked a task with a priority higher than the interrupted task.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * <pre>
+ BaseType_t xQueueSendWithDeadlineFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xDeadline, BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xQueueSendWithDeadline() that can be called from an interrupt
+ * service routine.  It never blocks.
+ *
+ * \defgroup xQueueSendWithDeadlineFromISR xQueueSendWithDeadlineFromISR
+ * \ingroup QueueManagement
+ */
+#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+	BaseType_t xQueueSendWithDeadlineFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xDeadline, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -96,6 +96,10 @@ typedef enum
 	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
 } eNotifyAction;
 
+/* The notification index used by the API functions that do not take an index,
+see configTASK_NOTIFICATION_ARRAY_ENTRIES. */
+#define tskDEFAULT_INDEX_TO_NOTIFY	( 0 )
+
 /*
  * Used internally only.
  */
@@ -147,6 +151,33 @@ typedef struct xTASK_STATUS
 	configSTACK_DEPTH_TYPE usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with the uxTaskGetStackProfile() function to return the stack usage of
+each task in the system.  All sizes are in words. */
+typedef struct xTASK_STACK_PROFILE
+{
+	TaskHandle_t xHandle;			/* The handle of the task to which the rest of the information in the structure relates. */
+	const char *pcTaskName;			/* A pointer to the task's name.  This value will be invalid if the task was deleted since the structure was populated! */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	configSTACK_DEPTH_TYPE uxStackDepth;			/* The size of the stack the task was created with. */
+	configSTACK_DEPTH_TYPE uxPeakStackUsage;		/* The most stack the idle task has found the task to have used. */
+	configSTACK_DEPTH_TYPE uxRecommendedStackDepth;	/* uxPeakStackUsage plus configSTACK_PROFILER_MARGIN_PERCENT, rounded up to keep the stack aligned. */
+} TaskStackProfile_t;
+
+/* Used with the xTaskGetWcetProfile() function to return the measured execution
+times of the jobs of a task.  All times are in run time stats counter counts. */
+typedef struct xTASK_WCET_PROFILE
+{
+	TaskHandle_t xHandle;					/* The handle of the task to which the rest of the information in the structure relates. */
+	const char *pcTaskName;					/* A pointer to the task's name.  This value will be invalid if the task was deleted since the structure was populated! */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	uint32_t ulJobs;						/* The number of jobs measured. */
+	uint32_t ulMinExecutionTime;			/* The shortest job. */
+	uint32_t ulMaxExecutionTime;			/* The longest job - the measured WCET. */
+	uint32_t ulMedianExecutionTime;			/* Half of the jobs took no longer than this. */
+	uint32_t ul90thPercentileExecutionTime;	/* 90% of the jobs took no longer than this. */
+	uint32_t ul99thPercentileExecutionTime;	/* 99% of the jobs took no longer than this. */
+	uint32_t ulBucketWidth;					/* The width of each histogram bucket. */
+	uint16_t usHistogram[ configWCET_HISTOGRAM_BUCKETS ];	/* usHistogram[ n ] counts the jobs that took from n * ulBucketWidth to ( ( n + 1 ) * ulBucketWidth ) - 1. */
+} TaskWcetProfile_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -162,6 +193,29 @@ typedef enum
  */
 #define tskIDLE_PRIORITY			( ( UBaseType_t ) 0U )
 
+/**
+ * The period given to best-effort tasks when configUSE_EDF_SLACK_STEALING is
+ * set to 1.  Best-effort tasks have no deadline and only run while the
+ * periodic task set has slack to give away.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskBEST_EFFORT_PERIOD		( ( TickType_t ) 0U )
+
+/**
+ * Converts a time in ticks to the time EDF periods, deadlines and releases are
+ * given in.  That is the tick itself, unless configUSE_EDF_HIGH_RES_TIME is
+ * set to 1 and it is the count of the port's high resolution timer, which
+ * runs at configEDF_HIGH_RES_TIME_HZ - a whole multiple of configTICK_RATE_HZ.
+ *
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+	#define tskTICKS_TO_EDF_TIME( xTicks )	( ( TickType_t ) ( ( TickType_t ) ( xTicks ) * ( ( TickType_t ) configEDF_HIGH_RES_TIME_HZ / ( TickType_t ) configTICK_RATE_HZ ) ) )
+#else
+	#define tskTICKS_TO_EDF_TIME( xTicks )	( ( TickType_t ) ( xTicks ) )
+#endif
+
 /**
  * task. h
  *
@@ -342,6 +396,51 @@ is used in assert() statements. */
 									UBaseType_t uxPriority,
 									TaskHandle_t * const pxCreatedTask,
 									TickType_t period );
+
+		/**
+		 * As xTaskCreatePeriodic(), but each job must complete within
+		 * xRelativeDeadline of its release, which must not be greater than
+		 * xPeriod.
+		 */
+		BaseType_t xTaskCreatePeriodicWithDeadline(	TaskFunction_t pxTaskCode,
+													const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+													const configSTACK_DEPTH_TYPE usStackDepth,
+													void * const pvParameters,
+													UBaseType_t uxPriority,
+													TaskHandle_t * const pxCreatedTask,
+													TickType_t xPeriod,
+													TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+		/**
+		 * Creates a sporadic task.  Each job of a sporadic task is released by
+		 * xTaskReleaseSporadicFromISR() rather than by the task's own call to
+		 * vTaskDelayUntilNextRelease(), and must complete within
+		 * xRelativeDeadline of its release.  xMinInterArrival is the minimum time between two
+		 * releases, which the kernel enforces, and is used as the task's
+		 * period by the slack stealing scheduler.  xRelativeDeadline must not
+		 * be greater than xMinInterArrival.  The first job is released when
+		 * the task is created.
+		 */
+		BaseType_t xTaskCreateSporadic(	TaskFunction_t pxTaskCode,
+									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const configSTACK_DEPTH_TYPE usStackDepth,
+									void * const pvParameters,
+									UBaseType_t uxPriority,
+									TaskHandle_t * const pxCreatedTask,
+									TickType_t xMinInterArrival,
+									TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+		/**
+		 * Creates a best-effort task.  Best-effort tasks are not given a
+		 * deadline.  They are held in their own ready list and only run while
+		 * xTaskGetSystemSlack() is above zero, so they can run ahead of less
+		 * urgent periodic jobs without ever making a periodic job miss its
+		 * deadline.  Requires configUSE_EDF_SLACK_STEALING to be set to 1.
+		 */
+		#if ( configUSE_EDF_SLACK_STEALING == 1 )
+			#define xTaskCreateBestEffort( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask ) \
+				xTaskCreatePeriodic( ( pxTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), ( uxPriority ), ( pxCreatedTask ), tskBEST_EFFORT_PERIOD )
+		#endif
 	#endif
 #endif
 
@@ -460,6 +559,48 @@ is used in assert() statements. */
 									UBaseType_t uxPriority,
 									StackType_t * const puxStackBuffer,
 									StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
+
+	/**
+	 * The EDF version of xTaskCreateStatic().  The task's TCB and stack are
+	 * provided by the application, and period is the relative deadline of
+	 * each job of the task in ticks, as for xTaskCreatePeriodic().
+	 */
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+		TaskHandle_t xTaskCreatePeriodicStatic(	TaskFunction_t pxTaskCode,
+												const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+												const uint32_t ulStackDepth,
+												void * const pvParameters,
+												UBaseType_t uxPriority,
+												StackType_t * const puxStackBuffer,
+												StaticTask_t * const pxTaskBuffer,
+												TickType_t period ) PRIVILEGED_FUNCTION;
+
+		/**
+		 * The statically allocated version of xTaskCreatePeriodicWithDeadline().
+		 */
+		TaskHandle_t xTaskCreatePeriodicWithDeadlineStatic(	TaskFunction_t pxTaskCode,
+															const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+															const uint32_t ulStackDepth,
+															void * const pvParameters,
+															UBaseType_t uxPriority,
+															StackType_t * const puxStackBuffer,
+															StaticTask_t * const pxTaskBuffer,
+															TickType_t xPeriod,
+															TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+		/**
+		 * The statically allocated version of xTaskCreateSporadic().
+		 */
+		TaskHandle_t xTaskCreateSporadicStatic(	TaskFunction_t pxTaskCode,
+												const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+												const uint32_t ulStackDepth,
+												void * const pvParameters,
+												UBaseType_t uxPriority,
+												StackType_t * const puxStackBuffer,
+												StaticTask_t * const pxTaskBuffer,
+												TickType_t xMinInterArrival,
+												TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+	#endif
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
 /**
@@ -826,6 +967,43 @@ void vTaskDelay( const TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
  */
 void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskDelayUntilNextRelease( void );</pre>
+ *
+ * Only available when configUSE_EDF_SCHEDULER is set to 1.
+ *
+ * Ends the current job of a periodic task and blocks until the next one is
+ * released, one period after the release of the current job.  The job is
+ * given the deadline of its release time plus the task's relative deadline.
+ * If the current job has already run past that release the next job starts
+ * straight away, with the same deadline it would have had if it had been
+ * released on time.
+ *
+ * With configUSE_EDF_HIGH_RES_TIME set to 1 the release is made by the high
+ * resolution alarm of the port at the exact release time, rather than on the
+ * next tick.  Otherwise it works like vTaskDelayUntil() with the task's period
+ * and a last wake time that the kernel keeps for the task.
+ *
+ * Example usage:
+   <pre>
+ // A task created with xTaskCreatePeriodic( ..., tskTICKS_TO_EDF_TIME( 10 ) ).
+ void vTaskFunction( void * pvParameters )
+ {
+	 for( ;; )
+	 {
+		 // Perform action here.
+
+		 // Wait for the next job, released 10 ticks after this one.
+		 vTaskDelayUntilNextRelease();
+	 }
+ }
+   </pre>
+ * \defgroup vTaskDelayUntilNextRelease vTaskDelayUntilNextRelease
+ * \ingroup TaskCtrl
+ */
+void vTaskDelayUntilNextRelease( void ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>BaseType_t xTaskAbortDelay( TaskHandle_t xTask );</pre>
@@ -1551,6 +1729,46 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask, void *pvParameter )
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * <pre>TickType_t xTaskGetCurrentDeadline( void );</pre>
+ *
+ * Returns the absolute deadline of the calling task's current job, in ticks or
+ * in high resolution time if configUSE_EDF_HIGH_RES_TIME is set to 1.
+ *
+ * Only available when configUSE_EDF_SCHEDULER is set to 1.
+ */
+TickType_t xTaskGetCurrentDeadline( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <pre>void vTaskSetWcet( TaskHandle_t xTask, TickType_t xWcet );</pre>
+ *
+ * Sets the worst case execution time, in ticks, of one job of the periodic
+ * task xTask.  Passing xTask as NULL sets the WCET of the calling task.  The
+ * slack stealing scheduler trusts this value: a periodic task that runs for
+ * longer than its WCET can miss its deadline while best-effort tasks run.
+ *
+ * Only available when configUSE_EDF_SLACK_STEALING is set to 1.
+ */
+void vTaskSetWcet( TaskHandle_t xTask, TickType_t xWcet ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <pre>TickType_t xTaskGetSystemSlack( void );</pre>
+ *
+ * Returns the number of ticks of processor time that can be given away from
+ * now on without any periodic job missing its deadline.  The value is
+ * computed from the deadlines of the ready jobs, the next release of every
+ * blocked task, and the WCET set for each task with vTaskSetWcet().  A task
+ * blocked on anything other than a delay, such as a sporadic task waiting to
+ * be released, is assumed to be released as soon as its minimum inter-arrival
+ * time allows.
+ *
+ * Only available when configUSE_EDF_SLACK_STEALING is set to 1.
+ */
+TickType_t xTaskGetSystemSlack( void ) PRIVILEGED_FUNCTION;
+
 /**
  * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
  * uxTaskGetSystemState() to be available.
@@ -1751,6 +1969,149 @@ void vTaskList( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unquali
  */
 void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
+/**
+ * task. h
+ * <PRE>UBaseType_t uxTaskGetStackProfile( TaskStackProfile_t * const pxProfileArray, const UBaseType_t uxArraySize );</PRE>
+ *
+ * configUSE_STACK_PROFILER must be defined as 1 for this function to be
+ * available.
+ *
+ * With the profiler enabled the idle task checks the stacks of all the tasks
+ * for words that no longer hold the value the stacks were filled with when the
+ * tasks were created.  It checks no more than configSTACK_PROFILER_WORDS_PER_CALL
+ * words on each pass of its loop, working through one task at a time, so it
+ * can run continuously without adding to the time taken by a context switch.
+ * The peak usage of each task is kept for as long as the task exists.
+ *
+ * The peak is only as good as the code paths the tasks have taken while being
+ * profiled, and it takes the idle task some time to work through every stack,
+ * so let the application run through all its modes before reading the
+ * profile.  The recommended stack sizes add configSTACK_PROFILER_MARGIN_PERCENT
+ * to the peaks to cover paths that were not seen.
+ *
+ * @param pxProfileArray An array of TaskStackProfile_t structures, one of
+ * which is filled in for each task, up to uxArraySize tasks.
+ *
+ * @param uxArraySize The number of structures in pxProfileArray.
+ *
+ * @return The number of structures filled in.
+ *
+ * \defgroup uxTaskGetStackProfile uxTaskGetStackProfile
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskGetStackProfile( TaskStackProfile_t * const pxProfileArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>void vTaskGetStackProfileReport( char *pcWriteBuffer );</PRE>
+ *
+ * configUSE_STACK_PROFILER, configUSE_TRACE_FACILITY and
+ * configUSE_STATS_FORMATTING_FUNCTIONS must all be defined as 1 for this
+ * function to be available.
+ *
+ * Formats the output of uxTaskGetStackProfile() into a human readable table.
+ * Each line gives a task name, the stack size the task was created with, its
+ * peak stack usage and its recommended stack size, all in words.  A last line
+ * gives the total of the current stack sizes and the total of the recommended
+ * sizes.
+ *
+ * Like vTaskList(), this function is provided for convenience only and depends
+ * on sprintf().  Production systems should call uxTaskGetStackProfile()
+ * directly.
+ *
+ * @param pcWriteBuffer A buffer into which the report will be written, in
+ * ASCII form.  This buffer is assumed to be large enough to contain the
+ * generated report.  Approximately 40 bytes per task should be sufficient.
+ *
+ * \defgroup vTaskGetStackProfileReport vTaskGetStackProfileReport
+ * \ingroup TaskUtils
+ */
+void vTaskGetStackProfileReport( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/**
+ * task. h
+ * <PRE>BaseType_t xTaskGetWcetProfile( TaskHandle_t xTask, TaskWcetProfile_t * const pxProfile );</PRE>
+ *
+ * configUSE_WCET_PROFILER and configGENERATE_RUN_TIME_STATS must both be
+ * defined as 1 for this function to be available.
+ *
+ * With the profiler enabled the kernel measures the execution time of each job
+ * of each task.  A job is released when the task is unblocked from a delay,
+ * such as the vTaskDelayUntil() at the end of each periodic job, or by
+ * xTaskReleaseSporadicFromISR().  The execution time of a job is the time the
+ * task spent in the Running state between its release and the release of its
+ * next job, read from the run time stats counter (Timer1 on the LPC2129 demo),
+ * so the time the job spent preempted or blocked is not included.  Time spent
+ * in interrupts that ran while the job was running is included.  The time is
+ * added to the task's histogram when the next job is released.
+ *
+ * The histogram buckets are all the same width, a power of two counts, and are
+ * widened as longer jobs are seen so the histogram always covers the longest
+ * job.  The minimum and maximum are exact; the percentiles are the upper edges
+ * of the buckets they fall in, so never under estimate.
+ *
+ * @param xTask The handle of the task being queried.  Passing NULL queries the
+ * calling task.
+ *
+ * @param pxProfile The structure into which the profile is written.
+ *
+ * @return pdPASS if at least one job of the task has been measured, otherwise
+ * pdFAIL.
+ *
+ * \defgroup xTaskGetWcetProfile xTaskGetWcetProfile
+ * \ingroup TaskUtils
+ */
+BaseType_t xTaskGetWcetProfile( TaskHandle_t xTask, TaskWcetProfile_t * const pxProfile ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>size_t xTaskGetWcetFrame( uint8_t * const pucBuffer, const size_t xBufferLength );</PRE>
+ *
+ * configUSE_WCET_PROFILER and configGENERATE_RUN_TIME_STATS must both be
+ * defined as 1 for this function to be available.
+ *
+ * Writes the execution time profiles of all the tasks into a binary frame that
+ * can be sent over a serial link and fed to a schedulability analysis tool.
+ * All multi-byte fields are little endian.  The frame is:
+ *
+ * Header, 14 bytes:
+ *   'W', 'C'                   - frame marker.
+ *   uint8_t version            - 1.
+ *   uint8_t task count         - the number of task records that follow.
+ *   uint8_t name length        - configMAX_TASK_NAME_LEN.
+ *   uint8_t bucket count       - configWCET_HISTOGRAM_BUCKETS.
+ *   uint32_t counter frequency - configWCET_COUNTER_HZ, 0 if not known.
+ *   uint32_t tick frequency    - configTICK_RATE_HZ.
+ *
+ * Then a record per task:
+ *   char name[ name length ]   - zero padded.
+ *   uint32_t period            - the period, or relative deadline, in ticks
+ *                                when the EDF scheduler is used, else 0.
+ *   uint32_t jobs, min, max, 99th percentile, 90th percentile
+ *                              - execution times in counter counts.
+ *   uint8_t bucket shift       - the buckets are 2^shift counts wide.
+ *   uint16_t histogram[ bucket count ].
+ *
+ * Then a uint16_t CRC-16/CCITT-FALSE (polynomial 0x1021, initial value
+ * 0xffff) of all the bytes before it.
+ *
+ * Records that do not fit in the buffer are left out, and the task count says
+ * how many were written.
+ *
+ * @param pucBuffer The buffer into which the frame is written.
+ *
+ * @param xBufferLength The size of pucBuffer in bytes.  A frame for n tasks
+ * needs 16 + n * ( configMAX_TASK_NAME_LEN + 25 + 2 * configWCET_HISTOGRAM_BUCKETS )
+ * bytes.
+ *
+ * @return The length of the frame, or 0 if the buffer cannot hold even the
+ * header.
+ *
+ * \defgroup xTaskGetWcetFrame xTaskGetWcetFrame
+ * \ingroup TaskUtils
+ */
+size_t xTaskGetWcetFrame( uint8_t * const pucBuffer, const size_t xBufferLength ) PRIVILEGED_FUNCTION;
+
 /**
 * task. h
 * <PRE>uint32_t ulTaskGetIdleRunTimeCounter( void );</PRE>
@@ -1783,7 +2144,8 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
+ * <PRE>BaseType_t xTaskNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction );
+ BaseType_t xTaskNotifyIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1791,6 +2153,14 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * When configUSE_TASK_NOTIFICATIONS is set to one each task has its own private
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
+ * Each task has an array of configTASK_NOTIFICATION_ARRAY_ENTRIES notification
+ * values and states.  Every index is independent of the others, so several
+ * event sources can each signal a task through their own index without the
+ * RAM and the event lists of a queue.  The functions with the Indexed suffix
+ * take the index to use.  xTaskNotify() and the other functions without the
+ * suffix use index 0 (tskDEFAULT_INDEX_TO_NOTIFY), and are equivalent to
+ * calling the Indexed version with uxIndexToNotify set to 0.
+ *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
  * are a method of sending an event directly to a task without the need for such
@@ -1819,6 +2189,10 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify The index of the notification value to update, which
+ * must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.  Only a task waiting
+ * on the same index is unblocked.  Not present in xTaskNotify().
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1860,13 +2234,16 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
-#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
-#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+#define xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
+ * <PRE>BaseType_t xTaskNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );
+ BaseType_t xTaskNotifyIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1905,6 +2282,10 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify The index of the notification value to update, which
+ * must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.  Only a task waiting
+ * on the same index is unblocked.  Not present in xTaskNotify().
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1951,13 +2332,16 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
-#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
-#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
+ * <PRE>BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );
+ BaseType_t xTaskNotifyWaitIndexed( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -2028,11 +2412,14 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+#define xTaskNotifyWaitIndexed( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( uxIndexToWaitOn ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotifyGive( TaskHandle_t xTaskToNotify );</PRE>
+ * <PRE>BaseType_t xTaskNotifyGive( TaskHandle_t xTaskToNotify );
+ BaseType_t xTaskNotifyGiveIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -2074,11 +2461,13 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyGive xTaskNotifyGive
  * \ingroup TaskNotifications
  */
-#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
 /**
  * task. h
  * <PRE>void vTaskNotifyGiveFromISR( TaskHandle_t xTaskHandle, BaseType_t *pxHigherPriorityTaskWoken );
+ void vTaskNotifyGiveIndexedFromISR( TaskHandle_t xTaskHandle, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken );
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -2129,11 +2518,72 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pxHigherPriorityTaskWoken ) )
+#define vTaskNotifyGiveIndexedFromISR( xTaskToNotify, uxIndexToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * task. h
+ * <PRE>BaseType_t xTaskReleaseSporadicFromISR( TaskHandle_t xTaskToRelease, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * Only available when configUSE_EDF_SCHEDULER and configUSE_TASK_NOTIFICATIONS
+ * are both set to 1.
+ *
+ * Releases a job of a sporadic task from an interrupt.  A sporadic task is
+ * created with xTaskCreateSporadic(), or with xTaskCreatePeriodic() if its
+ * relative deadline equals its minimum inter-arrival time, and instead of
+ * calling vTaskDelayUntilNextRelease() at the end of each job it waits for its
+ * next release with ulTaskNotifyTake( pdTRUE, portMAX_DELAY ).  The released job is
+ * given the absolute deadline of its release time plus the task's relative
+ * deadline.
+ *
+ * The release time is the time of the call - to the tick, or to the high
+ * resolution timer if configUSE_EDF_HIGH_RES_TIME is set to 1 - unless that is
+ * sooner than the minimum inter-arrival time after the previous release.  The
+ * first release of a task is never limited.  A release that comes too soon is
+ * counted as a violation, see
+ * uxTaskGetInterArrivalViolations(), and the job is released at the earliest
+ * time the task model allows instead.  That defers its deadline, so a task
+ * released too often cannot take processor time from the rest of the task
+ * set beyond what the schedulability analysis allowed for.
+ *
+ * The release is counted like vTaskNotifyGiveFromISR() on notification index
+ * 0 (tskDEFAULT_INDEX_TO_NOTIFY), which leaves the other indexes free for the
+ * application.  A release that arrives while the previous job is still running
+ * is held until the task next calls ulTaskNotifyTake(), which then starts the
+ * new job with the deadline of its own release.  If ulTaskNotifyTake() clears
+ * the count, one job serves all the releases that were held, with the deadline
+ * of the earliest.
+ *
+ * @param xTaskToRelease The handle of the sporadic task.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the released job has an
+ * earlier deadline than the job that was running when the interrupt occurred,
+ * in which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return pdTRUE if the task was waiting and a new job was released, pdFALSE
+ * if the task was still running a previous job and the release is held.
+ */
+BaseType_t xTaskReleaseSporadicFromISR( TaskHandle_t xTaskToRelease, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>UBaseType_t uxTaskGetInterArrivalViolations( TaskHandle_t xTask );</PRE>
+ *
+ * Only available when configUSE_EDF_SCHEDULER and configUSE_TASK_NOTIFICATIONS
+ * are both set to 1.
+ *
+ * Returns the number of times xTaskReleaseSporadicFromISR() was called for
+ * xTask sooner than the task's minimum inter-arrival time after the previous
+ * release.  Passing xTask as NULL returns the count of the calling task.
+ */
+UBaseType_t uxTaskGetInterArrivalViolations( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
- * <PRE>uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
+ * <PRE>uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );
+ uint32_t ulTaskNotifyTakeIndexed( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -2198,30 +2648,38 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  * \defgroup ulTaskNotifyTake ulTaskNotifyTake
  * \ingroup TaskNotifications
  */
-uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyTake( xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( xClearCountOnExit ), ( xTicksToWait ) )
+#define ulTaskNotifyTakeIndexed( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( uxIndexToWaitOn ), ( xClearCountOnExit ), ( xTicksToWait ) )
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );</pre>
+ * <PRE>BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+ BaseType_t xTaskNotifyStateClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear );</pre>
  *
  * If the notification state of the task referenced by the handle xTask is
  * eNotified, then set the task's notification state to eNotWaitingNotification.
  * The task's notification value is not altered.  Set xTask to NULL to clear the
- * notification state of the calling task.
+ * notification state of the calling task.  xTaskNotifyStateClear() clears the
+ * state at index 0, xTaskNotifyStateClearIndexed() the state at uxIndexToClear.
  *
  * @return pdTRUE if the task's notification state was set to
  * eNotWaitingNotification, otherwise pdFALSE.
  * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyStateClear( xTask ) xTaskGenericNotifyStateClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ) )
+#define xTaskNotifyStateClearIndexed( xTask, uxIndexToClear ) xTaskGenericNotifyStateClear( ( xTask ), ( uxIndexToClear ) )
 
 /**
 * task. h
-* <PRE>uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear );</pre>
+* <PRE>uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear );
+ uint32_t ulTaskNotifyValueClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear );</pre>
 *
 * Clears the bits specified by the ulBitsToClear bit mask in the notification
-* value of the task referenced by xTask.
+* value of the task referenced by xTask, at index 0 for
+* ulTaskNotifyValueClear() or at uxIndexToClear for the Indexed version.
 *
 * Set ulBitsToClear to 0xffffffff (UINT_MAX on 32-bit architectures) to clear
 * the notification value to 0.  Set ulBitsToClear to 0 to query the task's
@@ -2232,7 +2690,9 @@ BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
 * \defgroup ulTaskNotifyValueClear ulTaskNotifyValueClear
 * \ingroup TaskNotifications
 */
-uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyValueClear( xTask, ulBitsToClear ) ulTaskGenericNotifyValueClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulBitsToClear ) )
+#define ulTaskNotifyValueClearIndexed( xTask, uxIndexToClear, ulBitsToClear ) ulTaskGenericNotifyValueClear( ( xTask ), ( uxIndexToClear ), ( ulBitsToClear ) )
 
 /**
  * task.h
@@ -2352,6 +2812,22 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut, TickType_t * const
  */
 BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Only used when configUSE_EDF_HIGH_RES_TIME is set to 1.  Called from the
+ * interrupt of the alarm set by portEDF_SET_HIGH_RES_ALARM(), this releases
+ * every job of a task waiting in vTaskDelayUntilNextRelease() whose release
+ * time has been reached, and sets the alarm for the next release.  The port
+ * should clear the alarm interrupt before calling it, so an alarm set for a
+ * release that falls due meanwhile is not lost.  If a non-zero value is
+ * returned then a context switch is required because a released job has an
+ * earlier deadline than the running task.
+ */
+BaseType_t xTaskHighResTimeAlarm( void ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -2426,6 +2902,25 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTi
 BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THESE FUNCTIONS MUST BE CALLED WITH THE SCHEDULER SUSPENDED.
+ *
+ * A batched form of vTaskRemoveFromUnorderedEventList() for callers that may
+ * unblock several tasks at once.  vTaskStageFromUnorderedEventList() removes
+ * the task from the event list and the blocked list and, when the EDF
+ * scheduler is used, holds it in pxStagingList in deadline order rather than
+ * inserting it into the ready list.  vTaskAddStagedTasksToReadyList() then
+ * merges every staged task into the ready list in a single pass and makes one
+ * preemption decision for the whole batch.  pxStagingList must have been
+ * initialised with vListInitialise() and must be passed to
+ * vTaskAddStagedTasksToReadyList() before the scheduler is resumed.
+ */
+void vTaskStageFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue, List_t * pxStagingList ) PRIVILEGED_FUNCTION;
+void vTaskAddStagedTasksToReadyList( List_t * pxStagingList ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
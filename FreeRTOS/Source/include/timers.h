@@ -1262,6 +1262,41 @@ void vTimerSetReloadMode( TimerHandle_t xTimer, const UBaseType_t uxAutoReload )
 */
 UBaseType_t uxTimerGetReloadMode( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlackInTicks );
+ *
+ * configUSE_TIMER_COALESCING must be set to 1 in FreeRTOSConfig.h for
+ * vTimerSetSlack() to be available.
+ *
+ * Sets how late a timer can be run.  A timer that has expired is run no later
+ * than xSlackInTicks ticks after its expiry time, and is run earlier if the
+ * timer service task wakes within that window to run another timer.  Giving
+ * timers slack therefore lets timers that expire close together be run by one
+ * wake up of the timer service task.  Auto-reload timers are reloaded from
+ * their expiry time, so the slack does not lengthen their period.
+ *
+ * A timer has no slack when it is created.  The new slack is used from the
+ * next time the timer is started, reset, or reloaded.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param xSlackInTicks The number of ticks after its expiry time by which the
+ * timer must have been run.
+ */
+void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlackInTicks ) PRIVILEGED_FUNCTION;
+
+/**
+ * TickType_t xTimerGetSlack( TimerHandle_t xTimer );
+ *
+ * configUSE_TIMER_COALESCING must be set to 1 in FreeRTOSConfig.h for
+ * xTimerGetSlack() to be available.
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @return The slack of the timer in ticks, as set by vTimerSetSlack().
+ */
+TickType_t xTimerGetSlack( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
 /**
  * TickType_t xTimerGetPeriod( TimerHandle_t xTimer );
  *
@@ -0,0 +1,351 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "mempool.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+#if( configUSE_COUNTING_SEMAPHORES != 1 )
+	#error configUSE_COUNTING_SEMAPHORES must be set to 1 in FreeRTOSConfig.h to use memory pools.
+#endif
+
+/* Free blocks are linked through their first word, so the free list needs no
+memory of its own.  The counting semaphore holds the number of free blocks and
+provides the blocking when the pool is empty.  A block is always pushed onto
+the free list before the semaphore is given, and the semaphore is always taken
+before a block is popped, so a successful take guarantees the list is not
+empty. */
+typedef struct MemPoolDef_t
+{
+	void *pvFreeList;					/*< The first free block. */
+	uint8_t *pucStorage;				/*< The start of the block storage, used to validate freed blocks. */
+	SemaphoreHandle_t xFreeBlocks;		/*< Counts the free blocks. */
+	size_t xBlockStride;				/*< The block size rounded up to keep blocks aligned. */
+	UBaseType_t uxBlockCount;
+
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		StaticSemaphore_t xFreeBlocksBuffer;	/*< Holds xFreeBlocks when the pool is created statically. */
+	#endif
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the pool is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} MemPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Links every block in the storage into the free list.
+ */
+static void prvInitialiseNewMemPool( MemPool_t *pxMemPool, size_t xBlockStride, UBaseType_t uxBlockCount, uint8_t *pucStorage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes the first block from the free list.  Must only be called after the
+ * free block semaphore has been taken.
+ */
+static void *prvPopFreeBlock( MemPool_t *pxMemPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Places pvBlock at the head of the free list.
+ */
+static void prvPushFreeBlock( MemPool_t *pxMemPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	MemPoolHandle_t xMemPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount )
+	{
+	MemPool_t *pxMemPool;
+	const size_t xBlockStride = mempoolBLOCK_STRIDE( xBlockSize );
+	const size_t xControlSize = ( sizeof( MemPool_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+		configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+
+		/* Allocate the control structure and the blocks together.  The blocks
+		follow the control structure, which is padded so they start on an
+		aligned boundary. */
+		pxMemPool = ( MemPool_t * ) pvPortMalloc( xControlSize + ( xBlockStride * ( size_t ) uxBlockCount ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned to portBYTE_ALIGNMENT. */
+
+		if( pxMemPool != NULL )
+		{
+			pxMemPool->xFreeBlocks = xSemaphoreCreateCounting( uxBlockCount, uxBlockCount );
+
+			if( pxMemPool->xFreeBlocks != NULL )
+			{
+				prvInitialiseNewMemPool( pxMemPool, xBlockStride, uxBlockCount, ( ( uint8_t * ) pxMemPool ) + xControlSize );
+
+				#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+				{
+					/* Both static and dynamic allocation can be used, so note
+					this pool was allocated dynamically in case it is later
+					deleted. */
+					pxMemPool->ucStaticallyAllocated = pdFALSE;
+				}
+				#endif /* configSUPPORT_STATIC_ALLOCATION */
+			}
+			else
+			{
+				vPortFree( pxMemPool );
+				pxMemPool = NULL;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxMemPool;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	MemPoolHandle_t xMemPoolCreateStatic( size_t xBlockSize, UBaseType_t uxBlockCount, uint8_t *pucPoolStorage, StaticMemPool_t *pxStaticMemPool )
+	{
+	MemPool_t *pxMemPool;
+
+		configASSERT( pucPoolStorage );
+		configASSERT( pxStaticMemPool );
+		configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+		configASSERT( ( ( ( size_t ) pucPoolStorage ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticMemPool_t equals the size of the real
+			memory pool structure. */
+			volatile size_t xSize = sizeof( StaticMemPool_t );
+			configASSERT( xSize == sizeof( MemPool_t ) );
+		} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		pxMemPool = ( MemPool_t * ) pxStaticMemPool; /*lint !e740 !e9087 MemPool_t and StaticMemPool_t are deliberately aliased for data hiding purposes and guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+		pxMemPool->xFreeBlocks = xSemaphoreCreateCountingStatic( uxBlockCount, uxBlockCount, &( pxMemPool->xFreeBlocksBuffer ) );
+		prvInitialiseNewMemPool( pxMemPool, mempoolBLOCK_STRIDE( xBlockSize ), uxBlockCount, pucPoolStorage );
+
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			/* Both static and dynamic allocation can be used, so note that
+			this pool was created statically in case it is later deleted. */
+			pxMemPool->ucStaticallyAllocated = pdTRUE;
+		}
+		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+		return pxMemPool;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void *pvMemPoolAlloc( MemPoolHandle_t xMemPool, TickType_t xTicksToWait )
+{
+MemPool_t * const pxMemPool = xMemPool;
+void *pvReturn = NULL;
+
+	configASSERT( pxMemPool );
+
+	if( xSemaphoreTake( pxMemPool->xFreeBlocks, xTicksToWait ) == pdPASS )
+	{
+		taskENTER_CRITICAL();
+		{
+			pvReturn = prvPopFreeBlock( pxMemPool );
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMemPoolAllocFromISR( MemPoolHandle_t xMemPool )
+{
+MemPool_t * const pxMemPool = xMemPool;
+void *pvReturn = NULL;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxMemPool );
+
+	/* Taking a counting semaphore never unblocks a task, so there is no need
+	to pass a higher priority task woken flag. */
+	if( xSemaphoreTakeFromISR( pxMemPool->xFreeBlocks, NULL ) == pdPASS )
+	{
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			pvReturn = prvPopFreeBlock( pxMemPool );
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFree( MemPoolHandle_t xMemPool, void *pvBlock )
+{
+MemPool_t * const pxMemPool = xMemPool;
+
+	configASSERT( pxMemPool );
+
+	taskENTER_CRITICAL();
+	{
+		prvPushFreeBlock( pxMemPool, pvBlock );
+	}
+	taskEXIT_CRITICAL();
+
+	( void ) xSemaphoreGive( pxMemPool->xFreeBlocks );
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFreeFromISR( MemPoolHandle_t xMemPool, void *pvBlock, BaseType_t *pxHigherPriorityTaskWoken )
+{
+MemPool_t * const pxMemPool = xMemPool;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxMemPool );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		prvPushFreeBlock( pxMemPool, pvBlock );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	( void ) xSemaphoreGiveFromISR( pxMemPool->xFreeBlocks, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMemPoolGetFreeBlockCount( MemPoolHandle_t xMemPool )
+{
+MemPool_t * const pxMemPool = xMemPool;
+
+	configASSERT( pxMemPool );
+
+	return uxSemaphoreGetCount( pxMemPool->xFreeBlocks );
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolDelete( MemPoolHandle_t xMemPool )
+{
+MemPool_t * const pxMemPool = xMemPool;
+
+	configASSERT( pxMemPool );
+
+	/* Deleting a pool that still has blocks in use would leave the users of
+	those blocks with dangling pointers. */
+	configASSERT( uxSemaphoreGetCount( pxMemPool->xFreeBlocks ) == pxMemPool->uxBlockCount );
+
+	vSemaphoreDelete( pxMemPool->xFreeBlocks );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		/* The pool can only have been allocated dynamically - free it
+		again. */
+		vPortFree( pxMemPool );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		/* The pool could have been allocated statically or dynamically, so
+		check before attempting to free the memory. */
+		if( pxMemPool->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxMemPool );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewMemPool( MemPool_t *pxMemPool, size_t xBlockStride, UBaseType_t uxBlockCount, uint8_t *pucStorage )
+{
+UBaseType_t uxBlock;
+
+	pxMemPool->pucStorage = pucStorage;
+	pxMemPool->xBlockStride = xBlockStride;
+	pxMemPool->uxBlockCount = uxBlockCount;
+	pxMemPool->pvFreeList = NULL;
+
+	/* Push the blocks in reverse order so they are handed out in address
+	order, which makes the pool easier to inspect in a debugger. */
+	for( uxBlock = uxBlockCount; uxBlock > ( UBaseType_t ) 0; uxBlock-- )
+	{
+		prvPushFreeBlock( pxMemPool, ( void * ) ( pucStorage + ( xBlockStride * ( size_t ) ( uxBlock - ( UBaseType_t ) 1 ) ) ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void *prvPopFreeBlock( MemPool_t *pxMemPool )
+{
+void *pvBlock = pxMemPool->pvFreeList;
+
+	configASSERT( pvBlock );
+	pxMemPool->pvFreeList = *( ( void ** ) pvBlock );
+
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPushFreeBlock( MemPool_t *pxMemPool, void *pvBlock )
+{
+	/* The block must be one of the blocks of this pool. */
+	configASSERT( ( uint8_t * ) pvBlock >= pxMemPool->pucStorage );
+	configASSERT( ( uint8_t * ) pvBlock < ( pxMemPool->pucStorage + ( pxMemPool->xBlockStride * ( size_t ) pxMemPool->uxBlockCount ) ) );
+	configASSERT( ( ( size_t ) ( ( uint8_t * ) pvBlock - pxMemPool->pucStorage ) % pxMemPool->xBlockStride ) == 0 );
+
+	*( ( void ** ) pvBlock ) = pxMemPool->pvFreeList;
+	pxMemPool->pvFreeList = pvBlock;
+}
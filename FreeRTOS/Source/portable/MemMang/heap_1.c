@@ -49,6 +49,10 @@ task.h is included from an application file. */
 	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
 
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	#error This file does not support configUSE_HEAP_INSTRUMENTATION - use heap_2.c, heap_4.c, heap_5.c or heap_tlsf.c.
+#endif
+
 /* A few bytes might be lost to byte aligning the heap start address. */
 #define configADJUSTED_HEAP_SIZE	( configTOTAL_HEAP_SIZE - portBYTE_ALIGNMENT )
 
@@ -41,6 +41,10 @@ all the API functions to use the MPU wrappers.  That should only be done when
 task.h is included from an application file. */
 #define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* Prevents portable.h redirecting the heap functions to the instrumentation
+wrappers. */
+#define portHEAP_IMPLEMENTATION
+
 #include "FreeRTOS.h"
 #include "task.h"
 
@@ -86,6 +90,25 @@ static BlockLink_t xStart, xEnd;
 /* Keeps track of the number of free bytes remaining, but says nothing about
 fragmentation. */
 static size_t xFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
+static size_t xMinimumEverFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	/* The size of the block at the end of the list of free blocks, which is
+	the largest as the list is ordered by size. */
+	static size_t xLargestFreeBlockSize = 0;
+
+	#define heapRECORD_INSERTED_BLOCK( xBlockSize )			\
+	{														\
+		portHEAP_FREE_BLOCK_ADDED( xBlockSize );			\
+															\
+		if( ( xBlockSize ) >= xLargestFreeBlockSize )		\
+		{													\
+			xLargestFreeBlockSize = ( xBlockSize );			\
+		}													\
+	}
+#else
+	#define heapRECORD_INSERTED_BLOCK( xBlockSize )
+#endif
 
 /* STATIC FUNCTIONS ARE DEFINED AS MACROS TO MINIMIZE THE FUNCTION CALL DEPTH. */
 
@@ -112,6 +135,8 @@ size_t xBlockSize;																	\
 	/* position. */																	\
 	pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;					\
 	pxIterator->pxNextFreeBlock = pxBlockToInsert;									\
+																					\
+	heapRECORD_INSERTED_BLOCK( xBlockSize );										\
 }
 /*-----------------------------------------------------------*/
 
@@ -168,6 +193,19 @@ void *pvReturn = NULL;
 				list of free blocks. */
 				pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
 
+				#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+				{
+					portHEAP_FREE_BLOCK_REMOVED( pxBlock->xBlockSize );
+
+					/* If the block was the last in the list then the block
+					before it is now the largest. */
+					if( pxPreviousBlock->pxNextFreeBlock == &xEnd )
+					{
+						xLargestFreeBlockSize = pxPreviousBlock->xBlockSize;
+					}
+				}
+				#endif
+
 				/* If the block is larger than required it can be split into two. */
 				if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
 				{
@@ -186,6 +224,11 @@ void *pvReturn = NULL;
 				}
 
 				xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
 			}
 		}
 
@@ -240,6 +283,12 @@ size_t xPortGetFreeHeapSize( void )
 }
 /*-----------------------------------------------------------*/
 
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
 void vPortInitialiseBlocks( void )
 {
 	/* This just exists to keep the linker quiet. */
@@ -268,5 +317,15 @@ uint8_t *pucAlignedHeap;
 	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
 	pxFirstFreeBlock->xBlockSize = configADJUSTED_HEAP_SIZE;
 	pxFirstFreeBlock->pxNextFreeBlock = &xEnd;
+	heapRECORD_INSERTED_BLOCK( pxFirstFreeBlock->xBlockSize );
 }
 /*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	size_t xPortGetLargestFreeBlockSize( void )
+	{
+		return xLargestFreeBlockSize;
+	}
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
@@ -74,6 +74,10 @@ all the API functions to use the MPU wrappers.  That should only be done when
 task.h is included from an application file. */
 #define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* Prevents portable.h redirecting the heap functions to the instrumentation
+wrappers. */
+#define portHEAP_IMPLEMENTATION
+
 #include "FreeRTOS.h"
 #include "task.h"
 
@@ -107,6 +111,26 @@ typedef struct A_BLOCK_LINK
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
 
+/*
+ * Called each time a block is added to or taken out of the list of free
+ * blocks, including the blocks merged by prvInsertBlockIntoFreeList().  They
+ * keep the count of free blocks in each size class and the largest free block
+ * up to date, and pass the block on to the heap instrumentation.
+ */
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	static void prvFreeBlockAdded( size_t xBlockSize );
+	static void prvFreeBlockRemoved( size_t xBlockSize );
+
+	/*
+	 * Returns the index of the most significant set bit in xValue, which is
+	 * the size class of a block of xValue bytes.
+	 */
+	static UBaseType_t prvFindLastSet( size_t xValue );
+#else
+	#define prvFreeBlockAdded( xBlockSize )
+	#define prvFreeBlockRemoved( xBlockSize )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -123,6 +147,21 @@ static size_t xMinimumEverFreeBytesRemaining = 0U;
 static size_t xNumberOfSuccessfulAllocations = 0;
 static size_t xNumberOfSuccessfulFrees = 0;
 
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	/* The number of free blocks in each power of two size class, and a bit for
+	each class that is not empty. */
+	#define heapSIZE_CLASS_COUNT	( sizeof( size_t ) * heapBITS_PER_BYTE )
+	static size_t xFreeBlocksPerSizeClass[ heapSIZE_CLASS_COUNT ];
+	static size_t xSizeClassBitmap = 0;
+
+	/* The size of the largest free block.  The list of free blocks is ordered
+	by address, so when the largest block is allocated the next largest is not
+	known.  It is known again once a free block is the only one in the highest
+	non empty size class. */
+	static size_t xLargestFreeBlockSize = 0;
+	static BaseType_t xLargestFreeBlockIsKnown = pdTRUE;
+#endif
+
 /* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
 member of an BlockLink_t structure is set then the block belongs to the
 application.  When the bit is free the block is still part of the free heap
@@ -195,6 +234,21 @@ void *pvReturn = NULL;
 					of the list of free blocks. */
 					pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
 
+					#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+					{
+						prvFreeBlockRemoved( pxBlock->xBlockSize );
+
+						if( pxBlock->xBlockSize == xLargestFreeBlockSize )
+						{
+							xLargestFreeBlockIsKnown = pdFALSE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif
+
 					/* If the block is larger than required it can be split into
 					two. */
 					if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
@@ -350,6 +404,7 @@ uint8_t *puc;
 	puc = ( uint8_t * ) pxIterator;
 	if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
 	{
+		prvFreeBlockRemoved( pxIterator->xBlockSize );
 		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
 		pxBlockToInsert = pxIterator;
 	}
@@ -366,6 +421,7 @@ uint8_t *puc;
 		if( pxIterator->pxNextFreeBlock != pxEnd )
 		{
 			/* Form one big block from the two blocks. */
+			prvFreeBlockRemoved( pxIterator->pxNextFreeBlock->xBlockSize );
 			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
 			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
 		}
@@ -391,6 +447,10 @@ uint8_t *puc;
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
+
+	/* The merged block can be larger than any free block was, in which case
+	it becomes the largest. */
+	prvFreeBlockAdded( pxBlockToInsert->xBlockSize );
 }
 /*-----------------------------------------------------------*/
 
@@ -472,6 +532,8 @@ const HeapRegion_t *pxHeapRegion;
 
 		xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
 
+		prvFreeBlockAdded( pxFirstFreeBlockInRegion->xBlockSize );
+
 		/* Move onto the next HeapRegion_t structure. */
 		xDefinedRegions++;
 		pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
@@ -545,3 +607,114 @@ size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY use
 	taskEXIT_CRITICAL();
 }
 
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	size_t xPortGetLargestFreeBlockSize( void )
+	{
+	size_t xSize = 0;
+
+		/* Called from vPortGetHeapInstrumentation() with the scheduler
+		suspended.  The free blocks are never walked.  If the largest is not
+		known, the start of the highest non empty size class is the most that
+		can be said for certain can be allocated. */
+		if( xLargestFreeBlockIsKnown != pdFALSE )
+		{
+			xSize = xLargestFreeBlockSize;
+		}
+		else if( xSizeClassBitmap != 0 )
+		{
+			xSize = ( ( size_t ) 1 ) << prvFindLastSet( xSizeClassBitmap );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xSize;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvFreeBlockAdded( size_t xBlockSize )
+	{
+	UBaseType_t uxClass = prvFindLastSet( xBlockSize );
+
+		portHEAP_FREE_BLOCK_ADDED( xBlockSize );
+		xFreeBlocksPerSizeClass[ uxClass ]++;
+		xSizeClassBitmap |= ( ( size_t ) 1 ) << uxClass;
+
+		if( xLargestFreeBlockIsKnown != pdFALSE )
+		{
+			if( xBlockSize > xLargestFreeBlockSize )
+			{
+				xLargestFreeBlockSize = xBlockSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( ( ( xSizeClassBitmap >> uxClass ) == ( size_t ) 1 ) && ( xFreeBlocksPerSizeClass[ uxClass ] == ( size_t ) 1 ) )
+		{
+			/* Every other free block is in a lower size class, so is
+			smaller. */
+			xLargestFreeBlockSize = xBlockSize;
+			xLargestFreeBlockIsKnown = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvFreeBlockRemoved( size_t xBlockSize )
+	{
+	UBaseType_t uxClass;
+
+		/* The end marker of every region but the last is a zero sized block in
+		the list of free blocks.  It was never counted, but is merged into a
+		block freed just below it. */
+		if( xBlockSize != ( size_t ) 0 )
+		{
+			/* A block merged into another is not really gone, so the largest
+			free block is only forgotten by pvPortMalloc(). */
+			uxClass = prvFindLastSet( xBlockSize );
+			portHEAP_FREE_BLOCK_REMOVED( xBlockSize );
+			configASSERT( xFreeBlocksPerSizeClass[ uxClass ] > ( size_t ) 0 );
+			xFreeBlocksPerSizeClass[ uxClass ]--;
+
+			if( xFreeBlocksPerSizeClass[ uxClass ] == ( size_t ) 0 )
+			{
+				xSizeClassBitmap &= ~( ( ( size_t ) 1 ) << uxClass );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static UBaseType_t prvFindLastSet( size_t xValue )
+	{
+	UBaseType_t uxBit = 0, uxShift;
+
+		configASSERT( xValue != ( size_t ) 0 );
+
+		for( uxShift = ( UBaseType_t ) ( heapSIZE_CLASS_COUNT >> 1 ); uxShift > ( UBaseType_t ) 0; uxShift >>= 1 )
+		{
+			if( ( xValue >> uxShift ) != ( size_t ) 0 )
+			{
+				xValue >>= uxShift;
+				uxBit += uxShift;
+			}
+		}
+
+		return uxBit;
+	}
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
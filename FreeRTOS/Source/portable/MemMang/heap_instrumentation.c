@@ -0,0 +1,331 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Heap instrumentation that can be built alongside heap_2.c, heap_4.c,
+ * heap_5.c or heap_tlsf.c when configUSE_HEAP_INSTRUMENTATION is set to 1.
+ *
+ * The application's calls to pvPortMalloc() and vPortFree() are redirected by
+ * portable.h to the wrappers below, which time the call to the real heap
+ * function and attribute each allocation to the file and line it was made
+ * from.  The heap reports each block it adds to or takes out of its free
+ * blocks, so the number of free blocks and their size classes are always up
+ * to date, and taking a snapshot does not walk the heap.
+ *
+ * See portable.h for the definitions of the histogram buckets.
+ */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This file calls the real pvPortMalloc() and vPortFree(). */
+#define portHEAP_IMPLEMENTATION
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/* The timer used to measure allocation latency can be set separately from the
+run time stats counter, which is often too coarse to resolve a single call. */
+#ifndef configHEAP_LATENCY_TIMER_VALUE
+	#if( ( configGENERATE_RUN_TIME_STATS == 1 ) && defined( portGET_RUN_TIME_COUNTER_VALUE ) )
+		#define configHEAP_LATENCY_TIMER_VALUE()	( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+	#endif
+#endif
+
+/* The running counters.  Only the latency, failure and call site fields are
+used - the free block fields are kept separately as they are not cleared by
+vPortResetHeapInstrumentation(). */
+static HeapInstrumentation_t xCounters;
+
+static size_t xNumberOfFreeBlocks = 0;
+static size_t xFreeBlocksPerSizeClass[ configHEAP_SIZE_CLASS_COUNT ];
+
+static HeapCallSite_t xCallSites[ configHEAP_CALL_SITE_COUNT ];
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the index of the most significant set bit in ulValue, plus one, so
+ * 0 maps to 0, 1 to 1, 2 and 3 to 2, 4 to 7 to 3, etc.
+ */
+static UBaseType_t prvBitWidth( uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the size class of a free block of xBlockSize bytes.
+ */
+static UBaseType_t prvSizeClass( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds one call to a latency histogram and updates its maximum.
+ */
+static void prvRecordLatency( uint32_t *pulHistogram, uint32_t *pulMaximum, uint32_t ulElapsed ) PRIVILEGED_FUNCTION;
+
+/*
+ * Finds, or claims, the call site table entry for pcFile and ulLine.  Returns
+ * NULL if the table is full.
+ */
+static HeapCallSite_t *prvGetCallSite( const char *pcFile, uint32_t ulLine ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMallocFromCallSite( size_t xSize, const char *pcFile, uint32_t ulLine )
+{
+void *pvReturn;
+HeapCallSite_t *pxCallSite;
+
+	#ifdef configHEAP_LATENCY_TIMER_VALUE
+		uint32_t ulStartTime, ulElapsed;
+
+		ulStartTime = configHEAP_LATENCY_TIMER_VALUE();
+		pvReturn = pvPortMalloc( xSize );
+		ulElapsed = configHEAP_LATENCY_TIMER_VALUE() - ulStartTime;
+	#else
+		pvReturn = pvPortMalloc( xSize );
+	#endif
+
+	vTaskSuspendAll();
+	{
+		#ifdef configHEAP_LATENCY_TIMER_VALUE
+		{
+			prvRecordLatency( xCounters.ulMallocLatency, &( xCounters.ulMaxMallocLatency ), ulElapsed );
+		}
+		#endif
+
+		pxCallSite = prvGetCallSite( pcFile, ulLine );
+
+		if( pvReturn == NULL )
+		{
+			xCounters.ulFailedAllocations++;
+
+			if( pxCallSite != NULL )
+			{
+				pxCallSite->ulFailures++;
+			}
+		}
+		else if( pxCallSite != NULL )
+		{
+			pxCallSite->ulAllocations++;
+			pxCallSite->xBytesRequested += xSize;
+		}
+		else
+		{
+			xCounters.ulUntrackedCallSiteAllocations++;
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFreeTimed( void *pv )
+{
+	#ifdef configHEAP_LATENCY_TIMER_VALUE
+	{
+	uint32_t ulStartTime, ulElapsed;
+
+		ulStartTime = configHEAP_LATENCY_TIMER_VALUE();
+		vPortFree( pv );
+		ulElapsed = configHEAP_LATENCY_TIMER_VALUE() - ulStartTime;
+
+		if( pv != NULL )
+		{
+			vTaskSuspendAll();
+			{
+				prvRecordLatency( xCounters.ulFreeLatency, &( xCounters.ulMaxFreeLatency ), ulElapsed );
+			}
+			( void ) xTaskResumeAll();
+		}
+	}
+	#else
+	{
+		vPortFree( pv );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapInstrumentation( HeapInstrumentation_t *pxSnapshot )
+{
+	vTaskSuspendAll();
+	{
+		*pxSnapshot = xCounters;
+
+		pxSnapshot->xAvailableHeapSpaceInBytes = xPortGetFreeHeapSize();
+		pxSnapshot->xMinimumEverFreeBytesRemaining = xPortGetMinimumEverFreeHeapSize();
+		pxSnapshot->xSizeOfLargestFreeBlockInBytes = xPortGetLargestFreeBlockSize();
+		pxSnapshot->xNumberOfFreeBlocks = xNumberOfFreeBlocks;
+		( void ) memcpy( pxSnapshot->xFreeBlocksPerSizeClass, xFreeBlocksPerSizeClass, sizeof( pxSnapshot->xFreeBlocksPerSizeClass ) );
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetHeapCallSites( HeapCallSite_t *pxCallSites, UBaseType_t uxArraySize )
+{
+UBaseType_t uxIndex, uxCopied = 0;
+
+	vTaskSuspendAll();
+	{
+		for( uxIndex = 0; ( uxIndex < ( UBaseType_t ) configHEAP_CALL_SITE_COUNT ) && ( uxCopied < uxArraySize ); uxIndex++ )
+		{
+			if( xCallSites[ uxIndex ].pcFile != NULL )
+			{
+				pxCallSites[ uxCopied ] = xCallSites[ uxIndex ];
+				uxCopied++;
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return uxCopied;
+}
+/*-----------------------------------------------------------*/
+
+void vPortResetHeapInstrumentation( void )
+{
+	vTaskSuspendAll();
+	{
+		( void ) memset( &xCounters, 0x00, sizeof( xCounters ) );
+		( void ) memset( xCallSites, 0x00, sizeof( xCallSites ) );
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortHeapFreeBlockAdded( size_t xBlockSize )
+{
+	xNumberOfFreeBlocks++;
+	xFreeBlocksPerSizeClass[ prvSizeClass( xBlockSize ) ]++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortHeapFreeBlockRemoved( size_t xBlockSize )
+{
+	configASSERT( xNumberOfFreeBlocks > 0 );
+
+	xNumberOfFreeBlocks--;
+	xFreeBlocksPerSizeClass[ prvSizeClass( xBlockSize ) ]--;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvSizeClass( size_t xBlockSize )
+{
+UBaseType_t uxClass;
+
+	uxClass = prvBitWidth( ( uint32_t ) ( xBlockSize >> portHEAP_SMALLEST_SIZE_CLASS_LOG2 ) );
+
+	if( uxClass >= ( UBaseType_t ) configHEAP_SIZE_CLASS_COUNT )
+	{
+		uxClass = ( UBaseType_t ) configHEAP_SIZE_CLASS_COUNT - 1;
+	}
+
+	return uxClass;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvBitWidth( uint32_t ulValue )
+{
+UBaseType_t uxWidth = 0;
+
+	while( ulValue != 0UL )
+	{
+		ulValue >>= 1;
+		uxWidth++;
+	}
+
+	return uxWidth;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordLatency( uint32_t *pulHistogram, uint32_t *pulMaximum, uint32_t ulElapsed )
+{
+UBaseType_t uxBucket;
+
+	uxBucket = prvBitWidth( ulElapsed );
+
+	if( uxBucket >= ( UBaseType_t ) configHEAP_LATENCY_BUCKET_COUNT )
+	{
+		uxBucket = ( UBaseType_t ) configHEAP_LATENCY_BUCKET_COUNT - 1;
+	}
+
+	pulHistogram[ uxBucket ]++;
+
+	if( ulElapsed > *pulMaximum )
+	{
+		*pulMaximum = ulElapsed;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static HeapCallSite_t *prvGetCallSite( const char *pcFile, uint32_t ulLine )
+{
+UBaseType_t uxIndex, uxProbes;
+HeapCallSite_t *pxReturn = NULL;
+
+	/* Open addressing with linear probing.  The same file name string is
+	normally shared by every call from one file, so its address and the line
+	number identify the call site. */
+	uxIndex = ( UBaseType_t ) ( ( ulLine ^ ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pcFile ) % ( uint32_t ) configHEAP_CALL_SITE_COUNT );
+
+	for( uxProbes = 0; uxProbes < ( UBaseType_t ) configHEAP_CALL_SITE_COUNT; uxProbes++ )
+	{
+		if( xCallSites[ uxIndex ].pcFile == NULL )
+		{
+			/* Not seen before - claim the free entry. */
+			xCallSites[ uxIndex ].pcFile = pcFile;
+			xCallSites[ uxIndex ].ulLine = ulLine;
+			pxReturn = &( xCallSites[ uxIndex ] );
+			break;
+		}
+		else if( ( xCallSites[ uxIndex ].pcFile == pcFile ) && ( xCallSites[ uxIndex ].ulLine == ulLine ) )
+		{
+			pxReturn = &( xCallSites[ uxIndex ] );
+			break;
+		}
+		else
+		{
+			uxIndex++;
+
+			if( uxIndex >= ( UBaseType_t ) configHEAP_CALL_SITE_COUNT )
+			{
+				uxIndex = 0;
+			}
+		}
+	}
+
+	return pxReturn;
+}
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
@@ -54,6 +54,16 @@
 #define portTIMER_MATCH_ISR_BIT		( ( uint8_t ) 0x01 )
 #define portCLEAR_VIC_INTERRUPT		( ( uint32_t ) 0 )
 
+/* Constants required to setup timer 1 as the EDF high resolution time base.
+The alarm uses the lowest priority vectored slot, leaving the others to the
+application. */
+#define portHIGH_RES_PRESCALE_VALUE		( ( configCPU_CLOCK_HZ / configEDF_HIGH_RES_TIME_HZ ) - 1UL )
+#define portRESET_TIMER					( ( uint8_t ) 0x02 )
+#define portINTERRUPT_ON_MATCH1			( ( uint32_t ) 0x08 )
+#define portHIGH_RES_VIC_CHANNEL		( ( uint32_t ) 0x0005 )
+#define portHIGH_RES_VIC_CHANNEL_BIT	( ( uint32_t ) 0x0020 )
+#define portHIGH_RES_MATCH_ISR_BIT		( ( uint8_t ) 0x02 )
+
 /*-----------------------------------------------------------*/
 
 /* The code generated by the Keil compiler does not maintain separate
@@ -70,6 +80,16 @@ volatile uint32_t ulCriticalNesting = 9999UL;
 /* Setup the timer to generate the tick interrupts. */
 static void prvSetupTimerInterrupt( void );
 
+#if configUSE_EDF_HIGH_RES_TIME == 1
+
+	/* Start timer 1 as the EDF high resolution time base. */
+	static void prvSetupHighResTimer( void );
+
+	/* The alarm ISR is written in assembler, see portASM.s. */
+	void vPortHighResAlarm( void );
+
+#endif
+
 /* 
  * The scheduler can only be started from ARM mode, so 
  * vPortStartFirstSTask() is defined in portISR.c. 
@@ -161,6 +181,12 @@ BaseType_t xPortStartScheduler( void )
 	/* Start the timer that generates the tick ISR. */
 	prvSetupTimerInterrupt();
 
+	#if configUSE_EDF_HIGH_RES_TIME == 1
+	{
+		prvSetupHighResTimer();
+	}
+	#endif
+
 	/* Start the first task.  This is done from portISR.c as ARM mode must be
 	used. */
 	vPortStartFirstTask();
@@ -258,6 +284,35 @@ uint32_t ulCompareMatch;
 }
 /*-----------------------------------------------------------*/
 
+#if configUSE_EDF_HIGH_RES_TIME == 1
+
+	static void prvSetupHighResTimer( void )
+	{
+		/* Count from zero, the time the tasks created before the scheduler
+		was started were released at.  The trace macros and the run time stats
+		read the same count. */
+		T1TCR = portRESET_TIMER;
+		T1PR = portHIGH_RES_PRESCALE_VALUE;
+
+		/* The timer runs free - a match only raises the alarm, the kernel
+		then moves match register 1 on to the next release. */
+		T1MCR = portINTERRUPT_ON_MATCH1;
+		T1IR = portHIGH_RES_MATCH_ISR_BIT;
+
+		/* Setup the VIC for the timer. */
+		VICIntSelect &= ~( portHIGH_RES_VIC_CHANNEL_BIT );
+		VICIntEnable |= portHIGH_RES_VIC_CHANNEL_BIT;
+		VICVectAddr15 = ( uint32_t ) vPortHighResAlarm;
+		VICVectCntl15 = portHIGH_RES_VIC_CHANNEL | portTIMER_VIC_ENABLE;
+
+		/* Start the timer - interrupts are disabled when this function is
+		called so it is okay to do this here. */
+		T1TCR = portENABLE_TIMER;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 void vPortEnterCritical( void )
 {
 	/* Disable interrupts as per portDISABLE_INTERRUPTS(); 							*/
@@ -29,16 +29,20 @@
 
 	IMPORT	vTaskSwitchContext
 	IMPORT	xTaskIncrementTick
+	IMPORT	xTaskHighResTimeAlarm [WEAK]	; Only built with configUSE_EDF_HIGH_RES_TIME.
 
 	EXPORT	vPortYieldProcessor
 	EXPORT	vPortStartFirstTask
 	EXPORT	vPreemptiveTick
+	EXPORT	vPortHighResAlarm
 	EXPORT	vPortYield
 
 
 VICVECTADDR	EQU	0xFFFFF030
 T0IR		EQU	0xE0004000
 T0MATCHBIT	EQU	0x00000001
+T1IR		EQU	0xE0008000
+T1MR1BIT	EQU	0x00000002
 
 	ARM
 	AREA	PORT_ASM, CODE, READONLY
@@ -120,5 +124,38 @@ SkipContextSwitch
 
 	portRESTORE_CONTEXT					; Restore the context of the highest
 										; priority task that is ready to run.
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Interrupt service routine for the EDF high resolution alarm
+; Only used if configUSE_EDF_HIGH_RES_TIME is set to 1
+;
+; Uses match register 1 of timer 1 of LPC21XX Family
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+vPortHighResAlarm
+
+	PRESERVE8
+
+	portSAVE_CONTEXT					; Save the context of the current task.
+
+	MOV R0, #T1MR1BIT					; Clear the match event first, so a
+	LDR R1, =T1IR						; match on the alarm the kernel sets
+	STR R0, [R1]						; next is not lost.
+
+	LDR R0, =xTaskHighResTimeAlarm		; Release the jobs that are due.
+	MOV LR, PC
+	BX R0
+
+	CMP R0, #0
+	BEQ SkipHighResContextSwitch
+	LDR R0, =vTaskSwitchContext			; Find the task with the earliest
+	MOV LR, PC							; deadline.
+	BX R0
+SkipHighResContextSwitch
+	LDR	R0, =VICVECTADDR				; Acknowledge the interrupt
+	STR	R0,[R0]
+
+	portRESTORE_CONTEXT					; Restore the context of the task
+										; with the earliest deadline.
 	END
 
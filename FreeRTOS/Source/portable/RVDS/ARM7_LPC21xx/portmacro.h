@@ -72,6 +72,17 @@ typedef unsigned long UBaseType_t;
 #define portBYTE_ALIGNMENT			8
 /*-----------------------------------------------------------*/
 
+/* EDF high resolution time.  port.c runs timer 1 free at
+configEDF_HIGH_RES_TIME_HZ, and its match register 1 raises the alarm. */
+#if( configUSE_EDF_HIGH_RES_TIME == 1 )
+	#define portT1TC_REG				( *( ( volatile uint32_t * ) 0xE0008008UL ) )
+	#define portT1MR1_REG				( *( ( volatile uint32_t * ) 0xE000801CUL ) )
+
+	#define portEDF_GET_HIGH_RES_TIME()				( ( TickType_t ) portT1TC_REG )
+	#define portEDF_SET_HIGH_RES_ALARM( xTime )		( portT1MR1_REG = ( uint32_t ) ( xTime ) )
+#endif
+/*-----------------------------------------------------------*/
+
 /* Task utilities. */
 
 /*-----------------------------------------------------------
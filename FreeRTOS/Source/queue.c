@@ -51,6 +51,7 @@ correct privileged Vs unprivileged linkage and placement. */
 /* Constants used with the cRxLock and cTxLock structure members. */
 #define queueUNLOCKED					( ( int8_t ) -1 )
 #define queueLOCKED_UNMODIFIED			( ( int8_t ) 0 )
+#define queueMAX_LOCK_COUNT				( ( int8_t ) 127 )
 
 /* When the Queue_t structure is used to represent a base queue its pcHead and
 pcTail members are used as pointers into the queue storage area.  When the
@@ -81,6 +82,59 @@ zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME		 ( ( TickType_t ) 0U )
 
+/* A queue with a reserved slot accepts no other writes until the slot is
+committed, as the reserved slot is the one the next write would use.  A queue
+with an item on loan gives up no other items until the loan is released, and
+accepts no writes to the front as they would place a new item ahead of the
+loaned one. */
+#if( configUSE_QUEUE_LOANS == 1 )
+	#define prvIsQueueWriteLoaned( pxQueue, xPosition )	( ( ( pxQueue )->pcWriteLoan != NULL ) || ( ( ( pxQueue )->pcReadLoan != NULL ) && ( ( xPosition ) != queueSEND_TO_BACK ) ) )
+	#define prvIsQueueReadLoaned( pxQueue )				( ( pxQueue )->pcReadLoan != NULL )
+#else
+	#define prvIsQueueWriteLoaned( pxQueue, xPosition )	( pdFALSE )
+	#define prvIsQueueReadLoaned( pxQueue )				( pdFALSE )
+#endif
+
+/* In overwrite-oldest mode a send to the back of a full queue always succeeds,
+except while the oldest item is on loan and so cannot be discarded. */
+#if( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+	#define prvCanOverwriteOldest( pxQueue, xPosition )	( ( ( pxQueue )->ucOverwriteOldest != ( uint8_t ) pdFALSE ) && ( ( xPosition ) == queueSEND_TO_BACK ) && ( prvIsQueueReadLoaned( pxQueue ) == pdFALSE ) )
+#else
+	#define prvCanOverwriteOldest( pxQueue, xPosition )	( pdFALSE )
+#endif
+
+/* Items in a deadline ordered queue stay in the storage slot they were copied
+into, and a min-max heap of slot indices keyed by deadline decides which item
+is received next, and which is discarded when a full queue is overwritten.
+Items sent without a deadline inherit the deadline of the sending task's
+current job, or are due at once if sent from an interrupt. */
+#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+	#if( configUSE_EDF_SCHEDULER == 1 )
+		#define prvGetSenderDeadline( pxQueue )		( ( ( pxQueue )->pxDeadlineHeap != NULL ) ? xTaskGetCurrentDeadline() : ( TickType_t ) 0U )
+	#else
+		#define prvGetSenderDeadline( pxQueue )		( ( ( pxQueue )->pxDeadlineHeap != NULL ) ? xTaskGetTickCount() : ( TickType_t ) 0U )
+	#endif
+	#if( configUSE_EDF_HIGH_RES_TIME == 1 )
+		/* Job deadlines are then in high resolution time rather than ticks. */
+		#define prvGetSenderDeadlineFromISR( pxQueue )	( ( ( pxQueue )->pxDeadlineHeap != NULL ) ? portEDF_GET_HIGH_RES_TIME() : ( TickType_t ) 0U )
+	#else
+		#define prvGetSenderDeadlineFromISR( pxQueue )	( ( ( pxQueue )->pxDeadlineHeap != NULL ) ? xTaskGetTickCountFromISR() : ( TickType_t ) 0U )
+	#endif
+
+	/* Items with equal deadlines are received in the order they were sent.
+	Deadlines are compared through their difference so they stay in order when
+	the time wraps. */
+	#define prvIsEarlierDeadline( pxA, pxB )		( ( ( TickType_t ) ( ( pxA )->xDeadline - ( pxB )->xDeadline ) > ( portMAX_DELAY >> 1 ) ) || ( ( ( pxA )->xDeadline == ( pxB )->xDeadline ) && ( ( BaseType_t ) ( ( pxA )->uxSequence - ( pxB )->uxSequence ) < ( BaseType_t ) 0 ) ) )
+
+	/* The even levels of the heap, starting with the root, hold the earliest
+	deadline of their subtree and the odd levels the latest.  Entry A belongs
+	above entry B on a level of the given kind. */
+	#define prvIsAboveInHeap( xMinLevel, pxA, pxB )	( ( ( xMinLevel ) != pdFALSE ) ? prvIsEarlierDeadline( pxA, pxB ) : prvIsEarlierDeadline( pxB, pxA ) )
+#else
+	#define prvGetSenderDeadline( pxQueue )			( ( TickType_t ) 0U )
+	#define prvGetSenderDeadlineFromISR( pxQueue )	( ( TickType_t ) 0U )
+#endif
+
 #if( configUSE_PREEMPTION == 0 )
 	/* If the cooperative scheduler is being used then a yield should not be
 	performed just because a higher priority task has been woken. */
@@ -89,6 +143,15 @@ zero. */
 	#define queueYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
+#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+	typedef struct QueueDeadlineEntry
+	{
+		TickType_t xDeadline;		/*< The absolute deadline of the item. */
+		UBaseType_t uxSequence;		/*< Orders items that have the same deadline by the time they were sent. */
+		UBaseType_t uxSlot;			/*< The index of the item's slot in the queue storage area. */
+	} QueueDeadlineEntry_t;
+#endif
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -123,6 +186,21 @@ typedef struct QueueDefinition 		/* The old naming convention is used to prevent
 		struct QueueDefinition *pxQueueSetContainer;
 	#endif
 
+	#if ( configUSE_QUEUE_LOANS == 1 )
+		int8_t *pcWriteLoan;		/*< The slot reserved by pvQueueReserveSlot(), or NULL if no slot is reserved. */
+		int8_t *pcReadLoan;			/*< The item returned by pvQueuePeekSlot(), or NULL if no item is on loan. */
+	#endif
+
+	#if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+		UBaseType_t uxOverwriteCount;	/*< The number of items discarded to make room for newer items since the queue was last reset. */
+		uint8_t ucOverwriteOldest;		/*< Set to pdTRUE if sending to the back of a full queue discards the oldest item rather than failing or blocking. */
+	#endif
+
+	#if ( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+		QueueDeadlineEntry_t *pxDeadlineHeap;	/*< The heap that orders the items of a deadline ordered queue, or NULL for a FIFO queue.  Entries past the last item hold the indexes of the free slots. */
+		UBaseType_t uxNextSequence;		/*< The sequence number to give the next item sent to a deadline ordered queue. */
+	#endif
+
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxQueueNumber;
 		uint8_t ucQueueType;
@@ -189,9 +267,10 @@ static BaseType_t prvIsQueueFull( const Queue_t *pxQueue ) PRIVILEGED_FUNCTION;
 
 /*
  * Copies an item into the queue, either at the front of the queue or the
- * back of the queue.
+ * back of the queue.  If the queue is deadline ordered the item is instead
+ * placed by xDeadline.
  */
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition, const TickType_t xDeadline ) PRIVILEGED_FUNCTION;
 
 /*
  * Copies an item out of a queue.
@@ -206,6 +285,85 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 	static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_QUEUE_LOANS == 1 )
+	/*
+	 * Called when a reserved slot is committed or cancelled, or an item on loan
+	 * is released, to unblock tasks that may have been held off by the loan.
+	 */
+	static BaseType_t prvUnblockAfterLoan( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * The implementations of xQueueGenericSend() and xQueueGenericSendFromISR(),
+ * which also take the deadline used if the queue is deadline ordered.
+ */
+static BaseType_t prvQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition, const TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+static BaseType_t prvQueueGenericSendFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition, const TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy as many of uxItemCount items as will fit into the back of a queue, or
+ * up to uxMaxItems items out of the front of a queue, in at most two memcpy()
+ * calls.  Both return the number of items copied.
+ */
+static UBaseType_t prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, UBaseType_t uxItemCount, const TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+static UBaseType_t prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, UBaseType_t uxMaxItems ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock up to uxMaxTasks tasks from a queue event list, returning pdTRUE if
+ * any of them has a priority above the calling task.
+ */
+static BaseType_t prvUnblockTasksWaitingOnQueue( List_t * const pxEventList, UBaseType_t uxMaxTasks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Notify the queue set the queue belongs to, or unblock the tasks waiting to
+ * receive from the queue, after uxItemsPosted items have been added to it.
+ */
+static BaseType_t prvUnblockAfterPost( Queue_t * const pxQueue, UBaseType_t uxItemsPosted ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add to a queue lock count from an ISR without overflowing it.
+ */
+static int8_t prvAddToLockCount( const int8_t cLockCount, UBaseType_t uxItemsMoved ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+	/*
+	 * Drop the uxCount oldest items from a queue in overwrite-oldest mode by
+	 * moving the read position past them, and add them to the overwrite count.
+	 */
+	static void prvDiscardOldestItems( Queue_t * const pxQueue, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+	/*
+	 * Copy an item into a deadline ordered queue that holds uxCount items and
+	 * add it to the heap.  If the queue is full the item is overwriting, so
+	 * the item with the latest deadline is discarded, which can be the new
+	 * item itself.  Returns the number of items discarded.
+	 */
+	static UBaseType_t prvInsertByDeadline( Queue_t * const pxQueue, UBaseType_t uxCount, const void *pvItemToQueue, const TickType_t xDeadline, const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove the entry at uxIndex from the heap of a deadline ordered queue
+	 * that holds uxCount items, freeing its slot.  uxIndex must be that of the
+	 * earliest or the latest deadline.  The caller adjusts uxMessagesWaiting.
+	 */
+	static void prvRemoveFromDeadlineHeap( Queue_t * const pxQueue, UBaseType_t uxCount, UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Store pxEntry in a heap of uxCount entries that has a hole at uxIndex,
+	 * moving the hole towards the root or the leaves until pxEntry fits.  The
+	 * hole must be at the end of the heap or where the earliest or the latest
+	 * deadline was.
+	 */
+	static void prvPlaceInDeadlineHeap( QueueDeadlineEntry_t * const pxHeap, UBaseType_t uxCount, UBaseType_t uxIndex, const QueueDeadlineEntry_t * const pxEntry ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns pdTRUE if uxIndex is on one of the levels of the heap that hold
+	 * the earliest deadline of their subtree, otherwise pdFALSE.
+	 */
+	static BaseType_t prvIsOnMinLevel( UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -267,6 +425,38 @@ Queue_t * const pxQueue = xQueue;
 		pxQueue->cRxLock = queueUNLOCKED;
 		pxQueue->cTxLock = queueUNLOCKED;
 
+		#if( configUSE_QUEUE_LOANS == 1 )
+		{
+			pxQueue->pcWriteLoan = NULL;
+			pxQueue->pcReadLoan = NULL;
+		}
+		#endif
+
+		#if( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+		{
+			pxQueue->uxOverwriteCount = ( UBaseType_t ) 0U;
+		}
+		#endif
+
+		#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+		{
+			if( pxQueue->pxDeadlineHeap != NULL )
+			{
+			UBaseType_t uxSlot;
+
+				/* The heap is empty, so every entry holds a free slot. */
+				for( uxSlot = ( UBaseType_t ) 0U; uxSlot < pxQueue->uxLength; uxSlot++ )
+				{
+					pxQueue->pxDeadlineHeap[ uxSlot ].uxSlot = uxSlot;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
 		if( xNewQueue == pdFALSE )
 		{
 			/* If there are tasks blocked waiting to read from the queue, then
@@ -419,6 +609,63 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_QUEUE_DEADLINE_ORDER == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateDeadlineOrdered( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize )
+	{
+	Queue_t *pxNewQueue;
+	size_t xQueueSizeInBytes;
+	uint8_t *pucQueueStorage;
+
+		configASSERT( uxQueueLength > ( UBaseType_t ) 0 );
+		configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+		/* The heap follows the storage area, which is padded so the heap
+		entries are aligned. */
+		xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+		if( ( xQueueSizeInBytes & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+		{
+			xQueueSizeInBytes += ( portBYTE_ALIGNMENT - ( xQueueSizeInBytes & portBYTE_ALIGNMENT_MASK ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* See the comments in xQueueGenericCreate() regarding the cast. */
+		pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes + ( ( size_t ) uxQueueLength * sizeof( QueueDeadlineEntry_t ) ) ); /*lint !e9087 !e9079 see comment above. */
+
+		if( pxNewQueue != NULL )
+		{
+			pucQueueStorage = ( uint8_t * ) pxNewQueue;
+			pucQueueStorage += sizeof( Queue_t ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxNewQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			prvInitialiseNewQueue( uxQueueLength, uxItemSize, pucQueueStorage, queueQUEUE_TYPE_BASE, pxNewQueue );
+
+			/* Reset the queue again now it has a heap so the free slots are
+			recorded in the heap. */
+			pxNewQueue->pxDeadlineHeap = ( QueueDeadlineEntry_t * ) ( pucQueueStorage + xQueueSizeInBytes ); /*lint !e9087 !e826 The storage area was padded so the heap is aligned. */
+			( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
+		}
+		else
+		{
+			traceQUEUE_CREATE_FAILED( queueQUEUE_TYPE_BASE );
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxNewQueue;
+	}
+
+#endif /* ( configUSE_QUEUE_DEADLINE_ORDER == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, uint8_t *pucQueueStorage, const uint8_t ucQueueType, Queue_t *pxNewQueue )
 {
 	/* Remove compiler warnings about unused parameters should
@@ -443,6 +690,16 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	defined. */
 	pxNewQueue->uxLength = uxQueueLength;
 	pxNewQueue->uxItemSize = uxItemSize;
+
+	#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+	{
+		/* Queues are FIFO unless created by xQueueCreateDeadlineOrdered(),
+		which adds the heap after the queue has been initialised. */
+		pxNewQueue->pxDeadlineHeap = NULL;
+		pxNewQueue->uxNextSequence = ( UBaseType_t ) 0U;
+	}
+	#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+
 	( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
 
 	#if ( configUSE_TRACE_FACILITY == 1 )
@@ -457,6 +714,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+	{
+		pxNewQueue->ucOverwriteOldest = ( uint8_t ) pdFALSE;
+	}
+	#endif /* configUSE_QUEUE_OVERWRITE_OLDEST */
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -738,6 +1001,32 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 /*-----------------------------------------------------------*/
 
 BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition )
+{
+	configASSERT( xQueue );
+
+	return prvQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition, prvGetSenderDeadline( xQueue ) );
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+
+	BaseType_t xQueueSendWithDeadline( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xDeadline, TickType_t xTicksToWait )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+
+		/* A FIFO queue would drop the deadline, so only deadline ordered
+		queues can be given one. */
+		configASSERT( pxQueue->pxDeadlineHeap != NULL );
+
+		return prvQueueGenericSend( pxQueue, pvItemToQueue, xTicksToWait, queueSEND_TO_BACK, xDeadline );
+	}
+
+#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition, const TickType_t xDeadline )
 {
 BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
 TimeOut_t xTimeOut;
@@ -764,7 +1053,7 @@ Queue_t * const pxQueue = xQueue;
 			highest priority task wanting to access the queue.  If the head item
 			in the queue is to be overwritten then it does not matter if the
 			queue is full. */
-			if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+			if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) || ( prvCanOverwriteOldest( pxQueue, xCopyPosition ) != pdFALSE ) ) && ( prvIsQueueWriteLoaned( pxQueue, xCopyPosition ) == pdFALSE ) )
 			{
 				traceQUEUE_SEND( pxQueue );
 
@@ -772,11 +1061,11 @@ Queue_t * const pxQueue = xQueue;
 				{
 				const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
 
-					xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+					xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition, xDeadline );
 
 					if( pxQueue->pxQueueSetContainer != NULL )
 					{
-						if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
+						if( pxQueue->uxMessagesWaiting == uxPreviousMessagesWaiting )
 						{
 							/* Do not notify the queue set as an existing item
 							was overwritten in the queue so the number of items
@@ -830,7 +1119,7 @@ Queue_t * const pxQueue = xQueue;
 				}
 				#else /* configUSE_QUEUE_SETS */
 				{
-					xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+					xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition, xDeadline );
 
 					/* If there was a task waiting for data to arrive on the
 					queue then unblock it now. */
@@ -905,7 +1194,9 @@ Queue_t * const pxQueue = xQueue;
 		/* Update the timeout state to see if it has expired yet. */
 		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
 		{
-			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			/* Loans are only taken and returned by tasks, so cannot change
+			while the scheduler is suspended. */
+			if( ( prvIsQueueFull( pxQueue ) != pdFALSE ) || ( prvIsQueueWriteLoaned( pxQueue, xCopyPosition ) != pdFALSE ) )
 			{
 				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
@@ -948,6 +1239,32 @@ Queue_t * const pxQueue = xQueue;
 /*-----------------------------------------------------------*/
 
 BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition )
+{
+	configASSERT( xQueue );
+
+	return prvQueueGenericSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken, xCopyPosition, prvGetSenderDeadlineFromISR( xQueue ) );
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+
+	BaseType_t xQueueSendWithDeadlineFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xDeadline, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+
+		/* A FIFO queue would drop the deadline, so only deadline ordered
+		queues can be given one. */
+		configASSERT( pxQueue->pxDeadlineHeap != NULL );
+
+		return prvQueueGenericSendFromISR( pxQueue, pvItemToQueue, pxHigherPriorityTaskWoken, queueSEND_TO_BACK, xDeadline );
+	}
+
+#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueGenericSendFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition, const TickType_t xDeadline )
 {
 BaseType_t xReturn;
 UBaseType_t uxSavedInterruptStatus;
@@ -980,7 +1297,7 @@ Queue_t * const pxQueue = xQueue;
 	post). */
 	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
-		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+		if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) || ( prvCanOverwriteOldest( pxQueue, xCopyPosition ) != pdFALSE ) ) && ( prvIsQueueWriteLoaned( pxQueue, xCopyPosition ) == pdFALSE ) )
 		{
 			const int8_t cTxLock = pxQueue->cTxLock;
 			const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -992,7 +1309,7 @@ Queue_t * const pxQueue = xQueue;
 			in a task disinheriting a priority and prvCopyDataToQueue() can be
 			called here even though the disinherit function does not check if
 			the scheduler is suspended before accessing the ready lists. */
-			( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+			( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition, xDeadline );
 
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
@@ -1002,7 +1319,7 @@ Queue_t * const pxQueue = xQueue;
 				{
 					if( pxQueue->pxQueueSetContainer != NULL )
 					{
-						if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
+						if( pxQueue->uxMessagesWaiting == uxPreviousMessagesWaiting )
 						{
 							/* Do not notify the queue set as an existing item
 							was overwritten in the queue so the number of items
@@ -1306,11 +1623,25 @@ Queue_t * const pxQueue = xQueue;
 
 			/* Is there data in the queue now?  To be running the calling task
 			must be the highest priority task wanting to access the queue. */
-			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( prvIsQueueReadLoaned( pxQueue ) == pdFALSE ) )
 			{
 				/* Data available, remove one item. */
 				prvCopyDataFromQueue( pxQueue, pvBuffer );
 				traceQUEUE_RECEIVE( pxQueue );
+
+				#if ( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+				{
+					if( pxQueue->pxDeadlineHeap != NULL )
+					{
+						prvRemoveFromDeadlineHeap( pxQueue, uxMessagesWaiting, ( UBaseType_t ) 0U );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+
 				pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
 
 				/* There is now space in the queue, were any tasks waiting to
@@ -1812,13 +2143,27 @@ Queue_t * const pxQueue = xQueue;
 		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
 		/* Cannot block in an ISR, so check there is data available. */
-		if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+		if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( prvIsQueueReadLoaned( pxQueue ) == pdFALSE ) )
 		{
 			const int8_t cRxLock = pxQueue->cRxLock;
 
 			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
 
 			prvCopyDataFromQueue( pxQueue, pvBuffer );
+
+			#if ( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+			{
+				if( pxQueue->pxDeadlineHeap != NULL )
+				{
+					prvRemoveFromDeadlineHeap( pxQueue, uxMessagesWaiting, ( UBaseType_t ) 0U );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+
 			pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
 
 			/* If the queue is locked the event list will not be modified.
@@ -1927,71 +2272,1473 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-UBaseType_t uxReturn;
-
-	configASSERT( xQueue );
-
-	taskENTER_CRITICAL();
-	{
-		uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-	}
-	taskEXIT_CRITICAL();
-
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, UBaseType_t uxItemCount, TickType_t xTicksToWait )
 {
-UBaseType_t uxReturn;
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+UBaseType_t uxCopied;
 Queue_t * const pxQueue = xQueue;
 
 	configASSERT( pxQueue );
-
-	taskENTER_CRITICAL();
+	configASSERT( pvItems != NULL );
+	configASSERT( uxItemCount > ( UBaseType_t ) 0U );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Use xSemaphoreGive() for semaphores. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
 	{
-		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
 	}
-	taskEXIT_CRITICAL();
-
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-UBaseType_t uxReturn;
-Queue_t * const pxQueue = xQueue;
-
-	configASSERT( pxQueue );
-	uxReturn = pxQueue->uxMessagesWaiting;
+	#endif
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+	/*lint -save -e904 This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Is there room for at least one item?  As many items as fit are
+			posted, so a partial send is not an error. */
+			if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( prvCanOverwriteOldest( pxQueue, queueSEND_TO_BACK ) != pdFALSE ) ) && ( prvIsQueueWriteLoaned( pxQueue, queueSEND_TO_BACK ) == pdFALSE ) )
+			{
+			const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
 
-void vQueueDelete( QueueHandle_t xQueue )
-{
-Queue_t * const pxQueue = xQueue;
+				traceQUEUE_SEND( pxQueue );
 
-	configASSERT( pxQueue );
-	traceQUEUE_DELETE( pxQueue );
+				uxCopied = prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItems, uxItemCount, prvGetSenderDeadline( pxQueue ) );
 
-	#if ( configQUEUE_REGISTRY_SIZE > 0 )
-	{
-		vQueueUnregisterQueue( pxQueue );
-	}
-	#endif
+				/* Only items that increased the number in the queue can
+				satisfy a waiting receiver. */
+				if( prvUnblockAfterPost( pxQueue, pxQueue->uxMessagesWaiting - uxPreviousMessagesWaiting ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 
-	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-	{
-		/* The queue can only have been allocated dynamically - free it
-		again. */
-		vPortFree( pxQueue );
-	}
-	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+				taskEXIT_CRITICAL();
+				return ( BaseType_t ) uxCopied;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					taskEXIT_CRITICAL();
+					traceQUEUE_SEND_FAILED( pxQueue );
+					return 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* The timeout has expired. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			traceQUEUE_SEND_FAILED( pxQueue );
+			return 0;
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxCopied = 0;
+UBaseType_t uxSavedInterruptStatus;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItems != NULL );
+	configASSERT( uxItemCount > ( UBaseType_t ) 0U );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	/* See the comments in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( prvCanOverwriteOldest( pxQueue, queueSEND_TO_BACK ) != pdFALSE ) ) && ( prvIsQueueWriteLoaned( pxQueue, queueSEND_TO_BACK ) == pdFALSE ) )
+		{
+			const int8_t cTxLock = pxQueue->cTxLock;
+			const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
+			UBaseType_t uxAdded;
+
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+			uxCopied = prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItems, uxItemCount, prvGetSenderDeadlineFromISR( pxQueue ) );
+			uxAdded = pxQueue->uxMessagesWaiting - uxPreviousMessagesWaiting;
+
+			/* The event list is not altered if the queue is locked.  Instead
+			the lock count records how many tasks may need unblocking when the
+			queue is unlocked. */
+			if( cTxLock == queueUNLOCKED )
+			{
+				if( prvUnblockAfterPost( pxQueue, uxAdded ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxQueue->cTxLock = prvAddToLockCount( cTxLock, uxAdded );
+			}
+		}
+		else
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return ( BaseType_t ) uxCopied;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+UBaseType_t uxCopied;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer != NULL );
+	configASSERT( uxMaxItems > ( UBaseType_t ) 0U );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Use xSemaphoreTake() for semaphores. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	/*lint -save -e904  This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( prvIsQueueReadLoaned( pxQueue ) == pdFALSE ) )
+			{
+				uxCopied = prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxMaxItems );
+				traceQUEUE_RECEIVE( pxQueue );
+
+				/* There is now space in the queue for up to uxCopied of the
+				tasks waiting to post to it. */
+				if( prvUnblockTasksWaitingOnQueue( &( pxQueue->xTasksWaitingToSend ), uxCopied ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskEXIT_CRITICAL();
+				return ( BaseType_t ) uxCopied;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The queue contains data again.  Loop back to try and read
+				the data. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxCopied = 0;
+UBaseType_t uxSavedInterruptStatus;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer != NULL );
+	configASSERT( uxMaxItems > ( UBaseType_t ) 0U );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	/* See the comments in xQueueReceiveFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( prvIsQueueReadLoaned( pxQueue ) == pdFALSE ) )
+		{
+			const int8_t cRxLock = pxQueue->cRxLock;
+
+			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+			uxCopied = prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxMaxItems );
+
+			if( cRxLock == queueUNLOCKED )
+			{
+				if( prvUnblockTasksWaitingOnQueue( &( pxQueue->xTasksWaitingToSend ), uxCopied ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxQueue->cRxLock = prvAddToLockCount( cRxLock, uxCopied );
+			}
+		}
+		else
+		{
+			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return ( BaseType_t ) uxCopied;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, UBaseType_t uxItemCount, const TickType_t xDeadline )
+{
+UBaseType_t uxToCopy, uxFirstRun, uxSkipped = 0;
+
+	/* This function is called from a critical section.  Items are copied in
+	at most two runs, one up to the end of the storage area and one from the
+	start. */
+	uxToCopy = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+	#if ( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+	{
+		if( pxQueue->pxDeadlineHeap != NULL )
+		{
+		UBaseType_t uxItem;
+
+			/* Each item has its own slot and heap entry, so they are added
+			one at a time.  All share the deadline, so they are received in
+			the order they appear in the batch. */
+			if( prvCanOverwriteOldest( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+			{
+				uxToCopy = uxItemCount;
+			}
+			else if( uxItemCount < uxToCopy )
+			{
+				uxToCopy = uxItemCount;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			for( uxItem = ( UBaseType_t ) 0U; uxItem < uxToCopy; uxItem++ )
+			{
+				pxQueue->uxMessagesWaiting -= prvInsertByDeadline( pxQueue, pxQueue->uxMessagesWaiting, ( const void * ) ( pcItems + ( uxItem * pxQueue->uxItemSize ) ), xDeadline, queueSEND_TO_BACK ); /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+				pxQueue->uxMessagesWaiting++;
+			}
+
+			return uxToCopy;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		( void ) xDeadline;
+	}
+	#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+
+	#if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+	{
+		if( ( uxItemCount > uxToCopy ) && ( prvCanOverwriteOldest( pxQueue, queueSEND_TO_BACK ) != pdFALSE ) )
+		{
+			/* Everything is accepted, but only the newest uxLength items can
+			be kept.  Items that would be overwritten by later items in the
+			same batch are skipped, then as many of the oldest queued items
+			as necessary are discarded. */
+			if( uxItemCount > pxQueue->uxLength )
+			{
+				uxSkipped = uxItemCount - pxQueue->uxLength;
+				pxQueue->uxOverwriteCount += uxSkipped;
+				pcItems += uxSkipped * pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+				uxItemCount = pxQueue->uxLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvDiscardOldestItems( pxQueue, uxItemCount - uxToCopy );
+			pxQueue->uxMessagesWaiting -= uxItemCount - uxToCopy;
+			uxToCopy = uxItemCount;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_QUEUE_OVERWRITE_OLDEST */
+
+	if( uxItemCount < uxToCopy )
+	{
+		uxToCopy = uxItemCount;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	uxFirstRun = ( UBaseType_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ) / pxQueue->uxItemSize;
+
+	if( uxFirstRun > uxToCopy )
+	{
+		uxFirstRun = uxToCopy;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, ( size_t ) ( uxFirstRun * pxQueue->uxItemSize ) ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+	pxQueue->pcWriteTo += uxFirstRun * pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+	if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+	{
+		pxQueue->pcWriteTo = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( uxToCopy > uxFirstRun )
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) ( pcItems + ( uxFirstRun * pxQueue->uxItemSize ) ), ( size_t ) ( ( uxToCopy - uxFirstRun ) * pxQueue->uxItemSize ) ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+		pxQueue->pcWriteTo += ( uxToCopy - uxFirstRun ) * pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxQueue->uxMessagesWaiting += uxToCopy;
+
+	return uxToCopy + uxSkipped;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, UBaseType_t uxMaxItems )
+{
+UBaseType_t uxToCopy, uxFirstRun;
+int8_t *pcReadFrom;
+
+	/* This function is called from a critical section.  pcReadFrom points to
+	the last item read, so the first item to copy follows it. */
+	uxToCopy = pxQueue->uxMessagesWaiting;
+
+	if( uxMaxItems < uxToCopy )
+	{
+		uxToCopy = uxMaxItems;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	#if ( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+	{
+		if( pxQueue->pxDeadlineHeap != NULL )
+		{
+		UBaseType_t uxItem;
+
+			/* Take the earliest deadline item uxToCopy times, so the buffer is
+			filled in deadline order. */
+			for( uxItem = ( UBaseType_t ) 0U; uxItem < uxToCopy; uxItem++ )
+			{
+				prvCopyDataFromQueue( pxQueue, ( void * ) ( pcBuffer + ( uxItem * pxQueue->uxItemSize ) ) ); /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+				prvRemoveFromDeadlineHeap( pxQueue, pxQueue->uxMessagesWaiting, ( UBaseType_t ) 0U );
+				pxQueue->uxMessagesWaiting--;
+			}
+
+			return uxToCopy;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+
+	pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+	if( pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+	{
+		pcReadFrom = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	uxFirstRun = ( UBaseType_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom ) / pxQueue->uxItemSize;
+
+	if( uxFirstRun > uxToCopy )
+	{
+		uxFirstRun = uxToCopy;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( void ) memcpy( ( void * ) pcBuffer, ( void * ) pcReadFrom, ( size_t ) ( uxFirstRun * pxQueue->uxItemSize ) ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+	pcReadFrom += ( uxFirstRun - ( UBaseType_t ) 1 ) * pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+	if( uxToCopy > uxFirstRun )
+	{
+		( void ) memcpy( ( void * ) ( pcBuffer + ( uxFirstRun * pxQueue->uxItemSize ) ), ( void * ) pxQueue->pcHead, ( size_t ) ( ( uxToCopy - uxFirstRun ) * pxQueue->uxItemSize ) ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+		pcReadFrom = pxQueue->pcHead + ( ( uxToCopy - uxFirstRun - ( UBaseType_t ) 1 ) * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Leave pcReadFrom pointing at the last item copied out. */
+	pxQueue->u.xQueue.pcReadFrom = pcReadFrom;
+	pxQueue->uxMessagesWaiting -= uxToCopy;
+
+	return uxToCopy;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockAfterPost( Queue_t * const pxQueue, UBaseType_t uxItemsPosted )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	/* This function is called from a critical section with the queue
+	unlocked. */
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		if( pxQueue->pxQueueSetContainer != NULL )
+		{
+			/* The queue set holds one entry per item posted. */
+			while( uxItemsPosted > ( UBaseType_t ) 0 )
+			{
+				if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+				{
+					xHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				uxItemsPosted--;
+			}
+		}
+		else
+		{
+			xHigherPriorityTaskWoken = prvUnblockTasksWaitingOnQueue( &( pxQueue->xTasksWaitingToReceive ), uxItemsPosted );
+		}
+	}
+	#else /* configUSE_QUEUE_SETS */
+	{
+		xHigherPriorityTaskWoken = prvUnblockTasksWaitingOnQueue( &( pxQueue->xTasksWaitingToReceive ), uxItemsPosted );
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockTasksWaitingOnQueue( List_t * const pxEventList, UBaseType_t uxMaxTasks )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	/* Each item moved can satisfy one waiting task, so unblock up to that
+	many in priority order.  With a single waiting task, as is usual, this is
+	one wake-up regardless of the number of items moved. */
+	while( ( uxMaxTasks > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+	{
+		if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxMaxTasks--;
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static int8_t prvAddToLockCount( const int8_t cLockCount, UBaseType_t uxItemsMoved )
+{
+UBaseType_t uxNewCount;
+
+	/* The lock counts are int8_t, so saturate rather than wrap.  Any count
+	above the number of tasks waiting has the same effect when the queue is
+	unlocked. */
+	uxNewCount = ( UBaseType_t ) cLockCount + uxItemsMoved;
+
+	if( uxNewCount > ( UBaseType_t ) queueMAX_LOCK_COUNT )
+	{
+		uxNewCount = ( UBaseType_t ) queueMAX_LOCK_COUNT;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return ( int8_t ) uxNewCount;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+
+	static void prvDiscardOldestItems( Queue_t * const pxQueue, UBaseType_t uxCount )
+	{
+		/* This function is called from a critical section.  The caller
+		adjusts uxMessagesWaiting. */
+		pxQueue->u.xQueue.pcReadFrom += uxCount * pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+		if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+		{
+			pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxLength * pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxQueue->uxOverwriteCount += uxCount;
+	}
+
+#endif /* configUSE_QUEUE_OVERWRITE_OLDEST */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+
+	void vQueueSetOverwriteOldest( QueueHandle_t xQueue, BaseType_t xOverwriteOldest )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores cannot be used in this mode. */
+
+		taskENTER_CRITICAL();
+		{
+			pxQueue->ucOverwriteOldest = ( uint8_t ) ( ( xOverwriteOldest != pdFALSE ) ? pdTRUE : pdFALSE );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_OVERWRITE_OLDEST */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+
+	UBaseType_t uxQueueGetOverwriteCount( const QueueHandle_t xQueue )
+	{
+	UBaseType_t uxReturn;
+
+		configASSERT( xQueue );
+
+		taskENTER_CRITICAL();
+		{
+			uxReturn = ( ( Queue_t * ) xQueue )->uxOverwriteCount;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_QUEUE_OVERWRITE_OLDEST */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+
+	static UBaseType_t prvInsertByDeadline( Queue_t * const pxQueue, UBaseType_t uxCount, const void *pvItemToQueue, const TickType_t xDeadline, const BaseType_t xPosition )
+	{
+	QueueDeadlineEntry_t * const pxHeap = pxQueue->pxDeadlineHeap;
+	QueueDeadlineEntry_t xNewEntry;
+	UBaseType_t uxLatest, uxDiscarded = ( UBaseType_t ) 0U;
+
+		/* This function is called from a critical section. */
+		xNewEntry.xDeadline = xDeadline;
+		xNewEntry.uxSequence = pxQueue->uxNextSequence;
+		pxQueue->uxNextSequence++;
+
+		if( uxCount == pxQueue->uxLength )
+		{
+			/* Only possible when overwriting.  The latest deadline is held by
+			one of the children of the root, or by the root if it has none. */
+			if( uxCount == ( UBaseType_t ) 1U )
+			{
+				uxLatest = ( UBaseType_t ) 0U;
+			}
+			else if( ( uxCount == ( UBaseType_t ) 2U ) || ( prvIsEarlierDeadline( &( pxHeap[ 2 ] ), &( pxHeap[ 1 ] ) ) ) )
+			{
+				uxLatest = ( UBaseType_t ) 1U;
+			}
+			else
+			{
+				uxLatest = ( UBaseType_t ) 2U;
+			}
+
+			if( ( xPosition == queueOVERWRITE ) || ( prvIsEarlierDeadline( &xNewEntry, &( pxHeap[ uxLatest ] ) ) ) )
+			{
+				prvRemoveFromDeadlineHeap( pxQueue, uxCount, uxLatest );
+				uxCount--;
+			}
+			else
+			{
+				/* The new item is the least urgent, so is the one dropped. */
+				pvItemToQueue = NULL;
+			}
+
+			#if( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+			{
+				if( xPosition != queueOVERWRITE )
+				{
+					pxQueue->uxOverwriteCount++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_QUEUE_OVERWRITE_OLDEST */
+
+			uxDiscarded = ( UBaseType_t ) 1U;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pvItemToQueue != NULL )
+		{
+			/* The entry just past the end of the heap holds a free slot. */
+			xNewEntry.uxSlot = pxHeap[ uxCount ].uxSlot;
+
+			#if( configUSE_QUEUE_LOANS == 1 )
+			{
+				if( prvIsQueueReadLoaned( pxQueue ) != pdFALSE )
+				{
+					/* The item on loan has left the heap but is still counted,
+					and its slot is recorded in the entry the new item is about
+					to take, so that record moves along one.  The queue cannot
+					be full here as items are not overwritten during a loan. */
+					uxCount--;
+					pxHeap[ uxCount + ( UBaseType_t ) 1U ].uxSlot = pxHeap[ uxCount ].uxSlot;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_QUEUE_LOANS */
+
+			( void ) memcpy( ( void * ) ( pxQueue->pcHead + ( xNewEntry.uxSlot * pxQueue->uxItemSize ) ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 !e9016 MISRA exception as the casts are only redundant for some ports. */
+			prvPlaceInDeadlineHeap( pxHeap, uxCount + ( UBaseType_t ) 1U, uxCount, &xNewEntry );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxDiscarded;
+	}
+
+#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+
+	static void prvRemoveFromDeadlineHeap( Queue_t * const pxQueue, UBaseType_t uxCount, UBaseType_t uxIndex )
+	{
+	QueueDeadlineEntry_t * const pxHeap = pxQueue->pxDeadlineHeap;
+	QueueDeadlineEntry_t xLastEntry;
+	UBaseType_t uxFreedSlot;
+
+		/* This function is called from a critical section. */
+		uxFreedSlot = pxHeap[ uxIndex ].uxSlot;
+		uxCount--;
+
+		if( uxIndex < uxCount )
+		{
+			/* Fill the hole with the last entry, which then moves to wherever
+			its deadline puts it. */
+			xLastEntry = pxHeap[ uxCount ];
+			prvPlaceInDeadlineHeap( pxHeap, uxCount, uxIndex, &xLastEntry );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* The entry that dropped off the end of the heap records the freed
+		slot. */
+		pxHeap[ uxCount ].uxSlot = uxFreedSlot;
+	}
+
+#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+
+	static void prvPlaceInDeadlineHeap( QueueDeadlineEntry_t * const pxHeap, UBaseType_t uxCount, UBaseType_t uxIndex, const QueueDeadlineEntry_t * const pxEntry )
+	{
+	QueueDeadlineEntry_t xEntry = *pxEntry, xDisplaced;
+	UBaseType_t uxParent, uxChild, uxNext, uxGrandchild;
+	const UBaseType_t uxHole = uxIndex;
+	BaseType_t xMinLevel = prvIsOnMinLevel( uxIndex );
+
+		/* Towards the root.  The parent decides whether the entry belongs on
+		the min or the max levels above it, after which it only passes
+		grandparents, which are on the same kind of level. */
+		if( uxIndex > ( UBaseType_t ) 0U )
+		{
+			uxParent = ( uxIndex - ( UBaseType_t ) 1U ) >> 1;
+
+			if( prvIsAboveInHeap( xMinLevel, &( pxHeap[ uxParent ] ), &xEntry ) )
+			{
+				pxHeap[ uxIndex ] = pxHeap[ uxParent ];
+				uxIndex = uxParent;
+				xMinLevel = ( xMinLevel != pdFALSE ) ? pdFALSE : pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			while( uxIndex > ( UBaseType_t ) 2U )
+			{
+				uxParent = ( ( ( uxIndex - ( UBaseType_t ) 1U ) >> 1 ) - ( UBaseType_t ) 1U ) >> 1;
+
+				if( prvIsAboveInHeap( xMinLevel, &xEntry, &( pxHeap[ uxParent ] ) ) )
+				{
+					pxHeap[ uxIndex ] = pxHeap[ uxParent ];
+					uxIndex = uxParent;
+				}
+				else
+				{
+					break;
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Then towards the leaves, past whichever child or grandchild belongs
+		highest on this kind of level.  This only happens if the entry did not
+		move towards the root. */
+		if( uxIndex == uxHole )
+		{
+			for( ;; )
+			{
+				uxChild = ( uxIndex << 1 ) + ( UBaseType_t ) 1U;
+
+				if( uxChild >= uxCount )
+				{
+					break;
+				}
+
+				uxNext = uxChild;
+
+				if( ( ( uxChild + ( UBaseType_t ) 1U ) < uxCount ) && ( prvIsAboveInHeap( xMinLevel, &( pxHeap[ uxChild + ( UBaseType_t ) 1U ] ), &( pxHeap[ uxNext ] ) ) ) )
+				{
+					uxNext = uxChild + ( UBaseType_t ) 1U;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				for( uxGrandchild = ( uxChild << 1 ) + ( UBaseType_t ) 1U; ( uxGrandchild < uxCount ) && ( uxGrandchild <= ( uxChild << 1 ) + ( UBaseType_t ) 4U ); uxGrandchild++ )
+				{
+					if( prvIsAboveInHeap( xMinLevel, &( pxHeap[ uxGrandchild ] ), &( pxHeap[ uxNext ] ) ) )
+					{
+						uxNext = uxGrandchild;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				if( prvIsAboveInHeap( xMinLevel, &( pxHeap[ uxNext ] ), &xEntry ) )
+				{
+					pxHeap[ uxIndex ] = pxHeap[ uxNext ];
+					uxIndex = uxNext;
+				}
+				else
+				{
+					break;
+				}
+
+				if( uxIndex > ( uxChild + ( UBaseType_t ) 1U ) )
+				{
+					/* A grandchild moved up and the hole is now where it was,
+					on the same kind of level.  If the entry belongs on the
+					level between it swaps with the hole's parent. */
+					uxParent = ( uxIndex - ( UBaseType_t ) 1U ) >> 1;
+
+					if( prvIsAboveInHeap( xMinLevel, &( pxHeap[ uxParent ] ), &xEntry ) )
+					{
+						xDisplaced = pxHeap[ uxParent ];
+						pxHeap[ uxParent ] = xEntry;
+						xEntry = xDisplaced;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* A child moved up.  A child that belongs above all the
+					grandchildren on this kind of level has no children, so
+					the hole is at a leaf. */
+					break;
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxHeap[ uxIndex ] = xEntry;
+	}
+
+#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+
+	static BaseType_t prvIsOnMinLevel( UBaseType_t uxIndex )
+	{
+	BaseType_t xMinLevel = pdTRUE;
+
+		/* Level n of the heap holds the indexes from 2^n - 1 to 2^(n+1) - 2. */
+		for( uxIndex++; uxIndex > ( UBaseType_t ) 1U; uxIndex >>= 1 )
+		{
+			xMinLevel = ( xMinLevel != pdFALSE ) ? pdFALSE : pdTRUE;
+		}
+
+		return xMinLevel;
+	}
+
+#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_LOANS == 1 )
+
+	void *pvQueueReserveSlot( QueueHandle_t xQueue, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	Queue_t * const pxQueue = xQueue;
+	void *pvReturn;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores have no storage to loan. */
+		#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+		{
+			/* A reserved slot relies on the FIFO write position. */
+			configASSERT( pxQueue->pxDeadlineHeap == NULL );
+		}
+		#endif
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/*lint -save -e904 This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Is there a free slot that is not already reserved? */
+				if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( prvIsQueueWriteLoaned( pxQueue, queueSEND_TO_BACK ) == pdFALSE ) )
+				{
+					traceQUEUE_SEND( pxQueue );
+
+					/* The slot is not added to the queue until it is committed,
+					so pcWriteTo is left pointing at it. */
+					pxQueue->pcWriteLoan = pxQueue->pcWriteTo;
+					pvReturn = ( void * ) pxQueue->pcWriteLoan;
+
+					taskEXIT_CRITICAL();
+					return pvReturn;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						taskEXIT_CRITICAL();
+						traceQUEUE_SEND_FAILED( pxQueue );
+						return NULL;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueFull( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* The timeout has expired. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				traceQUEUE_SEND_FAILED( pxQueue );
+				return NULL;
+			}
+		} /*lint -restore */
+	}
+
+#endif /* configUSE_QUEUE_LOANS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_LOANS == 1 )
+
+	void vQueueCommitSlot( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			configASSERT( pxQueue->pcWriteLoan == pxQueue->pcWriteTo );
+
+			/* The item is already in place, so only the write position and
+			count need updating. */
+			pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+			if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+			{
+				pxQueue->pcWriteTo = pxQueue->pcHead;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxQueue->uxMessagesWaiting++;
+			pxQueue->pcWriteLoan = NULL;
+
+			#if ( configUSE_QUEUE_SETS == 1 )
+			{
+				if( pxQueue->pxQueueSetContainer != NULL )
+				{
+					if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+					{
+						queueYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_QUEUE_SETS */
+
+			if( prvUnblockAfterLoan( pxQueue ) != pdFALSE )
+			{
+				queueYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_LOANS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_LOANS == 1 )
+
+	void vQueueCancelSlot( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			configASSERT( pxQueue->pcWriteLoan != NULL );
+			pxQueue->pcWriteLoan = NULL;
+
+			if( prvUnblockAfterLoan( pxQueue ) != pdFALSE )
+			{
+				queueYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_LOANS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_LOANS == 1 )
+
+	const void *pvQueuePeekSlot( QueueHandle_t xQueue, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	Queue_t * const pxQueue = xQueue;
+	int8_t *pcSlot;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores have no storage to loan. */
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/*lint -save -e904  This function relaxes the coding standard somewhat
+		to allow return statements within the function itself.  This is done in
+		the interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( prvIsQueueReadLoaned( pxQueue ) == pdFALSE ) )
+				{
+					traceQUEUE_PEEK( pxQueue );
+
+					#if( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+					if( pxQueue->pxDeadlineHeap != NULL )
+					{
+						/* The item with the earliest deadline leaves the heap
+						now, so items sent during the loan cannot get ahead of
+						it, but keeps its slot and stays counted until the loan
+						is released.  The slot is recorded in the entry just
+						past the end of the heap. */
+						pcSlot = pxQueue->pcHead + ( pxQueue->pxDeadlineHeap[ 0 ].uxSlot * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+						prvRemoveFromDeadlineHeap( pxQueue, pxQueue->uxMessagesWaiting, ( UBaseType_t ) 0U );
+					}
+					else
+					#endif /* configUSE_QUEUE_DEADLINE_ORDER */
+					{
+						/* The item stays in the queue, and pcReadFrom is not
+						moved, until the loan is released. */
+						pcSlot = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+						if( pcSlot >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+						{
+							pcSlot = pxQueue->pcHead;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+
+					pxQueue->pcReadLoan = pcSlot;
+
+					taskEXIT_CRITICAL();
+					return ( const void * ) pcSlot;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						taskEXIT_CRITICAL();
+						traceQUEUE_PEEK_FAILED( pxQueue );
+						return NULL;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceQUEUE_PEEK_FAILED( pxQueue );
+					return NULL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		} /*lint -restore */
+	}
+
+#endif /* configUSE_QUEUE_LOANS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_LOANS == 1 )
+
+	void vQueueReleaseSlot( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			configASSERT( pxQueue->pcReadLoan != NULL );
+
+			/* Remove the item exactly as prvCopyDataFromQueue() would have,
+			but without the copy.  In a deadline ordered queue the entry just
+			past the end of the heap, which holds the item's slot, then becomes
+			the first free entry. */
+			traceQUEUE_RECEIVE( pxQueue );
+			pxQueue->u.xQueue.pcReadFrom = pxQueue->pcReadLoan;
+			pxQueue->uxMessagesWaiting--;
+			pxQueue->pcReadLoan = NULL;
+
+			if( prvUnblockAfterLoan( pxQueue ) != pdFALSE )
+			{
+				queueYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_LOANS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_LOANS == 1 )
+
+	static BaseType_t prvUnblockAfterLoan( Queue_t * const pxQueue )
+	{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		/* Called from a critical section once a loan has ended.  Tasks may
+		have blocked because of the loan rather than because the queue was
+		full or empty, so one task on each side is given the chance to run if
+		the queue can now service it. */
+		if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( prvIsQueueReadLoaned( pxQueue ) == pdFALSE ) )
+		{
+			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+			{
+				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+				{
+					xHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( pxQueue->pcWriteLoan == NULL ) )
+		{
+			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+			{
+				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+				{
+					xHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xHigherPriorityTaskWoken;
+	}
+
+#endif /* configUSE_QUEUE_LOANS */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+
+	configASSERT( xQueue );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	uxReturn = pxQueue->uxMessagesWaiting;
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	traceQUEUE_DELETE( pxQueue );
+
+	#if ( configQUEUE_REGISTRY_SIZE > 0 )
+	{
+		vQueueUnregisterQueue( pxQueue );
+	}
+	#endif
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		/* The queue can only have been allocated dynamically - free it
+		again. */
+		vPortFree( pxQueue );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 	{
 		/* The queue could have been allocated statically or dynamically, so
 		check before attempting to free the memory. */
@@ -2071,7 +3818,7 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition, const TickType_t xDeadline )
 {
 BaseType_t xReturn = pdFALSE;
 UBaseType_t uxMessagesWaiting;
@@ -2097,8 +3844,33 @@ UBaseType_t uxMessagesWaiting;
 		}
 		#endif /* configUSE_MUTEXES */
 	}
+	#if ( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+	else if( pxQueue->pxDeadlineHeap != NULL )
+	{
+		/* The position is ignored as items are ordered by deadline.  One
+		item is discarded if the queue is full, so the count is unchanged. */
+		uxMessagesWaiting -= prvInsertByDeadline( pxQueue, uxMessagesWaiting, pvItemToQueue, xDeadline, xPosition );
+	}
+	#endif /* configUSE_QUEUE_DEADLINE_ORDER */
 	else if( xPosition == queueSEND_TO_BACK )
 	{
+		#if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+		{
+			if( uxMessagesWaiting == pxQueue->uxLength )
+			{
+				/* Only possible in overwrite-oldest mode.  The write position
+				has caught up with the oldest item, which is discarded so the
+				new item can take its place. */
+				prvDiscardOldestItems( pxQueue, ( UBaseType_t ) 1 );
+				--uxMessagesWaiting;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_QUEUE_OVERWRITE_OLDEST */
+
 		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
 		pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 		if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
@@ -2146,6 +3918,12 @@ UBaseType_t uxMessagesWaiting;
 
 	pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
 
+	#if ( configUSE_QUEUE_DEADLINE_ORDER == 0 )
+	{
+		( void ) xDeadline;
+	}
+	#endif
+
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
@@ -2154,15 +3932,38 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 {
 	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
 	{
-		pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
-		if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+		#if ( configUSE_QUEUE_DEADLINE_ORDER == 1 )
+		if( pxQueue->pxDeadlineHeap != NULL )
 		{
-			pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+			/* The item with the earliest deadline is at the root of the heap.
+			It is left in the heap as receivers remove it but peeks do not.
+			Only peeks get here during a loan, and the item on loan, which has
+			already left the heap, is still the front of the queue. */
+			#if( configUSE_QUEUE_LOANS == 1 )
+			if( prvIsQueueReadLoaned( pxQueue ) != pdFALSE )
+			{
+				pxQueue->u.xQueue.pcReadFrom = pxQueue->pcReadLoan;
+			}
+			else
+			#endif /* configUSE_QUEUE_LOANS */
+			{
+				pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( pxQueue->pxDeadlineHeap[ 0 ].uxSlot * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+			}
 		}
 		else
+		#endif /* configUSE_QUEUE_DEADLINE_ORDER */
 		{
-			mtCOVERAGE_TEST_MARKER();
+			pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+			if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+			{
+				pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
+
 		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
 	}
 }
@@ -2294,7 +4095,7 @@ BaseType_t xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == ( UBaseType_t )  0 )
+		if( ( pxQueue->uxMessagesWaiting == ( UBaseType_t )  0 ) || ( prvIsQueueReadLoaned( pxQueue ) != pdFALSE ) )
 		{
 			xReturn = pdTRUE;
 		}
@@ -2334,7 +4135,7 @@ BaseType_t xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+		if( ( pxQueue->uxMessagesWaiting == pxQueue->uxLength ) || ( prvIsQueueWriteLoaned( pxQueue, queueSEND_TO_BACK ) != pdFALSE ) )
 		{
 			xReturn = pdTRUE;
 		}
@@ -2406,7 +4207,7 @@ Queue_t * const pxQueue = xQueue;
 			if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
 			{
 				/* There is room in the queue, copy the data into the queue. */
-				prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
+				prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK, ( TickType_t ) 0U );
 				xReturn = pdPASS;
 
 				/* Were any co-routines waiting for data to become available? */
@@ -2545,7 +4346,7 @@ Queue_t * const pxQueue = xQueue;
 		exit without doing anything. */
 		if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
 		{
-			prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
+			prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK, ( TickType_t ) 0U );
 
 			/* We only want to wake one co-routine per ISR, so check that a
 			co-routine has not already been woken. */
@@ -2896,7 +4697,7 @@ Queue_t * const pxQueue = xQueue;
 			traceQUEUE_SEND( pxQueueSetContainer );
 
 			/* The data copied is the handle of the queue that contains data. */
-			xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+			xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK, ( TickType_t ) 0U );
 
 			if( cTxLock == queueUNLOCKED )
 			{
@@ -83,12 +83,46 @@ functions but without including stdio.h here. */
 /* If any of the following are set then task stacks are filled with a known
 value so the high water mark can be determined.  If none of the following are
 set then don't fill the stack so there is no unnecessary dependency on memset. */
-#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) || ( configUSE_STACK_PROFILER == 1 ) )
 	#define tskSET_NEW_STACKS_TO_KNOWN_VALUE	1
 #else
 	#define tskSET_NEW_STACKS_TO_KNOWN_VALUE	0
 #endif
 
+#if ( configUSE_STACK_PROFILER == 1 )
+	/* A whole stack word of tskSTACK_FILL_BYTE, so the stack profiler can check
+	a word at a time. */
+	#define tskSTACK_FILL_WORD	( ( StackType_t ) ( ( ( StackType_t ) ~( StackType_t ) 0U / ( StackType_t ) 0xffU ) * ( StackType_t ) tskSTACK_FILL_BYTE ) )
+
+	/* The stack word uxIndex words in from the end of the stack that is used
+	last. */
+	#if( portSTACK_GROWTH < 0 )
+		#define taskSTACK_WORD( pxTCB, uxIndex )	( ( pxTCB )->pxStack[ ( uxIndex ) ] )
+	#else
+		#define taskSTACK_WORD( pxTCB, uxIndex )	( *( ( pxTCB )->pxEndOfStack - ( uxIndex ) ) )
+	#endif
+
+	/* Recommended stack sizes are rounded up to keep the top of the stack
+	aligned. */
+	#define taskSTACK_ALIGNMENT_WORDS	( ( configSTACK_DEPTH_TYPE ) ( ( ( size_t ) portBYTE_ALIGNMENT + sizeof( StackType_t ) - ( size_t ) 1U ) / sizeof( StackType_t ) ) )
+#endif
+
+/* The profilers and the slack stealing scheduler need to find every task, so
+when any of them is used the tasks are also kept on a list of their own. */
+#if( ( configUSE_STACK_PROFILER == 1 ) || ( configUSE_WCET_PROFILER == 1 ) || ( configUSE_EDF_SLACK_STEALING == 1 ) )
+	#define tskUSE_TASK_REGISTRY	1
+#else
+	#define tskUSE_TASK_REGISTRY	0
+#endif
+
+#if ( configUSE_WCET_PROFILER == 1 )
+	/* Sizes of the parts of the frame written by xTaskGetWcetFrame(). */
+	#define taskWCET_FRAME_VERSION			( 1U )
+	#define taskWCET_FRAME_HEADER_LENGTH	( 14U )
+	#define taskWCET_FRAME_RECORD_LENGTH	( ( size_t ) configMAX_TASK_NAME_LEN + ( size_t ) 25U + ( ( size_t ) 2U * ( size_t ) configWCET_HISTOGRAM_BUCKETS ) )
+	#define taskWCET_FRAME_CRC_LENGTH		( 2U )
+#endif
+
 /*
  * Macros used by vListTask to indicate which state a task is in.
  */
@@ -112,12 +146,6 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configIDLE_TASK_NAME "IDLE"
 #endif
 
-/* The period allocated to the Idle task in case of using EDF scheduler.
-This can be overridden by defining configIDLE_TASK_PERIOD in FreeRTOSConfig.h. */
-#ifndef configIDLE_TASK_PERIOD
-	#define configIDLE_TASK_PERIOD 200
-#endif
-
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -199,21 +227,53 @@ This can be overridden by defining configIDLE_TASK_PERIOD in FreeRTOSConfig.h. *
 
 /*-----------------------------------------------------------*/
 
-/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
-count overflows. */
-#define taskSWITCH_DELAYED_LISTS()																	\
-{																									\
-	List_t *pxTemp;																					\
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+	/* The delay wheel is indexed by the wake time modulo its range, so there
+	are no lists to switch when the tick count overflows. */
+	#define taskSWITCH_DELAYED_LISTS()																\
+	{																								\
+		xNumOfOverflows++;																			\
+		prvResetNextTaskUnblockTime();																\
+	}
+
+	#define taskDELAY_WHEEL_SLOTS			( ( UBaseType_t ) 1U << configDELAY_WHEEL_SLOT_BITS )
+	#define taskDELAY_WHEEL_SLOT_MASK		( ( TickType_t ) taskDELAY_WHEEL_SLOTS - ( TickType_t ) 1U )
+	#define taskDELAY_WHEEL_LEVEL_SHIFT( uxLevel )	( ( uxLevel ) * ( UBaseType_t ) configDELAY_WHEEL_SLOT_BITS )
+	#define taskDELAY_WHEEL_RANGE_SHIFT		taskDELAY_WHEEL_LEVEL_SHIFT( ( UBaseType_t ) configDELAY_WHEEL_LEVELS )
+
+	/* Every slot of every level, plus the list of tasks that wake beyond the
+	range of the wheel. */
+	#define taskDELAYED_LIST_COUNT			( ( ( UBaseType_t ) configDELAY_WHEEL_LEVELS * taskDELAY_WHEEL_SLOTS ) + ( UBaseType_t ) 1U )
+
+	#define taskLIST_IS_DELAYED_LIST( pxList )																			\
+		( ( ( ( pxList ) >= &( xDelayWheel[ 0 ][ 0 ] ) ) &&																\
+			( ( pxList ) <= &( xDelayWheel[ configDELAY_WHEEL_LEVELS - 1 ][ taskDELAY_WHEEL_SLOTS - 1U ] ) ) ) ||		\
+		  ( ( pxList ) == &xDelayWheelFarList ) )
+
+#else
+
+	/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
+	count overflows. */
+	#define taskSWITCH_DELAYED_LISTS()																\
+	{																								\
+		List_t *pxTemp;																				\
 																									\
-	/* The delayed tasks list should be empty when the lists are switched. */						\
-	configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );										\
+		/* The delayed tasks list should be empty when the lists are switched. */					\
+		configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );									\
 																									\
-	pxTemp = pxDelayedTaskList;																		\
-	pxDelayedTaskList = pxOverflowDelayedTaskList;													\
-	pxOverflowDelayedTaskList = pxTemp;																\
-	xNumOfOverflows++;																				\
-	prvResetNextTaskUnblockTime();																	\
-}
+		pxTemp = pxDelayedTaskList;																	\
+		pxDelayedTaskList = pxOverflowDelayedTaskList;												\
+		pxOverflowDelayedTaskList = pxTemp;															\
+		xNumOfOverflows++;																			\
+		prvResetNextTaskUnblockTime();																\
+	}
+
+	#define taskDELAYED_LIST_COUNT			( ( UBaseType_t ) 2U )
+
+	#define taskLIST_IS_DELAYED_LIST( pxList )	( ( ( pxList ) == pxDelayedTaskList ) || ( ( pxList ) == pxOverflowDelayedTaskList ) )
+
+#endif /* configUSE_DELAY_WHEEL */
 
 /*-----------------------------------------------------------*/
 
@@ -227,10 +287,30 @@ count overflows. */
 		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
 		vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
 		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
-#else
-	#define prvAddTaskToReadyList( pxTCB ) /*xStateListItem must contain the deadline value */				\
+#elif configUSE_EDF_SLACK_STEALING == 0
+	/* The ready list is ordered by the deadline of each task's current job,
+	which the state list item only holds while the task is ready - a blocked
+	task's item holds its wake time instead. */
+	#define prvAddTaskToReadyList( pxTCB )																\
 		traceMOVED_TASK_TO_READY_STATE( pxTCB ); /* Log that the task has been moved to the ready state */	\
-		vListInsert(&(xReadyTasksListEDF), &((pxTCB)->xStateListItem));										\
+		listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( pxTCB )->xJobDeadline );				\
+		prvInsertInTimeOrder( &( xReadyTasksListEDF ), &( ( pxTCB )->xStateListItem ) );					\
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#else
+	/* Best-effort tasks have no deadline so are kept in FIFO order in their own
+	list, and are only selected while the system has slack to give away. */
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		if( ( pxTCB )->xTaskPeriod == tskBEST_EFFORT_PERIOD )											\
+		{																								\
+			vListInsertEnd( &( xBestEffortTasksList ), &( ( pxTCB )->xStateListItem ) );				\
+		}																								\
+		else																							\
+		{																								\
+			listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( pxTCB )->xJobDeadline );			\
+			xSystemSlackIsStale = pdTRUE;																\
+			prvInsertInTimeOrder( &( xReadyTasksListEDF ), &( ( pxTCB )->xStateListItem ) );				\
+		}																								\
 		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 #endif
 
@@ -286,7 +366,20 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 	#endif
 
 	#if ( configUSE_EDF_SCHEDULER == 1 )
-		TickType_t		xTaskPeriod;		/*< Stores the period in tick of the task. */
+		TickType_t		xTaskPeriod;		/*< Stores the period of the task.  For a sporadic task, the minimum time between two releases.  Like all EDF times it is in ticks, or in high resolution timer counts if configUSE_EDF_HIGH_RES_TIME is 1. */
+		TickType_t		xRelativeDeadline;	/*< The deadline of each job, relative to its release. */
+		TickType_t		xLastRelease;		/*< The release time of the last job released by vTaskDelayUntilNextRelease() or xTaskReleaseSporadicFromISR(), or the time the task was created.  Ahead of the current time if that release was deferred. */
+		TickType_t		xJobDeadline;		/*< The absolute deadline of the current job. */
+		TickType_t		xLastArrival;		/*< The time of the last call to xTaskReleaseSporadicFromISR() for the task, whether or not the release was deferred. */
+		TickType_t		xPendingRelease;	/*< The release time of the oldest job released while the previous job was still running. */
+		UBaseType_t		uxInterArrivalViolations; /*< Releases that came sooner than the minimum inter-arrival time after the one before. */
+		UBaseType_t		uxPendingReleases;	/*< Jobs released while the previous job was still running, which start one at a time as the task waits again. */
+		uint8_t			ucReleasedFromISR;	/*< Set to pdTRUE by the first call to xTaskReleaseSporadicFromISR(), from when the minimum inter-arrival time is enforced. */
+	#endif
+
+	#if ( configUSE_EDF_SLACK_STEALING == 1 )
+		TickType_t		xTaskWcet;			/*< The worst case execution time of one job, in ticks.  Used to compute the system slack. */
+		TickType_t		xJobExecutionTime;	/*< Ticks consumed by the current job so far. */
 	#endif
 	
 	#if ( configUSE_TRACE_FACILITY == 1 )
@@ -311,6 +404,25 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
+	#if( tskUSE_TASK_REGISTRY == 1 )
+		struct tskTaskControlBlock *pxNextRegisteredTask;	/*< The next task in the list of every task. */
+	#endif
+
+	#if( configUSE_STACK_PROFILER == 1 )
+		configSTACK_DEPTH_TYPE	uxStackDepth;		/*< The size of the stack in words. */
+		configSTACK_DEPTH_TYPE	uxStackFreeWords;	/*< The fewest words found still holding the fill value at the end of the stack that is used last. */
+		configSTACK_DEPTH_TYPE	uxStackScanIndex;	/*< The next word of the unused part of the stack the idle task checks. */
+	#endif
+
+	#if( configUSE_WCET_PROFILER == 1 )
+		uint32_t		ulJobStartRunTime;	/*< The value of ulRunTimeCounter when the current job was released. */
+		uint32_t		ulJobCount;			/*< The number of jobs measured. */
+		uint32_t		ulMinJobTime;		/*< The shortest job measured, in run time counter counts. */
+		uint32_t		ulMaxJobTime;		/*< The longest job measured, in run time counter counts. */
+		uint16_t		usJobHistogram[ configWCET_HISTOGRAM_BUCKETS ];	/*< Job execution times, in buckets 2^ucJobHistogramShift counts wide. */
+		uint8_t			ucJobHistogramShift;
+	#endif
+
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		/* Allocate a Newlib reent structure that is specific to this task.
 		Note Newlib support has been included by popular demand, but is not
@@ -326,8 +438,8 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments in FreeRTOS.h with the definition of
@@ -359,16 +471,61 @@ xDelayedTaskList1 and xDelayedTaskList2 could be move to function scople but
 doing so breaks some kernel aware debuggers and debuggers that rely on removing
 the static qualifier. */
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if ( configUSE_DELAY_WHEEL == 1 )
+	PRIVILEGED_DATA static List_t xDelayWheel[ configDELAY_WHEEL_LEVELS ][ taskDELAY_WHEEL_SLOTS ];	/*< Delayed tasks, hashed on their wake time.  Level 0 has a slot per tick, each higher level a slot per rotation of the level below. */
+	PRIVILEGED_DATA static uint32_t ulDelayWheelOccupied[ configDELAY_WHEEL_LEVELS ];	/*< A bit per slot, set when a task is added to the slot and cleared when the slot is processed.  A task leaving the Blocked state early does not clear the bit. */
+	PRIVILEGED_DATA static List_t xDelayWheelFarList;					/*< Delayed tasks that wake beyond the range of the wheel. */
+	PRIVILEGED_DATA static TickType_t xDelayWheelTime;					/*< The tick the wheel has been advanced to.  Lags xTickCount on ticks where there is nothing to process. */
+
+	/* Bit positions indexed by the top five bits of a power of two multiplied
+	by the de Bruijn sequence 0x077CB531. */
+	static const uint8_t ucDelayWheelBitPosition[ 32 ] =
+	{
+		0U, 1U, 28U, 2U, 29U, 14U, 24U, 3U, 30U, 22U, 20U, 15U, 25U, 17U, 4U, 8U,
+		31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U, 26U, 12U, 18U, 6U, 11U, 5U, 10U, 9U
+	};
+#else
+	PRIVILEGED_DATA static List_t xDelayedTaskList1;					/*< Delayed tasks. */
+	PRIVILEGED_DATA static List_t xDelayedTaskList2;					/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;			/*< Points to the delayed task list currently being used. */
+	PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;	/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 /* Define new ready list in case of using the EDF scheduler */
 #if ( configUSE_EDF_SCHEDULER == 1 )
 
-	PRIVILEGED_DATA static List_t xReadyTasksListEDF;					/*< Ready tasks ordered by their deadline. */
+	PRIVILEGED_DATA static List_t xReadyTasksListEDF;					/*< Ready tasks ordered by their deadline.  The idle task is never in this list, it runs when the list is empty. */
+	PRIVILEGED_DATA static List_t xStagedReadyList;						/*< Tasks readied together by the tick interrupt or xTaskResumeAll(), held in deadline order until they are merged into xReadyTasksListEDF in one pass. */
+
+	/* The deadline reported for the idle task.  It is never compared with the
+	deadline of a job, as every job that is released preempts the idle task. */
+	#define tskIDLE_DEADLINE	portMAX_DELAY
+
+	/* The time EDF releases and deadlines are measured in. */
+	#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+		#define taskEDF_TIME_NOW()		portEDF_GET_HIGH_RES_TIME()
+	#else
+		#define taskEDF_TIME_NOW()		xTickCount
+	#endif
+
+	/* Non-zero if xTimeA is before xTimeB.  The times are compared through
+	their difference, which keeps them in order when the time wraps as long as
+	they are less than half the range of TickType_t apart.  That matters most
+	for a high resolution time, which can wrap within the hour. */
+	#define taskTIME_IS_BEFORE( xTimeA, xTimeB )	( ( ( TickType_t ) ( ( xTimeA ) - ( xTimeB ) ) ) > ( portMAX_DELAY >> 1 ) )
+
+	#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+		PRIVILEGED_DATA static List_t xEdfReleaseList;					/*< Tasks waiting in vTaskDelayUntilNextRelease() in release time order.  The high resolution alarm is set for the task at the head. */
+	#endif
+
+#endif
+
+#if ( configUSE_EDF_SLACK_STEALING == 1 )
+
+	PRIVILEGED_DATA static List_t xBestEffortTasksList;					/*< Ready best-effort tasks, run only while there is slack. */
+	PRIVILEGED_DATA static volatile TickType_t xSystemSlack = ( TickType_t ) 0U; /*< Slack left for best-effort tasks.  Counted down every tick, as the slack cannot shrink faster than time passes. */
+	PRIVILEGED_DATA static volatile BaseType_t xSystemSlackIsStale = pdTRUE;	/*< Set when a job is released or completes, which is when the slack can change other than by the passing of time. */
 
 #endif
 
@@ -400,7 +557,7 @@ PRIVILEGED_DATA static volatile TickType_t xPendedTicks 			= ( TickType_t ) 0U;
 PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
+PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts.  With the delay wheel this is the next tick on which a slot needs processing, which can be before any task is due. */
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
 
 /* Context switches are held pending while the scheduler is suspended.  Also,
@@ -422,6 +579,18 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+#if ( tskUSE_TASK_REGISTRY == 1 )
+
+	PRIVILEGED_DATA static TCB_t *pxRegisteredTasks = NULL;		/*< Every task, linked through pxNextRegisteredTask. */
+
+#endif
+
+#if ( configUSE_STACK_PROFILER == 1 )
+
+	PRIVILEGED_DATA static TCB_t *pxStackProfileCursor = NULL;	/*< The task whose stack the idle task is checking. */
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -497,6 +666,48 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
  */
 static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STACK_PROFILER == 1 )
+
+	/*
+	 * Used only by the idle task.  Checks up to
+	 * configSTACK_PROFILER_WORDS_PER_CALL words of the unused part of one
+	 * task's stack, moving on to the next task once the whole unused part has
+	 * been checked or a used word has been found.
+	 */
+	static void prvStackProfilerStep( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( tskUSE_TASK_REGISTRY == 1 )
+
+	/*
+	 * Removes a task that is being deleted from the list of every task kept
+	 * for the profilers.  Called from a critical section.
+	 */
+	static void prvUnregisterTask( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_WCET_PROFILER == 1 )
+
+	/*
+	 * Called when a job of the task is released.  Adds the run time the task
+	 * has used since its previous release, which is the execution time of its
+	 * previous job, to the task's execution time histogram.  Called from a
+	 * critical section or with interrupts masked.
+	 */
+	static void prvWcetJobReleased( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the execution time, in run time counter counts, that
+	 * uxPercentile percent of the task's measured jobs did not exceed, taken
+	 * as the upper edge of the histogram bucket it falls in and capped at the
+	 * longest job.
+	 */
+	static uint32_t prvWcetPercentile( const TCB_t * const pxTCB, const UBaseType_t uxPercentile ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * The currently executing task is entering the Blocked state.  Add the task to
  * either the current or the overflow delayed task list.
@@ -559,6 +770,150 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskGetHandle == 1 ) )
+
+	/*
+	 * Returns the uxIndex'th of the taskDELAYED_LIST_COUNT lists that hold
+	 * tasks that are Blocked with a timeout, so the lists can be walked without
+	 * knowing how the delayed tasks are stored.
+	 */
+	static List_t * prvGetDelayedList( const UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from the tick interrupt once pxTCB's timeout has expired.  Removes
+ * the task from the delayed list and any event list it is waiting on, adds it
+ * to the ready list and returns pdTRUE if that should cause a context switch.
+ * Under EDF the task is only staged in xStagedReadyList, which the tick
+ * interrupt merges into the ready list once every due task has been found.
+ */
+static BaseType_t prvUnblockDelayedTask( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	/*
+	 * Holds pxTCB, which must not be in any state list, in pxStagingList in
+	 * deadline order.  Best-effort tasks are not staged but appended to their
+	 * own ready list straight away, in which case pdTRUE is returned so the
+	 * scheduler can decide whether there is slack to run them.
+	 */
+	static BaseType_t prvStageReadyTask( TCB_t * const pxTCB, List_t * const pxStagingList ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Merges every task staged in pxStagingList into the EDF ready list in a
+	 * single pass, and returns pdTRUE if the running task should be preempted.
+	 * Must be called from a critical section or with the scheduler suspended.
+	 */
+	static BaseType_t prvAddStagedTasksToReadyList( List_t * const pxStagingList ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Inserts pxNewListItem into pxList, which is ordered by time, after the
+	 * items with the same time.  Unlike vListInsert() the item values are
+	 * compared with taskTIME_IS_BEFORE(), so the order survives the time
+	 * wrapping.
+	 */
+	static void prvInsertInTimeOrder( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns pdTRUE if a job with the absolute deadline xDeadline should
+	 * preempt the running task.
+	 */
+	static BaseType_t prvPreemptsRunningTask( const TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Starts the next job of pxTCB, released at xRelease.  The caller updates
+	 * xLastRelease, which can be a later release that has not started its job
+	 * yet.
+	 */
+	static void prvReleaseJob( TCB_t * const pxTCB, const TickType_t xRelease ) PRIVILEGED_FUNCTION;
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+		/*
+		 * Returns how long after xTimeNow the minimum inter-arrival time of
+		 * pxTCB allows its next release, or zero if it allows it now.
+		 */
+		static TickType_t prvTimeToNextArrival( const TCB_t * const pxTCB, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+		/*
+		 * Starts the oldest job released while the calling task was still
+		 * running the job before, if there is one.  Called from
+		 * ulTaskGenericNotifyTake() in a critical section.
+		 */
+		static void prvStartPendingRelease( void ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+#endif
+
+#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+
+	/*
+	 * Releases every task in xEdfReleaseList whose release time has been
+	 * reached, then sets the high resolution alarm for the next release.
+	 * Returns pdTRUE if the running task should be preempted.  Must be called
+	 * from a critical section with the scheduler running.
+	 */
+	static BaseType_t prvReleaseDueJobs( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+	/*
+	 * Adds the list item of a task that is entering the Blocked state to the
+	 * delay wheel, and brings xNextTaskUnblockTime forward if the wheel needs
+	 * processing sooner because of it.
+	 */
+	static void prvDelayWheelInsert( ListItem_t * const pxStateListItem, TickType_t xTimeToWake ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Places pxStateListItem in the slot for xTimeToWake relative to
+	 * xDelayWheelTime, which xTimeToWake must be after, and returns the tick at
+	 * which that slot is next processed.
+	 */
+	static TickType_t prvDelayWheelPlace( ListItem_t * const pxStateListItem, const TickType_t xTimeToWake ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Sets *puxSlot to the first occupied slot of level uxLevel to be processed
+	 * after xDelayWheelTime, and *pxEvent to the tick at which it is processed.
+	 * Returns pdFALSE if the level is empty.
+	 */
+	static BaseType_t prvDelayWheelFirstSlot( const UBaseType_t uxLevel, UBaseType_t * const puxSlot, TickType_t * const pxEvent ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Sets *pxNextEvent to the first tick after xDelayWheelTime at which an
+	 * occupied slot is processed.  Returns pdFALSE if the wheel is empty.
+	 */
+	static BaseType_t prvDelayWheelNextEvent( TickType_t * const pxNextEvent ) PRIVILEGED_FUNCTION;
+
+	#if ( configUSE_TICKLESS_IDLE != 0 )
+
+		/*
+		 * Returns the earliest time at which a task in the wheel can be due,
+		 * which unlike xNextTaskUnblockTime is not brought forward by the slots
+		 * that only cascade tasks to a lower level.  Returns portMAX_DELAY if
+		 * no task is due before the tick count overflows.
+		 */
+		static TickType_t prvDelayWheelNextWakeTime( void ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+	/*
+	 * Advances the wheel to xTimeNow, cascading higher levels down as their
+	 * slots come round and unblocking the tasks whose wake time is reached.
+	 * Returns pdTRUE if a context switch is required.
+	 */
+	static BaseType_t prvDelayWheelAdvance( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Sets xNextTaskUnblockTime from the result of prvDelayWheelNextEvent().
+	 */
+	static void prvDelayWheelSetNextUnblockTime( const BaseType_t xFound, const TickType_t xNextEvent ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_DELAY_WHEEL */
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -588,6 +943,66 @@ static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
+/*
+ * Used by the EDF task creation functions to set the timing of a new task,
+ * and the deadline of its first job, which is released when the task is
+ * created.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static void prvInitialiseTaskTiming( TCB_t *pxNewTCB, TickType_t xPeriod, TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Create an EDF task, periodic or sporadic, with the given period (or minimum
+ * inter-arrival time) and relative deadline.  xTaskCreatePeriodic() and
+ * xTaskCreateSporadic() are thin wrappers.
+ */
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
+
+	/*
+	 * Allocates the TCB and stack of an EDF task.  Returns NULL if either
+	 * cannot be allocated.
+	 */
+	static TCB_t * prvAllocateEdfTask( const configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+
+	static BaseType_t prvCreateEdfTask( TaskFunction_t pxTaskCode,
+										const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+										const configSTACK_DEPTH_TYPE usStackDepth,
+										void * const pvParameters,
+										UBaseType_t uxPriority,
+										TaskHandle_t * const pxCreatedTask,
+										TickType_t xPeriod,
+										TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
+
+	static TaskHandle_t prvCreateEdfTaskStatic(	TaskFunction_t pxTaskCode,
+												const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+												const uint32_t ulStackDepth,
+												void * const pvParameters,
+												UBaseType_t uxPriority,
+												StackType_t * const puxStackBuffer,
+												StaticTask_t * const pxTaskBuffer,
+												TickType_t xPeriod,
+												TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Creates the idle task under EDF.  It has no jobs, so unlike the tasks created
+ * with xTaskCreatePeriodic() it is never added to xReadyTasksListEDF, and is
+ * selected to run only when that list is empty.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static BaseType_t prvCreateIdleTaskEdf( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -599,6 +1014,61 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
+/*
+ * Returns the number of ticks best-effort tasks can execute from now on
+ * without causing any periodic job to miss its deadline.  The slack is the
+ * smallest gap, over every absolute deadline up to the end of the busy period
+ * that starts now, between the time left until that deadline and the worst
+ * case demand of the jobs (current and future releases) that must complete by
+ * it.  The deadlines are visited in order, each at a cost linear in the number
+ * of deadline tasks, until the work released so far plus the slack found so
+ * far fits before the deadline - the processor would then idle, and no later
+ * deadline can be missed because of the time given away.  If that takes more
+ * than configEDF_SLACK_MAX_DEADLINE_CHECKS deadlines the slack is reported as
+ * zero.  Must be called from a critical section or with the scheduler
+ * suspended.
+ */
+#if ( configUSE_EDF_SLACK_STEALING == 1 )
+
+	static TickType_t prvCalculateSystemSlack( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the worst case demand of all periodic jobs, current and future,
+	 * whose deadline is no more than xHorizon ticks from xTimeNow.
+	 */
+	static TickType_t prvDemandUntil( const TickType_t xHorizon, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the worst case execution time of all periodic jobs, current and
+	 * future, released less than xHorizon ticks from xTimeNow, whatever their
+	 * deadline.
+	 */
+	static TickType_t prvWorkReleasedBefore( const TickType_t xHorizon, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the number of ticks from xTimeNow to the earliest absolute
+	 * deadline, of any job current or future, that is at least xFrom ticks
+	 * away.  Returns portMAX_DELAY if no task has jobs.
+	 */
+	static TickType_t prvNextDeadlineFrom( const TickType_t xFrom, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Sets *pxDeadline to the number of ticks from xTimeNow to the deadline of
+	 * the next job of pxTCB that has not completed, and *pxRemaining to the
+	 * worst case execution time that job has left.  Returns pdFALSE for tasks
+	 * that place no demand on the processor - best-effort tasks and the idle
+	 * task.
+	 */
+	static BaseType_t prvGetNextJob( const TCB_t * const pxTCB, const TickType_t xTimeNow, TickType_t * const pxDeadline, TickType_t * const pxRemaining ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns pdTRUE if pxTCB is blocked on a queue, semaphore, event group or
+	 * task notification, rather than only delayed.
+	 */
+	static BaseType_t prvIsWaitingForEvent( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -658,51 +1128,177 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 #endif /* SUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-#if( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-	BaseType_t xTaskCreateRestrictedStatic( const TaskParameters_t * const pxTaskDefinition, TaskHandle_t *pxCreatedTask )
+	static void prvInitialiseTaskTiming( TCB_t *pxNewTCB, TickType_t xPeriod, TickType_t xRelativeDeadline )
 	{
-	TCB_t *pxNewTCB;
-	BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+		pxNewTCB->xTaskPeriod = xPeriod;
+		pxNewTCB->xRelativeDeadline = xRelativeDeadline;
+		pxNewTCB->xLastRelease = taskEDF_TIME_NOW();
+		pxNewTCB->xJobDeadline = pxNewTCB->xLastRelease + xRelativeDeadline;
+		pxNewTCB->xLastArrival = pxNewTCB->xLastRelease;
+		pxNewTCB->xPendingRelease = pxNewTCB->xLastRelease;
+		pxNewTCB->uxInterArrivalViolations = ( UBaseType_t ) 0U;
+		pxNewTCB->uxPendingReleases = ( UBaseType_t ) 0U;
+		pxNewTCB->ucReleasedFromISR = pdFALSE;
+	}
 
-		configASSERT( pxTaskDefinition->puxStackBuffer != NULL );
-		configASSERT( pxTaskDefinition->pxTaskBuffer != NULL );
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
 
-		if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( pxTaskDefinition->pxTaskBuffer != NULL ) )
-		{
-			/* Allocate space for the TCB.  Where the memory comes from depends
-			on the implementation of the port malloc function and whether or
-			not static allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pxTaskDefinition->pxTaskBuffer;
+#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
 
-			/* Store the stack location in the TCB. */
-			pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
+	TaskHandle_t xTaskCreatePeriodicStatic(	TaskFunction_t pxTaskCode,
+											const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const uint32_t ulStackDepth,
+											void * const pvParameters,
+											UBaseType_t uxPriority,
+											StackType_t * const puxStackBuffer,
+											StaticTask_t * const pxTaskBuffer,
+											TickType_t period )
+	{
+		/* The period is also the relative deadline of each job. */
+		return prvCreateEdfTaskStatic( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer, period, period );
+	}
+	/*-----------------------------------------------------------*/
 
-			#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
-			{
-				/* Tasks can be created statically or dynamically, so note this
-				task was created statically in case the task is later deleted. */
-				pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
-			}
-			#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+	TaskHandle_t xTaskCreatePeriodicWithDeadlineStatic(	TaskFunction_t pxTaskCode,
+														const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+														const uint32_t ulStackDepth,
+														void * const pvParameters,
+														UBaseType_t uxPriority,
+														StackType_t * const puxStackBuffer,
+														StaticTask_t * const pxTaskBuffer,
+														TickType_t xPeriod,
+														TickType_t xRelativeDeadline )
+	{
+		configASSERT( xPeriod != tskBEST_EFFORT_PERIOD );
+		configASSERT( ( xRelativeDeadline > ( TickType_t ) 0U ) && ( xRelativeDeadline <= xPeriod ) );
 
-			prvInitialiseNewTask(	pxTaskDefinition->pvTaskCode,
-									pxTaskDefinition->pcName,
-									( uint32_t ) pxTaskDefinition->usStackDepth,
-									pxTaskDefinition->pvParameters,
-									pxTaskDefinition->uxPriority,
-									pxCreatedTask, pxNewTCB,
-									pxTaskDefinition->xRegions );
+		return prvCreateEdfTaskStatic( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer, xPeriod, xRelativeDeadline );
+	}
+	/*-----------------------------------------------------------*/
 
-			prvAddNewTaskToReadyList( pxNewTCB );
-			xReturn = pdPASS;
-		}
+	TaskHandle_t xTaskCreateSporadicStatic(	TaskFunction_t pxTaskCode,
+											const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const uint32_t ulStackDepth,
+											void * const pvParameters,
+											UBaseType_t uxPriority,
+											StackType_t * const puxStackBuffer,
+											StaticTask_t * const pxTaskBuffer,
+											TickType_t xMinInterArrival,
+											TickType_t xRelativeDeadline )
+	{
+		configASSERT( xMinInterArrival != tskBEST_EFFORT_PERIOD );
+		configASSERT( ( xRelativeDeadline > ( TickType_t ) 0U ) && ( xRelativeDeadline <= xMinInterArrival ) );
 
-		return xReturn;
+		return prvCreateEdfTaskStatic( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer, xMinInterArrival, xRelativeDeadline );
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
-/*-----------------------------------------------------------*/
+	static TaskHandle_t prvCreateEdfTaskStatic(	TaskFunction_t pxTaskCode,
+												const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+												const uint32_t ulStackDepth,
+												void * const pvParameters,
+												UBaseType_t uxPriority,
+												StackType_t * const puxStackBuffer,
+												StaticTask_t * const pxTaskBuffer,
+												TickType_t xPeriod,
+												TickType_t xRelativeDeadline )
+	{
+	TCB_t *pxNewTCB;
+	TaskHandle_t xReturn;
+
+		configASSERT( puxStackBuffer != NULL );
+		configASSERT( pxTaskBuffer != NULL );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticTask_t equals the size of the real task
+			structure. */
+			volatile size_t xSize = sizeof( StaticTask_t );
+			configASSERT( xSize == sizeof( TCB_t ) );
+			( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
+		}
+		#endif /* configASSERT_DEFINED */
+
+		if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
+		{
+			/* The memory used for the task's TCB and stack are passed into this
+			function - use them. */
+			pxNewTCB = ( TCB_t * ) pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+			pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
+
+			prvInitialiseTaskTiming( pxNewTCB, xPeriod, xRelativeDeadline );
+
+			#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+			{
+				/* Tasks can be created statically or dynamically, so note this
+				task was created statically in case the task is later deleted. */
+				pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+			}
+			#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+			prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL );
+			prvAddNewTaskToReadyList( pxNewTCB );
+		}
+		else
+		{
+			xReturn = NULL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	BaseType_t xTaskCreateRestrictedStatic( const TaskParameters_t * const pxTaskDefinition, TaskHandle_t *pxCreatedTask )
+	{
+	TCB_t *pxNewTCB;
+	BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+
+		configASSERT( pxTaskDefinition->puxStackBuffer != NULL );
+		configASSERT( pxTaskDefinition->pxTaskBuffer != NULL );
+
+		if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( pxTaskDefinition->pxTaskBuffer != NULL ) )
+		{
+			/* Allocate space for the TCB.  Where the memory comes from depends
+			on the implementation of the port malloc function and whether or
+			not static allocation is being used. */
+			pxNewTCB = ( TCB_t * ) pxTaskDefinition->pxTaskBuffer;
+
+			/* Store the stack location in the TCB. */
+			pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
+
+			#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+			{
+				/* Tasks can be created statically or dynamically, so note this
+				task was created statically in case the task is later deleted. */
+				pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+			}
+			#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+			prvInitialiseNewTask(	pxTaskDefinition->pvTaskCode,
+									pxTaskDefinition->pcName,
+									( uint32_t ) pxTaskDefinition->usStackDepth,
+									pxTaskDefinition->pvParameters,
+									pxTaskDefinition->uxPriority,
+									pxCreatedTask, pxNewTCB,
+									pxTaskDefinition->xRegions );
+
+			prvAddNewTaskToReadyList( pxNewTCB );
+			xReturn = pdPASS;
+		}
+
+		return xReturn;
+	}
+
+#endif /* ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
 
 #if( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
@@ -852,9 +1448,47 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 								UBaseType_t uxPriority,
 								TaskHandle_t * const pxCreatedTask,
 								TickType_t period )
+		{
+			/* The period is also the relative deadline of each job. */
+			return prvCreateEdfTask( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, period, period );
+		}
+		/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskCreatePeriodicWithDeadline(	TaskFunction_t pxTaskCode,
+													const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+													const configSTACK_DEPTH_TYPE usStackDepth,
+													void * const pvParameters,
+													UBaseType_t uxPriority,
+													TaskHandle_t * const pxCreatedTask,
+													TickType_t xPeriod,
+													TickType_t xRelativeDeadline )
+		{
+			configASSERT( xPeriod != tskBEST_EFFORT_PERIOD );
+			configASSERT( ( xRelativeDeadline > ( TickType_t ) 0U ) && ( xRelativeDeadline <= xPeriod ) );
+
+			return prvCreateEdfTask( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, xPeriod, xRelativeDeadline );
+		}
+		/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskCreateSporadic(	TaskFunction_t pxTaskCode,
+								const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+								const configSTACK_DEPTH_TYPE usStackDepth,
+								void * const pvParameters,
+								UBaseType_t uxPriority,
+								TaskHandle_t * const pxCreatedTask,
+								TickType_t xMinInterArrival,
+								TickType_t xRelativeDeadline )
+		{
+			configASSERT( xMinInterArrival != tskBEST_EFFORT_PERIOD );
+			configASSERT( ( xRelativeDeadline > ( TickType_t ) 0U ) && ( xRelativeDeadline <= xMinInterArrival ) );
+
+			return prvCreateEdfTask( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, xMinInterArrival, xRelativeDeadline );
+		}
+		/*-----------------------------------------------------------*/
+
+		static TCB_t * prvAllocateEdfTask( const configSTACK_DEPTH_TYPE usStackDepth )
 		{
 		TCB_t *pxNewTCB;
-		BaseType_t xReturn;
 
 			/* If the stack grows down then allocate the stack then the TCB so the stack
 			does not grow into the TCB.  Likewise if the stack grows up then allocate
@@ -873,12 +1507,6 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 					be deleted later if required. */
 					pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
-					/* Initialize the task period */
-					pxNewTCB->xTaskPeriod = period;
-
-					/* Insert the period value in the list item before adding the task in Ready List */
-					listSET_LIST_ITEM_VALUE(&((pxNewTCB)->xStateListItem), (pxNewTCB)->xTaskPeriod + xTickCount);
-					
 					if( pxNewTCB->pxStack == NULL )
 					{
 						/* Could not allocate the stack.  Delete the allocated TCB. */
@@ -899,12 +1527,6 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 					/* Allocate space for the TCB. */
 					pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
-					/* Initialize the task period */
-					pxNewTCB->xTaskPeriod = period;
-
-					/* Insert the period value in the generic list item before adding the task in Ready List */
-					listSET_LIST_ITEM_VALUE(&((pxNewTCB)->xStateListItem), (pxNewTCB)->xTaskPeriod + xTickCount);
-					
 					if( pxNewTCB != NULL )
 					{
 						/* Store the stack location in the TCB. */
@@ -924,16 +1546,42 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			}
 			#endif /* portSTACK_GROWTH */
 
-			if( pxNewTCB != NULL )
+			#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
 			{
-				#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
+				if( pxNewTCB != NULL )
 				{
 					/* Tasks can be created statically or dynamically, so note this
 					task was created dynamically in case it is later deleted. */
 					pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
 				}
-				#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+			return pxNewTCB;
+		}
+		/*-----------------------------------------------------------*/
 
+		static BaseType_t prvCreateEdfTask( TaskFunction_t pxTaskCode,
+											const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const configSTACK_DEPTH_TYPE usStackDepth,
+											void * const pvParameters,
+											UBaseType_t uxPriority,
+											TaskHandle_t * const pxCreatedTask,
+											TickType_t xPeriod,
+											TickType_t xRelativeDeadline )
+		{
+		TCB_t *pxNewTCB;
+		BaseType_t xReturn;
+
+			pxNewTCB = prvAllocateEdfTask( usStackDepth );
+
+			if( pxNewTCB != NULL )
+			{
+				prvInitialiseTaskTiming( pxNewTCB, xPeriod, xRelativeDeadline );
 				prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
 				prvAddNewTaskToReadyList( pxNewTCB );
 				xReturn = pdPASS;
@@ -1090,12 +1738,48 @@ UBaseType_t x;
 	}
 	#endif /* configUSE_APPLICATION_TASK_TAG */
 
+	#if ( configUSE_EDF_SLACK_STEALING == 1 )
+	{
+		pxNewTCB->xTaskWcet = ( TickType_t ) 0U;
+		pxNewTCB->xJobExecutionTime = ( TickType_t ) 0U;
+	}
+	#endif /* configUSE_EDF_SLACK_STEALING */
+
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 	{
 		pxNewTCB->ulRunTimeCounter = 0UL;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( tskUSE_TASK_REGISTRY == 1 )
+	{
+		pxNewTCB->pxNextRegisteredTask = NULL;
+	}
+	#endif /* tskUSE_TASK_REGISTRY */
+
+	#if ( configUSE_STACK_PROFILER == 1 )
+	{
+		/* Nothing is known to be used until the idle task has checked the
+		stack. */
+		pxNewTCB->uxStackDepth = ( configSTACK_DEPTH_TYPE ) ulStackDepth;
+		pxNewTCB->uxStackFreeWords = ( configSTACK_DEPTH_TYPE ) ulStackDepth;
+		pxNewTCB->uxStackScanIndex = ( configSTACK_DEPTH_TYPE ) 0;
+	}
+	#endif /* configUSE_STACK_PROFILER */
+
+	#if ( configUSE_WCET_PROFILER == 1 )
+	{
+		/* The first job starts when the task is created, at which time its
+		run time counter is zero. */
+		pxNewTCB->ulJobStartRunTime = 0UL;
+		pxNewTCB->ulJobCount = 0UL;
+		pxNewTCB->ulMinJobTime = 0UL;
+		pxNewTCB->ulMaxJobTime = 0UL;
+		memset( ( void * ) &( pxNewTCB->usJobHistogram[ 0 ] ), 0x00, sizeof( pxNewTCB->usJobHistogram ) );
+		pxNewTCB->ucJobHistogramShift = ( uint8_t ) 0U;
+	}
+	#endif /* configUSE_WCET_PROFILER */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -1118,8 +1802,8 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		memset( ( void * ) &( pxNewTCB->ulNotifiedValue[ 0 ] ), 0x00, sizeof( pxNewTCB->ulNotifiedValue ) );
+		memset( ( void * ) &( pxNewTCB->ucNotifyState[ 0 ] ), taskNOT_WAITING_NOTIFICATION, sizeof( pxNewTCB->ucNotifyState ) );
 	}
 	#endif
 
@@ -1235,8 +1919,16 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			so far. */
 			if( xSchedulerRunning == pdFALSE )
 			{
-                #if (configUSE_EDF_SCHEDULER == 1 )
-                    if( pxCurrentTCB->xTaskPeriod >= pxNewTCB->xTaskPeriod )
+                #if ( configUSE_EDF_SLACK_STEALING == 1 )
+                    /* A best-effort task must never be the first task to run,
+                    and the idle task only runs when no job is ready. */
+                    if( ( pxNewTCB != xIdleTaskHandle ) && ( pxNewTCB->xTaskPeriod != tskBEST_EFFORT_PERIOD ) &&
+                        ( ( pxCurrentTCB->xTaskPeriod == tskBEST_EFFORT_PERIOD ) || ( pxCurrentTCB->xTaskPeriod >= pxNewTCB->xTaskPeriod ) ) )
+                    {
+                        pxCurrentTCB = pxNewTCB;
+                    }
+                #elif (configUSE_EDF_SCHEDULER == 1 )
+                    if( ( pxNewTCB != xIdleTaskHandle ) && ( pxCurrentTCB->xTaskPeriod >= pxNewTCB->xTaskPeriod ) )
                     {
                         pxCurrentTCB = pxNewTCB;
                     }
@@ -1267,7 +1959,31 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		#endif /* configUSE_TRACE_FACILITY */
 		traceTASK_CREATE( pxNewTCB );
 
-		prvAddTaskToReadyList( pxNewTCB );
+		#if ( tskUSE_TASK_REGISTRY == 1 )
+		{
+			pxNewTCB->pxNextRegisteredTask = pxRegisteredTasks;
+			pxRegisteredTasks = pxNewTCB;
+		}
+		#endif /* tskUSE_TASK_REGISTRY */
+
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+		{
+			/* The idle task is kept out of the ready list, and is selected
+			when the list is empty. */
+			if( pxNewTCB != xIdleTaskHandle )
+			{
+				prvAddTaskToReadyList( pxNewTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			prvAddTaskToReadyList( pxNewTCB );
+		}
+		#endif /* configUSE_EDF_SCHEDULER */
 
 		portSETUP_TCB( pxNewTCB );
 	}
@@ -1325,6 +2041,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if ( tskUSE_TASK_REGISTRY == 1 )
+			{
+				prvUnregisterTask( pxTCB );
+			}
+			#endif /* tskUSE_TASK_REGISTRY */
+
 			/* Increment the uxTaskNumber also so kernel aware debuggers can
 			detect that the task lists need re-generating.  This is done before
 			portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -1472,6 +2194,100 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	void vTaskDelayUntilNextRelease( void )
+	{
+	TickType_t xNextRelease;
+	#if ( configUSE_EDF_HIGH_RES_TIME == 0 )
+		BaseType_t xAlreadyYielded;
+	#endif
+
+		configASSERT( uxSchedulerSuspended == 0 );
+
+		#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+		{
+			/* The high resolution alarm interrupt uses the release list, so
+			it is only accessed from a critical section. */
+			taskENTER_CRITICAL();
+			{
+				xNextRelease = pxCurrentTCB->xLastRelease + pxCurrentTCB->xTaskPeriod;
+
+				( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+
+				if( taskTIME_IS_BEFORE( portEDF_GET_HIGH_RES_TIME(), xNextRelease ) )
+				{
+					traceTASK_DELAY_UNTIL( xNextRelease );
+
+					/* prvReleaseDueJobs() sets the alarm for the earliest
+					release, and makes this one itself if it has become due
+					in the meantime. */
+					listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xNextRelease );
+					prvInsertInTimeOrder( &xEdfReleaseList, &( pxCurrentTCB->xStateListItem ) );
+					( void ) prvReleaseDueJobs();
+				}
+				else
+				{
+					/* The job ran past the next release, so the next job is
+					due already and starts straight away, with the deadline it
+					would have had if it had been released on time. */
+					pxCurrentTCB->xLastRelease = xNextRelease;
+					prvReleaseJob( pxCurrentTCB, xNextRelease );
+					prvAddTaskToReadyList( pxCurrentTCB );
+				}
+
+				portYIELD_WITHIN_API();
+			}
+			taskEXIT_CRITICAL();
+		}
+		#else
+		{
+			/* The releases are timed by the tick, so this works like
+			vTaskDelayUntil() on the task's last release time.  Unlike
+			vTaskDelayUntil() it also starts the next job when its release is
+			already due, so the job does not keep the deadline of the job
+			before. */
+			vTaskSuspendAll();
+			{
+				xNextRelease = pxCurrentTCB->xLastRelease + pxCurrentTCB->xTaskPeriod;
+				pxCurrentTCB->xLastRelease = xNextRelease;
+
+				if( taskTIME_IS_BEFORE( xTickCount, xNextRelease ) )
+				{
+					traceTASK_DELAY_UNTIL( xNextRelease );
+
+					/* prvUnblockDelayedTask() releases the job when the task
+					wakes. */
+					prvAddCurrentTaskToDelayedList( xNextRelease - xTickCount, pdFALSE );
+				}
+				else
+				{
+					/* The job ran past the next release, so the next job
+					starts straight away, with the deadline it would have had
+					if it had been released on time. */
+					prvReleaseJob( pxCurrentTCB, xNextRelease );
+					( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+					prvAddTaskToReadyList( pxCurrentTCB );
+				}
+			}
+			xAlreadyYielded = xTaskResumeAll();
+
+			/* Another job can be due first either way. */
+			if( xAlreadyYielded == pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EDF_HIGH_RES_TIME */
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelay == 1 )
 
 	void vTaskDelay( const TickType_t xTicksToDelay )
@@ -1522,7 +2338,8 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	eTaskState eTaskGetState( TaskHandle_t xTask )
 	{
 	eTaskState eReturn;
-	List_t const * pxStateList, *pxDelayedList, *pxOverflowedDelayedList;
+	List_t const * pxStateList;
+	BaseType_t xIsDelayed;
 	const TCB_t * const pxTCB = xTask;
 
 		configASSERT( pxTCB );
@@ -1537,18 +2354,25 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			taskENTER_CRITICAL();
 			{
 				pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-				pxDelayedList = pxDelayedTaskList;
-				pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+				xIsDelayed = taskLIST_IS_DELAYED_LIST( pxStateList );
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+			if( xIsDelayed != pdFALSE )
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
 				eReturn = eBlocked;
 			}
 
+			#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+				else if( pxStateList == &xEdfReleaseList )
+				{
+					/* The task is waiting for its next release. */
+					eReturn = eBlocked;
+				}
+			#endif
+
 			#if ( INCLUDE_vTaskSuspend == 1 )
 				else if( pxStateList == &xSuspendedTaskList )
 				{
@@ -1559,17 +2383,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					{
 						#if( configUSE_TASK_NOTIFICATIONS == 1 )
 						{
+						UBaseType_t uxIndex;
+
 							/* The task does not appear on the event list item of
 							and of the RTOS objects, but could still be in the
-							blocked state if it is waiting on its notification
-							rather than waiting on an object. */
-							if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
-							{
-								eReturn = eBlocked;
-							}
-							else
+							blocked state if it is waiting on one of its
+							notifications rather than waiting on an object. */
+							eReturn = eSuspended;
+
+							for( uxIndex = 0; uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; uxIndex++ )
 							{
-								eReturn = eSuspended;
+								if( pxTCB->ucNotifyState[ uxIndex ] == taskWAITING_NOTIFICATION )
+								{
+									eReturn = eBlocked;
+									break;
+								}
 							}
 						}
 						#else
@@ -1585,6 +2413,15 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				}
 			#endif
 
+			#if ( configUSE_EDF_SCHEDULER == 1 )
+				else if( pxTCB == xIdleTaskHandle )
+				{
+					/* Under EDF the idle task is not referenced from any list,
+					but it is always ready to run. */
+					eReturn = eReady;
+				}
+			#endif
+
 			#if ( INCLUDE_vTaskDelete == 1 )
 				else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
 				{
@@ -1874,11 +2711,16 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			#if( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			UBaseType_t uxIndex;
+
+				for( uxIndex = 0; uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; uxIndex++ )
 				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+					if( pxTCB->ucNotifyState[ uxIndex ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but
+						is now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ uxIndex ] = taskNOT_WAITING_NOTIFICATION;
+					}
 				}
 			}
 			#endif
@@ -2108,49 +2950,124 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-void vTaskStartScheduler( void )
-{
-BaseType_t xReturn;
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-	/* Add the idle task at the lowest priority. */
-	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	static BaseType_t prvCreateIdleTaskEdf( void )
 	{
+	TCB_t *pxNewTCB;
+	uint32_t ulStackDepth;
+	BaseType_t xReturn;
+
+		#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
 		StaticTask_t *pxIdleTaskTCBBuffer = NULL;
 		StackType_t *pxIdleTaskStackBuffer = NULL;
-		uint32_t ulIdleTaskStackSize;
 
-		/* The Idle task is created using user provided RAM - obtain the
-		address of the RAM then create the idle task. */
-		vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
-		xIdleTaskHandle = xTaskCreateStatic(	prvIdleTask,
-												configIDLE_TASK_NAME,
-												ulIdleTaskStackSize,
-												( void * ) NULL, /*lint !e961.  The cast is not redundant for all compilers. */
-												portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-												pxIdleTaskStackBuffer,
-												pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+			/* The Idle task is created using user provided RAM - obtain the
+			address of the RAM then create the idle task. */
+			vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulStackDepth );
+			configASSERT( pxIdleTaskStackBuffer != NULL );
+			configASSERT( pxIdleTaskTCBBuffer != NULL );
 
-		if( xIdleTaskHandle != NULL )
-		{
-			xReturn = pdPASS;
-		}
-		else
-		{
-			xReturn = pdFAIL;
-		}
-	}
-	#elif (configUSE_EDF_SCHEDULER == 1)
-	{
-		TickType_t initIDLEPeriod = configIDLE_TASK_PERIOD;
-		xReturn = xTaskCreatePeriodic(prvIdleTask, 
-									  configIDLE_TASK_NAME,
-									  configMINIMAL_STACK_SIZE, 
-									  (void*)NULL, 
-									  portPRIVILEGE_BIT, 
-									  &xIdleTaskHandle,
-									  initIDLEPeriod);
-	}
-	#else
+			#if( configASSERT_DEFINED == 1 )
+			{
+				/* Sanity check that the size of the structure used to declare a
+				variable of type StaticTask_t equals the size of the real task
+				structure. */
+				volatile size_t xSize = sizeof( StaticTask_t );
+				configASSERT( xSize == sizeof( TCB_t ) );
+				( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
+			}
+			#endif /* configASSERT_DEFINED */
+
+			if( ( pxIdleTaskTCBBuffer != NULL ) && ( pxIdleTaskStackBuffer != NULL ) )
+			{
+				pxNewTCB = ( TCB_t * ) pxIdleTaskTCBBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+				pxNewTCB->pxStack = ( StackType_t * ) pxIdleTaskStackBuffer;
+
+				#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+				{
+					/* Tasks can be created statically or dynamically, so note
+					this task was created statically in case the task is later
+					deleted. */
+					pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+				}
+				#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+			}
+			else
+			{
+				pxNewTCB = NULL;
+			}
+		}
+		#else
+		{
+			ulStackDepth = ( uint32_t ) configMINIMAL_STACK_SIZE;
+			pxNewTCB = prvAllocateEdfTask( ( configSTACK_DEPTH_TYPE ) configMINIMAL_STACK_SIZE );
+		}
+		#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+		if( pxNewTCB != NULL )
+		{
+			/* The idle task has no jobs.  It is given the latest possible
+			period and deadline so it reports as the least urgent task, and
+			neither is ever updated. */
+			prvInitialiseTaskTiming( pxNewTCB, tskIDLE_DEADLINE, tskIDLE_DEADLINE );
+			pxNewTCB->xJobDeadline = tskIDLE_DEADLINE;
+
+			/* xIdleTaskHandle is set before the task is added, which keeps it
+			out of the ready list. */
+			prvInitialiseNewTask( prvIdleTask, configIDLE_TASK_NAME, ulStackDepth, ( void * ) NULL, portPRIVILEGE_BIT, &xIdleTaskHandle, pxNewTCB, NULL );
+			listSET_LIST_ITEM_VALUE( &( pxNewTCB->xStateListItem ), tskIDLE_DEADLINE );
+			prvAddNewTaskToReadyList( pxNewTCB );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+void vTaskStartScheduler( void )
+{
+BaseType_t xReturn;
+
+	/* Add the idle task at the lowest priority. */
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		xReturn = prvCreateIdleTaskEdf();
+	}
+	#elif( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		StaticTask_t *pxIdleTaskTCBBuffer = NULL;
+		StackType_t *pxIdleTaskStackBuffer = NULL;
+		uint32_t ulIdleTaskStackSize;
+
+		/* The Idle task is created using user provided RAM - obtain the
+		address of the RAM then create the idle task. */
+		vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+		xIdleTaskHandle = xTaskCreateStatic(	prvIdleTask,
+												configIDLE_TASK_NAME,
+												ulIdleTaskStackSize,
+												( void * ) NULL, /*lint !e961.  The cast is not redundant for all compilers. */
+												portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+												pxIdleTaskStackBuffer,
+												pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+		if( xIdleTaskHandle != NULL )
+		{
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+	#else
 	{
 		/* The Idle task is being created using dynamically allocated RAM. */
 		xReturn = xTaskCreate(	prvIdleTask,
@@ -2160,7 +3077,7 @@ BaseType_t xReturn;
 								portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
 								&xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
 	}
-	#endif /* configSUPPORT_STATIC_ALLOCATION */
+	#endif /* configUSE_EDF_SCHEDULER */
 
 	#if ( configUSE_TIMERS == 1 )
 	{
@@ -2329,7 +3246,18 @@ void vTaskSuspendAll( void )
 		}
 		else
 		{
-			xReturn = xNextTaskUnblockTime - xTickCount;
+			#if ( configUSE_DELAY_WHEEL == 1 )
+			{
+				/* Sleep through the slots that only cascade tasks down the
+				wheel.  xTaskIncrementTick() processes them on the first tick
+				after the sleep. */
+				xReturn = prvDelayWheelNextWakeTime() - xTickCount;
+			}
+			#else
+			{
+				xReturn = xNextTaskUnblockTime - xTickCount;
+			}
+			#endif /* configUSE_DELAY_WHEEL */
 		}
 
 		return xReturn;
@@ -2367,11 +3295,41 @@ BaseType_t xAlreadyYielded = pdFALSE;
 					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
 					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-					prvAddTaskToReadyList( pxTCB );
 
-					/* If the moved task has a priority higher than the current
-					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					#if ( configUSE_EDF_SCHEDULER == 1 )
+					{
+						/* The pending tasks are merged into the ready list
+						together once they have all been staged. */
+						if( prvStageReadyTask( pxTCB, &xStagedReadyList ) != pdFALSE )
+						{
+							xYieldPending = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#else
+					{
+						prvAddTaskToReadyList( pxTCB );
+
+						/* If the moved task has a priority higher than the
+						current task then a yield must be performed. */
+						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						{
+							xYieldPending = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_EDF_SCHEDULER */
+				}
+
+				#if ( configUSE_EDF_SCHEDULER == 1 )
+				{
+					if( prvAddStagedTasksToReadyList( &xStagedReadyList ) != pdFALSE )
 					{
 						xYieldPending = pdTRUE;
 					}
@@ -2380,6 +3338,22 @@ BaseType_t xAlreadyYielded = pdFALSE;
 						mtCOVERAGE_TEST_MARKER();
 					}
 				}
+				#endif /* configUSE_EDF_SCHEDULER */
+
+				#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+				{
+					/* xTaskHighResTimeAlarm() leaves the releases that fall
+					due while the scheduler is suspended to be made here. */
+					if( prvReleaseDueJobs() != pdFALSE )
+					{
+						xYieldPending = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_EDF_HIGH_RES_TIME */
 
 				if( pxTCB != NULL )
 				{
@@ -2609,14 +3583,9 @@ TCB_t *pxTCB;
 			} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			/* Search the delayed lists. */
-			if( pxTCB == NULL )
-			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
-			}
-
-			if( pxTCB == NULL )
+			for( uxQueue = ( UBaseType_t ) 0U; ( uxQueue < taskDELAYED_LIST_COUNT ) && ( pxTCB == NULL ); uxQueue++ )
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				pxTCB = prvSearchForNameWithinSingleList( prvGetDelayedList( uxQueue ), pcNameToQuery );
 			}
 
 			#if ( INCLUDE_vTaskSuspend == 1 )
@@ -2667,10 +3636,43 @@ TCB_t *pxTCB;
 
 				} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
+				#if ( configUSE_EDF_SCHEDULER == 1 )
+				{
+					/* Under EDF the ready tasks are held in the deadline
+					ordered list instead, apart from the idle task, which is
+					in no list at all. */
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xReadyTasksListEDF, eReady );
+
+					#if ( configUSE_EDF_SLACK_STEALING == 1 )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xBestEffortTasksList, eReady );
+					}
+					#endif
+
+					if( xIdleTaskHandle != NULL )
+					{
+						vTaskGetInfo( xIdleTaskHandle, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eReady );
+						uxTask++;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_EDF_SCHEDULER */
+
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				for( uxQueue = ( UBaseType_t ) 0U; uxQueue < taskDELAYED_LIST_COUNT; uxQueue++ )
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), prvGetDelayedList( uxQueue ), eBlocked );
+				}
+
+				#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xEdfReleaseList, eBlocked );
+				}
+				#endif
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -2734,976 +3736,2474 @@ TCB_t *pxTCB;
 #endif /* INCLUDE_xTaskGetIdleTaskHandle */
 /*----------------------------------------------------------*/
 
-/* This conditional compilation should use inequality to 0, not equality to 1.
-This is to ensure vTaskStepTick() is available when user defined low power mode
-implementations require configUSE_TICKLESS_IDLE to be set to a value other than
-1. */
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-	void vTaskStepTick( const TickType_t xTicksToJump )
+	TickType_t xTaskGetCurrentDeadline( void )
 	{
-		/* Correct the tick count value after a period during which the tick
-		was suppressed.  Note this does *not* call the tick hook function for
-		each stepped tick. */
-		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
-		xTickCount += xTicksToJump;
-		traceINCREASE_TICK_COUNT( xTicksToJump );
+	TickType_t xReturn;
+
+		/* A critical section is not required as the deadline of the running
+		task's job is only changed when the task is released again, which
+		cannot happen while it is running. */
+		xReturn = pxCurrentTCB->xJobDeadline;
+
+		return xReturn;
 	}
 
-#endif /* configUSE_TICKLESS_IDLE */
+#endif /* configUSE_EDF_SCHEDULER */
 /*----------------------------------------------------------*/
 
-BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
-{
-BaseType_t xYieldRequired = pdFALSE;
+#if ( configUSE_EDF_SLACK_STEALING == 1 )
 
-	/* Must not be called with the scheduler suspended as the implementation
-	relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-	configASSERT( uxSchedulerSuspended == 0 );
+	void vTaskSetWcet( TaskHandle_t xTask, TickType_t xWcet )
+	{
+	TCB_t *pxTCB;
 
-	/* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
-	the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
-	vTaskSuspendAll();
-	xPendedTicks += xTicksToCatchUp;
-	xYieldRequired = xTaskResumeAll();
+		pxTCB = prvGetTCBFromHandle( xTask );
 
-	return xYieldRequired;
-}
+		taskENTER_CRITICAL();
+		{
+			pxTCB->xTaskWcet = xWcet;
+			xSystemSlackIsStale = pdTRUE;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_EDF_SLACK_STEALING */
 /*----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskAbortDelay == 1 )
+#if ( configUSE_EDF_SLACK_STEALING == 1 )
 
-	BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+	TickType_t xTaskGetSystemSlack( void )
 	{
-	TCB_t *pxTCB = xTask;
-	BaseType_t xReturn;
-
-		configASSERT( pxTCB );
+	TickType_t xReturn;
 
-		vTaskSuspendAll();
+		taskENTER_CRITICAL();
 		{
-			/* A task can only be prematurely removed from the Blocked state if
-			it is actually in the Blocked state. */
-			if( eTaskGetState( xTask ) == eBlocked )
-			{
-				xReturn = pdPASS;
+			xReturn = prvCalculateSystemSlack();
+			xSystemSlack = xReturn;
+			xSystemSlackIsStale = pdFALSE;
+		}
+		taskEXIT_CRITICAL();
 
-				/* Remove the reference to the task from the blocked list.  An
-				interrupt won't touch the xStateListItem because the
-				scheduler is suspended. */
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+		return xReturn;
+	}
 
-				/* Is the task waiting on an event also?  If so remove it from
-				the event list too.  Interrupts can touch the event list item,
-				even though the scheduler is suspended, so a critical section
-				is used. */
-				taskENTER_CRITICAL();
-				{
-					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-					{
-						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+#endif /* configUSE_EDF_SLACK_STEALING */
+/*----------------------------------------------------------*/
 
-						/* This lets the task know it was forcibly removed from the
-						blocked state so it should not re-evaluate its block time and
-						then block again. */
-						pxTCB->ucDelayAborted = pdTRUE;
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-				}
-				taskEXIT_CRITICAL();
+#if ( configUSE_EDF_SLACK_STEALING == 1 )
 
-				/* Place the unblocked task into the appropriate ready list. */
-				prvAddTaskToReadyList( pxTCB );
+	static BaseType_t prvIsWaitingForEvent( const TCB_t * const pxTCB )
+	{
+	BaseType_t xReturn = pdFALSE;
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		UBaseType_t uxIndex;
+	#endif
 
-				/* A task being unblocked cannot cause an immediate context
-				switch if preemption is turned off. */
-				#if (  configUSE_PREEMPTION == 1 )
+		if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		{
+			for( uxIndex = ( UBaseType_t ) 0U; uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; uxIndex++ )
+			{
+				if( pxTCB->ucNotifyState[ uxIndex ] == taskWAITING_NOTIFICATION )
 				{
-					/* Preemption is on, but a context switch should only be
-					performed if the unblocked task has a priority that is
-					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-					{
-						/* Pend the yield to be performed when the scheduler
-						is unsuspended. */
-						xYieldPending = pdTRUE;
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
 				}
-				#endif /* configUSE_PREEMPTION */
-			}
-			else
-			{
-				xReturn = pdFAIL;
 			}
 		}
-		( void ) xTaskResumeAll();
+		#endif /* configUSE_TASK_NOTIFICATIONS */
 
 		return xReturn;
 	}
+	/*----------------------------------------------------------*/
 
-#endif /* INCLUDE_xTaskAbortDelay */
-/*----------------------------------------------------------*/
-
-BaseType_t xTaskIncrementTick( void )
-{
-TCB_t * pxTCB;
-TickType_t xItemValue;
-BaseType_t xSwitchRequired = pdFALSE;
-
-	/* Called by the portable layer each time a tick interrupt occurs.
-	Increments the tick then checks to see if the new tick value will cause any
-	tasks to be unblocked. */
-	traceTASK_INCREMENT_TICK( xTickCount );
-	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+	static BaseType_t prvGetNextJob( const TCB_t * const pxTCB, const TickType_t xTimeNow, TickType_t * const pxDeadline, TickType_t * const pxRemaining )
 	{
-		/* Minor optimisation.  The tick count cannot change in this
-		block. */
-		const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
-
-		/* Increment the RTOS tick, switching the delayed and overflowed
-		delayed lists if it wraps to 0. */
-		xTickCount = xConstTickCount;
+	const List_t * const pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+	TickType_t xRelease, xWakeTime;
+	BaseType_t xReturn = pdTRUE;
 
-		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+		if( ( pxTCB == xIdleTaskHandle ) || ( pxTCB->xTaskPeriod == tskBEST_EFFORT_PERIOD ) )
 		{
-			taskSWITCH_DELAYED_LISTS();
+			xReturn = pdFALSE;
 		}
-		else
+		else if( ( pxStateList == &xReadyTasksListEDF ) || ( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == &xPendingReadyList ) )
 		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+			/* The current job is ready, and may already have run for a while.
+			A deadline in the past wraps to a very large value. */
+			*pxDeadline = pxTCB->xJobDeadline - xTimeNow;
 
-		/* See if this tick has made a timeout expire.  Tasks are stored in
-		the	queue in the order of their wake time - meaning once one task
-		has been found whose block time has not expired there is no need to
-		look any further down the list. */
-		if( xConstTickCount >= xNextTaskUnblockTime )
+			if( pxTCB->xTaskWcet > pxTCB->xJobExecutionTime )
+			{
+				*pxRemaining = pxTCB->xTaskWcet - pxTCB->xJobExecutionTime;
+			}
+			else
+			{
+				*pxRemaining = ( TickType_t ) 0U;
+			}
+		}
+		else
 		{
-			for( ;; )
+			/* The task is waiting for its next job.  An event can release
+			it at any time, but a sporadic task no sooner than its minimum
+			inter-arrival time allows.  That is when the job is assumed to
+			arrive, which charges a sporadic task waiting indefinitely for one
+			job every period. */
+			#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+				xRelease = prvTimeToNextArrival( pxTCB, xTimeNow );
+			}
+			#else
+			{
+				xRelease = ( TickType_t ) 0U;
+			}
+			#endif /* configUSE_TASK_NOTIFICATIONS */
+
+			if( taskLIST_IS_DELAYED_LIST( pxStateList ) )
+			{
+				/* A task that is only delayed is released when it wakes,
+				which is the release time of a periodic task's next job.  One
+				waiting for an event with a timeout is released by whichever
+				comes first. */
+				xWakeTime = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) - xTimeNow;
+
+				if( ( prvIsWaitingForEvent( pxTCB ) == pdFALSE ) || ( xWakeTime < xRelease ) )
 				{
-					/* The delayed list is empty.  Set xNextTaskUnblockTime
-					to the maximum possible value so it is extremely
-					unlikely that the
-					if( xTickCount >= xNextTaskUnblockTime ) test will pass
-					next time through. */
-					xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					break;
+					xRelease = xWakeTime;
 				}
 				else
 				{
-					/* The delayed list is not empty, get the value of the
-					item at the head of the delayed list.  This is the time
-					at which the task at the head of the delayed list must
-					be removed from the Blocked state. */
-					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-					xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
-
-					if( xConstTickCount < xItemValue )
-					{
-						/* It is not time to unblock this item yet, but the
-						item value is the time at which the task at the head
-						of the blocked list must be removed from the Blocked
-						state -	so record the item value in
-						xNextTaskUnblockTime. */
-						xNextTaskUnblockTime = xItemValue;
-						break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-
-					/* It is time to remove the item from the Blocked state. */
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-					/* Is the task waiting on an event also?  If so remove
-					it from the event list. */
-					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-					{
-						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+			*pxDeadline = xRelease + pxTCB->xRelativeDeadline;
+			*pxRemaining = pxTCB->xTaskWcet;
+		}
 
-#if ( configUSE_EDF_SCHEDULER == 1 )
-                    // h_edf_10. calculate new deadline then add task to EDF Ready list
-                    listSET_LIST_ITEM_VALUE(&((pxTCB)->xStateListItem) , ((TickType_t)(((pxTCB)->xTaskPeriod) + xTickCount)) );
-                    // also updates idle task deadline
-                    listSET_LIST_ITEM_VALUE( &( ( xIdleTaskHandle )->xStateListItem ), ( xIdleTaskHandle)->xTaskPeriod + xTickCount);
-#endif
+		return xReturn;
+	}
 
-                    /* Place the unblocked task into the appropriate ready
-                    list. */
-					prvAddTaskToReadyList( pxTCB );
+#endif /* configUSE_EDF_SLACK_STEALING */
+/*----------------------------------------------------------*/
 
-#if( configUSE_EDF_SCHEDULER == 1 )
-                    // h_edf_11. always switch context to meet EDF criteria
-                    xSwitchRequired = pdTRUE;
-#endif
+#if ( configUSE_EDF_SLACK_STEALING == 1 )
 
-                    /* A task being unblocked cannot cause an immediate
-                    context switch if preemption is turned off. */
-					#if (  configUSE_PREEMPTION == 1 )
-					{
-						/* Preemption is on, but a context switch should
-						only be performed if the unblocked task has a
-						priority that is equal to or higher than the
-						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-						{
-							xSwitchRequired = pdTRUE;
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
-					}
-					#endif /* configUSE_PREEMPTION */
-				}
-			}
-		}
+	static TickType_t prvDemandUntil( const TickType_t xHorizon, const TickType_t xTimeNow )
+	{
+	const TCB_t *pxTCB;
+	TickType_t xDeadline, xRemaining, xDemand = ( TickType_t ) 0U;
 
-		/* Tasks of equal priority to the currently running task will share
-		processing time (time slice) if preemption is on, and the application
-		writer has not explicitly turned time slicing off. */
-		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+		/* The remaining work of the next job of each task counts if its
+		deadline falls inside the horizon, and so does every later job of the
+		same task, whose deadlines follow it a period apart. */
+		for( pxTCB = pxRegisteredTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextRegisteredTask )
 		{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			if( ( prvGetNextJob( pxTCB, xTimeNow, &xDeadline, &xRemaining ) != pdFALSE ) && ( xDeadline <= xHorizon ) )
 			{
-				xSwitchRequired = pdTRUE;
+				xDemand += xRemaining + ( ( ( xHorizon - xDeadline ) / pxTCB->xTaskPeriod ) * pxTCB->xTaskWcet );
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
-		#if ( configUSE_TICK_HOOK == 1 )
+		return xDemand;
+	}
+
+#endif /* configUSE_EDF_SLACK_STEALING */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SLACK_STEALING == 1 )
+
+	static TickType_t prvWorkReleasedBefore( const TickType_t xHorizon, const TickType_t xTimeNow )
+	{
+	const TCB_t *pxTCB;
+	TickType_t xDeadline, xRemaining, xWork = ( TickType_t ) 0U;
+
+		/* The next job of each task is released xRelativeDeadline ticks
+		before its deadline (a ready job already has been), and every later
+		job a period after the one before. */
+		for( pxTCB = pxRegisteredTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextRegisteredTask )
 		{
-			/* Guard against the tick hook being called when the pended tick
-			count is being unwound (when the scheduler is being unlocked). */
-			if( xPendedTicks == ( TickType_t ) 0 )
+			if( ( prvGetNextJob( pxTCB, xTimeNow, &xDeadline, &xRemaining ) != pdFALSE ) && ( xDeadline < ( xHorizon + pxTCB->xRelativeDeadline ) ) )
 			{
-				vApplicationTickHook();
+				xWork += xRemaining + ( ( ( ( xHorizon + pxTCB->xRelativeDeadline ) - xDeadline - ( TickType_t ) 1U ) / pxTCB->xTaskPeriod ) * pxTCB->xTaskWcet );
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		#endif /* configUSE_TICK_HOOK */
 
-		#if ( configUSE_PREEMPTION == 1 )
+		return xWork;
+	}
+
+#endif /* configUSE_EDF_SLACK_STEALING */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SLACK_STEALING == 1 )
+
+	static TickType_t prvNextDeadlineFrom( const TickType_t xFrom, const TickType_t xTimeNow )
+	{
+	const TCB_t *pxTCB;
+	TickType_t xDeadline, xRemaining, xNextDeadline = portMAX_DELAY;
+
+		for( pxTCB = pxRegisteredTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextRegisteredTask )
 		{
-			if( xYieldPending != pdFALSE )
+			if( prvGetNextJob( pxTCB, xTimeNow, &xDeadline, &xRemaining ) != pdFALSE )
 			{
-				xSwitchRequired = pdTRUE;
+				if( xDeadline < xFrom )
+				{
+					/* Move on to the first later job due no sooner than
+					xFrom. */
+					xDeadline += ( ( ( xFrom - xDeadline ) + pxTCB->xTaskPeriod - ( TickType_t ) 1U ) / pxTCB->xTaskPeriod ) * pxTCB->xTaskPeriod;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xDeadline < xNextDeadline )
+				{
+					xNextDeadline = xDeadline;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		#endif /* configUSE_PREEMPTION */
-	}
-	else
-	{
-		++xPendedTicks;
 
-		/* The tick hook gets called at regular intervals, even if the
-		scheduler is locked. */
-		#if ( configUSE_TICK_HOOK == 1 )
-		{
-			vApplicationTickHook();
-		}
-		#endif
+		return xNextDeadline;
 	}
 
-	return xSwitchRequired;
-}
-/*-----------------------------------------------------------*/
+#endif /* configUSE_EDF_SLACK_STEALING */
+/*----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( configUSE_EDF_SLACK_STEALING == 1 )
 
-	void vTaskSetApplicationTaskTag( TaskHandle_t xTask, TaskHookFunction_t pxHookFunction )
+	static TickType_t prvCalculateSystemSlack( void )
 	{
-	TCB_t *xTCB;
-
-		/* If xTask is NULL then it is the task hook of the calling task that is
-		getting set. */
-		if( xTask == NULL )
-		{
-			xTCB = ( TCB_t * ) pxCurrentTCB;
-		}
-		else
-		{
-			xTCB = xTask;
-		}
+	const TickType_t xConstTickCount = xTickCount;
+	const TCB_t *pxTCB;
+	TickType_t xHorizon, xRemaining, xDemand, xSlack = portMAX_DELAY;
+	UBaseType_t uxDeadlinesChecked;
 
-		/* Save the hook function in the TCB.  A critical section is required as
-		the value can be accessed from an interrupt. */
-		taskENTER_CRITICAL();
+		/* A deadline in the past (the subtraction wrapped) leaves no slack at
+		all. */
+		for( pxTCB = pxRegisteredTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextRegisteredTask )
 		{
-			xTCB->pxTaskTag = pxHookFunction;
+			if( ( prvGetNextJob( pxTCB, xConstTickCount, &xHorizon, &xRemaining ) != pdFALSE ) && ( xHorizon > ( portMAX_DELAY >> 1 ) ) )
+			{
+				return ( TickType_t ) 0U;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
-		taskEXIT_CRITICAL();
-	}
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+		/* The smallest gap between a deadline and the demand due by it need
+		not be at the next deadline of any task - a later job of a task with a
+		short period can push the demand up faster than time passes.  So visit
+		every deadline in turn until the end of the busy period. */
+		xHorizon = prvNextDeadlineFrom( ( TickType_t ) 0U, xConstTickCount );
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+		for( uxDeadlinesChecked = ( UBaseType_t ) 0U; xHorizon != portMAX_DELAY; uxDeadlinesChecked++ )
+		{
+			if( ( uxDeadlinesChecked >= ( UBaseType_t ) configEDF_SLACK_MAX_DEADLINE_CHECKS ) || ( xHorizon > ( portMAX_DELAY >> 1 ) ) )
+			{
+				/* Too far ahead to check.  Give nothing away rather than risk
+				a miss. */
+				return ( TickType_t ) 0U;
+			}
 
-	TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
-	{
-	TCB_t *pxTCB;
-	TaskHookFunction_t xReturn;
+			xDemand = prvDemandUntil( xHorizon, xConstTickCount );
 
-		/* If xTask is NULL then set the calling task's hook. */
-		pxTCB = prvGetTCBFromHandle( xTask );
+			if( xDemand >= xHorizon )
+			{
+				return ( TickType_t ) 0U;
+			}
+			else if( ( xHorizon - xDemand ) < xSlack )
+			{
+				xSlack = xHorizon - xDemand;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-		/* Save the hook function in the TCB.  A critical section is required as
-		the value can be accessed from an interrupt. */
-		taskENTER_CRITICAL();
-		{
-			xReturn = pxTCB->pxTaskTag;
+			/* If the work released before this deadline, plus the slack given
+			away, fits before it then the processor idles by then.  Every job
+			due later is released after that, so its deadline is met whatever
+			happened before. */
+			if( ( prvWorkReleasedBefore( xHorizon, xConstTickCount ) + xSlack ) <= xHorizon )
+			{
+				break;
+			}
+			else
+			{
+				xHorizon = prvNextDeadlineFrom( xHorizon + ( TickType_t ) 1U, xConstTickCount );
+			}
 		}
-		taskEXIT_CRITICAL();
 
-		return xReturn;
+		return xSlack;
 	}
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+#endif /* configUSE_EDF_SLACK_STEALING */
+/*----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+/* This conditional compilation should use inequality to 0, not equality to 1.
+This is to ensure vTaskStepTick() is available when user defined low power mode
+implementations require configUSE_TICKLESS_IDLE to be set to a value other than
+1. */
+#if ( configUSE_TICKLESS_IDLE != 0 )
 
-	TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+	void vTaskStepTick( const TickType_t xTicksToJump )
 	{
-	TCB_t *pxTCB;
-	TaskHookFunction_t xReturn;
-	UBaseType_t uxSavedInterruptStatus;
-
-		/* If xTask is NULL then set the calling task's hook. */
-		pxTCB = prvGetTCBFromHandle( xTask );
-
-		/* Save the hook function in the TCB.  A critical section is required as
-		the value can be accessed from an interrupt. */
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		/* Correct the tick count value after a period during which the tick
+		was suppressed.  Note this does *not* call the tick hook function for
+		each stepped tick. */
+		#if ( configUSE_DELAY_WHEEL == 1 )
 		{
-			xReturn = pxTCB->pxTaskTag;
+			/* The tick count can pass xNextTaskUnblockTime, as long as no task
+			becomes due.  The wheel catches up on the next tick. */
+			configASSERT( ( xTickCount + xTicksToJump ) <= prvDelayWheelNextWakeTime() );
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-
+		#else
+		{
+			configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+		}
+		#endif /* configUSE_DELAY_WHEEL */
+		xTickCount += xTicksToJump;
+		traceINCREASE_TICK_COUNT( xTicksToJump );
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
+{
+BaseType_t xYieldRequired = pdFALSE;
+
+	/* Must not be called with the scheduler suspended as the implementation
+	relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
+	configASSERT( uxSchedulerSuspended == 0 );
+
+	/* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
+	the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
+	vTaskSuspendAll();
+	xPendedTicks += xTicksToCatchUp;
+	xYieldRequired = xTaskResumeAll();
+
+	return xYieldRequired;
+}
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskAbortDelay == 1 )
+
+	BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB = xTask;
+	BaseType_t xReturn;
+
+		configASSERT( pxTCB );
+
+		vTaskSuspendAll();
+		{
+			/* A task can only be prematurely removed from the Blocked state if
+			it is actually in the Blocked state. */
+			if( eTaskGetState( xTask ) == eBlocked )
+			{
+				xReturn = pdPASS;
+
+				/* Remove the reference to the task from the blocked list.  An
+				interrupt won't touch the xStateListItem because the
+				scheduler is suspended. */
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+				/* Is the task waiting on an event also?  If so remove it from
+				the event list too.  Interrupts can touch the event list item,
+				even though the scheduler is suspended, so a critical section
+				is used. */
+				taskENTER_CRITICAL();
+				{
+					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+
+						/* This lets the task know it was forcibly removed from the
+						blocked state so it should not re-evaluate its block time and
+						then block again. */
+						pxTCB->ucDelayAborted = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				/* Place the unblocked task into the appropriate ready list. */
+				prvAddTaskToReadyList( pxTCB );
+
+				/* A task being unblocked cannot cause an immediate context
+				switch if preemption is turned off. */
+				#if (  configUSE_PREEMPTION == 1 )
+				{
+					/* Preemption is on, but a context switch should only be
+					performed if the unblocked task has a priority that is
+					equal to or higher than the currently executing task. */
+					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					{
+						/* Pend the yield to be performed when the scheduler
+						is unsuspended. */
+						xYieldPending = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_PREEMPTION */
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
+		}
+		( void ) xTaskResumeAll();
+
 		return xReturn;
 	}
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* INCLUDE_xTaskAbortDelay */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskIncrementTick( void )
+{
+#if ( configUSE_DELAY_WHEEL == 0 )
+	TCB_t * pxTCB;
+	TickType_t xItemValue;
+#endif
+BaseType_t xSwitchRequired = pdFALSE;
+
+	/* Called by the portable layer each time a tick interrupt occurs.
+	Increments the tick then checks to see if the new tick value will cause any
+	tasks to be unblocked. */
+	traceTASK_INCREMENT_TICK( xTickCount );
+	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+	{
+		/* Minor optimisation.  The tick count cannot change in this
+		block. */
+		const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+
+		/* Increment the RTOS tick, switching the delayed and overflowed
+		delayed lists if it wraps to 0. */
+		xTickCount = xConstTickCount;
+
+		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+		{
+			taskSWITCH_DELAYED_LISTS();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* See if this tick has made a timeout expire.  Tasks are stored in
+		the	queue in the order of their wake time - meaning once one task
+		has been found whose block time has not expired there is no need to
+		look any further down the list.  The delay wheel instead sets
+		xNextTaskUnblockTime to the next tick on which one of its slots needs
+		processing. */
+		if( xConstTickCount >= xNextTaskUnblockTime )
+		{
+			#if ( configUSE_DELAY_WHEEL == 1 )
+			{
+				if( prvDelayWheelAdvance( xConstTickCount ) != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#else
+			for( ;; )
+			{
+				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+				{
+					/* The delayed list is empty.  Set xNextTaskUnblockTime
+					to the maximum possible value so it is extremely
+					unlikely that the
+					if( xTickCount >= xNextTaskUnblockTime ) test will pass
+					next time through. */
+					xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					break;
+				}
+				else
+				{
+					/* The delayed list is not empty, get the value of the
+					item at the head of the delayed list.  This is the time
+					at which the task at the head of the delayed list must
+					be removed from the Blocked state. */
+					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+					xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+					if( xConstTickCount < xItemValue )
+					{
+						/* It is not time to unblock this item yet, but the
+						item value is the time at which the task at the head
+						of the blocked list must be removed from the Blocked
+						state -	so record the item value in
+						xNextTaskUnblockTime. */
+						xNextTaskUnblockTime = xItemValue;
+						break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* It is time to remove the item from the Blocked state. */
+					if( prvUnblockDelayedTask( pxTCB ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			#endif /* configUSE_DELAY_WHEEL */
+
+			#if ( configUSE_EDF_SCHEDULER == 1 )
+			{
+				/* Every job released on this tick is now staged, so merge
+				them into the ready list together. */
+				if( prvAddStagedTasksToReadyList( &xStagedReadyList ) != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_SCHEDULER */
+		}
+
+		#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+		{
+			/* Periodic jobs are released by the high resolution alarm.  This
+			only catches a release whose alarm was set too late to fire, so
+			it is made at most one tick late. */
+			if( ( listLIST_IS_EMPTY( &xEdfReleaseList ) == pdFALSE ) &&
+				( taskTIME_IS_BEFORE( portEDF_GET_HIGH_RES_TIME(), listGET_ITEM_VALUE_OF_HEAD_ENTRY( &xEdfReleaseList ) ) == pdFALSE ) )
+			{
+				if( prvReleaseDueJobs() != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EDF_HIGH_RES_TIME */
+
+		#if ( configUSE_EDF_SLACK_STEALING == 1 )
+		{
+			/* The slack is only recomputed when a job is released or
+			completes.  In between it is counted down whatever runs, which can
+			only underestimate it. */
+			if( xSystemSlack > ( TickType_t ) 0U )
+			{
+				xSystemSlack--;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pxCurrentTCB->xTaskPeriod == tskBEST_EFFORT_PERIOD )
+			{
+				/* Once the slack is used up the periodic tasks must get the
+				processor back. */
+				if( xSystemSlack == ( TickType_t ) 0U )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxCurrentTCB->xJobExecutionTime++;
+			}
+		}
+		#endif /* configUSE_EDF_SLACK_STEALING */
+
+		/* Tasks of equal priority to the currently running task will share
+		processing time (time slice) if preemption is on, and the application
+		writer has not explicitly turned time slicing off. */
+		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+		{
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+
+		#if ( configUSE_TICK_HOOK == 1 )
+		{
+			/* Guard against the tick hook being called when the pended tick
+			count is being unwound (when the scheduler is being unlocked). */
+			if( xPendedTicks == ( TickType_t ) 0 )
+			{
+				vApplicationTickHook();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TICK_HOOK */
+
+		#if ( configUSE_PREEMPTION == 1 )
+		{
+			if( xYieldPending != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_PREEMPTION */
+	}
+	else
+	{
+		++xPendedTicks;
+
+		/* The tick hook gets called at regular intervals, even if the
+		scheduler is locked. */
+		#if ( configUSE_TICK_HOOK == 1 )
+		{
+			vApplicationTickHook();
+		}
+		#endif
+	}
+
+	return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+
+	BaseType_t xTaskHighResTimeAlarm( void )
+	{
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		/* Called by the portable layer when the high resolution alarm fires.
+		The ready list cannot be accessed while the scheduler is suspended, in
+		which case xTaskResumeAll() makes the releases instead. */
+		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+		{
+			xSwitchRequired = prvReleaseDueJobs();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xSwitchRequired;
+	}
+
+#endif /* configUSE_EDF_HIGH_RES_TIME */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+	void vTaskSetApplicationTaskTag( TaskHandle_t xTask, TaskHookFunction_t pxHookFunction )
+	{
+	TCB_t *xTCB;
+
+		/* If xTask is NULL then it is the task hook of the calling task that is
+		getting set. */
+		if( xTask == NULL )
+		{
+			xTCB = ( TCB_t * ) pxCurrentTCB;
+		}
+		else
+		{
+			xTCB = xTask;
+		}
+
+		/* Save the hook function in the TCB.  A critical section is required as
+		the value can be accessed from an interrupt. */
+		taskENTER_CRITICAL();
+		{
+			xTCB->pxTaskTag = pxHookFunction;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+	TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	TaskHookFunction_t xReturn;
+
+		/* If xTask is NULL then set the calling task's hook. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		/* Save the hook function in the TCB.  A critical section is required as
+		the value can be accessed from an interrupt. */
+		taskENTER_CRITICAL();
+		{
+			xReturn = pxTCB->pxTaskTag;
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+	TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	TaskHookFunction_t xReturn;
+	UBaseType_t uxSavedInterruptStatus;
+
+		/* If xTask is NULL then set the calling task's hook. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		/* Save the hook function in the TCB.  A critical section is required as
+		the value can be accessed from an interrupt. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xReturn = pxTCB->pxTaskTag;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+	BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask, void *pvParameter )
+	{
+	TCB_t *xTCB;
+	BaseType_t xReturn;
+
+		/* If xTask is NULL then we are calling our own task hook. */
+		if( xTask == NULL )
+		{
+			xTCB = pxCurrentTCB;
+		}
+		else
+		{
+			xTCB = xTask;
+		}
+
+		if( xTCB->pxTaskTag != NULL )
+		{
+			xReturn = xTCB->pxTaskTag( pvParameter );
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+void vTaskSwitchContext( void )
+{
+	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+	{
+		/* The scheduler is currently suspended - do not allow a context
+		switch. */
+		xYieldPending = pdTRUE;
+	}
+	else
+	{
+		xYieldPending = pdFALSE;
+		traceTASK_SWITCHED_OUT();
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+			#else
+				ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
+
+			/* Add the amount of time the task has been running to the
+			accumulated time so far.  The time the task started running was
+			stored in ulTaskSwitchedInTime.  Note that there is no overflow
+			protection here so count values are only valid until the timer
+			overflows.  The guard against negative values is to protect
+			against suspect run time stat counter implementations - which
+			are provided by the application, not the kernel. */
+			if( ulTotalRunTime > ulTaskSwitchedInTime )
+			{
+				pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			ulTaskSwitchedInTime = ulTotalRunTime;
+		}
+		#endif /* configGENERATE_RUN_TIME_STATS */
+
+		/* Check for stack overflow, if configured. */
+		taskCHECK_FOR_STACK_OVERFLOW();
+
+		/* Before the currently running task is switched out, save its errno. */
+		#if( configUSE_POSIX_ERRNO == 1 )
+		{
+			pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+		}
+		#endif
+
+		/* Select a new task to run using either the generic C or port
+		optimised asm code. */
+		#if (configUSE_EDF_SCHEDULER == 0)
+		{
+			taskSELECT_HIGHEST_PRIORITY_TASK();
+		}
+		#else
+		{
+			#if ( configUSE_EDF_SLACK_STEALING == 1 )
+			{
+				/* A deadline task leaving the ready list has completed its job,
+				or blocked part way through it.  Either can change the
+				slack. */
+				if( ( pxCurrentTCB != xIdleTaskHandle ) &&
+					( pxCurrentTCB->xTaskPeriod != tskBEST_EFFORT_PERIOD ) &&
+					( listLIST_ITEM_CONTAINER( &( pxCurrentTCB->xStateListItem ) ) != &xReadyTasksListEDF ) )
+				{
+					xSystemSlackIsStale = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_SLACK_STEALING */
+
+			/* Switch to task with nearest deadline, or to the idle task if no
+			job is ready. */
+			if( listLIST_IS_EMPTY( &xReadyTasksListEDF ) == pdFALSE )
+			{
+				pxCurrentTCB = (TCB_t*)listGET_OWNER_OF_HEAD_ENTRY(&( xReadyTasksListEDF ) );
+			}
+			else
+			{
+				pxCurrentTCB = xIdleTaskHandle;
+			}
+
+			#if ( configUSE_EDF_SLACK_STEALING == 1 )
+			{
+				/* The slack is recomputed at most once per release or
+				completion, and only when there is best-effort work to give it
+				to.  Ready best-effort tasks share any slack in round robin
+				order. */
+				if( listLIST_IS_EMPTY( &xBestEffortTasksList ) == pdFALSE )
+				{
+					if( xSystemSlackIsStale != pdFALSE )
+					{
+						xSystemSlack = prvCalculateSystemSlack();
+						xSystemSlackIsStale = pdFALSE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					if( xSystemSlack > ( TickType_t ) 0U )
+					{
+						listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &xBestEffortTasksList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_SLACK_STEALING */
+		}
+		#endif
+		
+		traceTASK_SWITCHED_IN();
+
+		/* After the new task is switched in, update the global errno. */
+		#if( configUSE_POSIX_ERRNO == 1 )
+		{
+			FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+		}
+		#endif
+
+		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		{
+			/* Switch Newlib's _impure_ptr variable to point to the _reent
+			structure specific to this task.
+			See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
+			for additional information. */
+			_impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+		}
+		#endif /* configUSE_NEWLIB_REENTRANT */
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
+{
+	configASSERT( pxEventList );
+
+	/* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+	SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+	/* Place the event list item of the TCB in the appropriate event list.
+	This is placed in the list in priority order so the highest priority task
+	is the first to be woken by the event.  The queue that contains the event
+	list is locked, preventing simultaneous access from interrupts. */
+	vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xItemValue, const TickType_t xTicksToWait )
+{
+	configASSERT( pxEventList );
+
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+	the event groups implementation. */
+	configASSERT( uxSchedulerSuspended != 0 );
+
+	/* Store the item value in the event list item.  It is safe to access the
+	event list item here as interrupts won't access the event list item of a
+	task that is not in the Blocked state. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	/* Place the event list item of the TCB at the end of the appropriate event
+	list.  It is safe to access the event list here because it is part of an
+	event group implementation - and interrupts don't access event groups
+	directly (instead they access them indirectly by pending function calls to
+	the task level). */
+	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMERS == 1 )
+
+	void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely )
+	{
+		configASSERT( pxEventList );
+
+		/* This function should not be called by application code hence the
+		'Restricted' in its name.  It is not part of the public API.  It is
+		designed for use by kernel code, and has special calling requirements -
+		it should be called with the scheduler suspended. */
+
+
+		/* Place the event list item of the TCB in the appropriate event list.
+		In this case it is assume that this is the only task that is going to
+		be waiting on this event list, so the faster vListInsertEnd() function
+		can be used in place of vListInsert. */
+		vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+		/* If the task should block indefinitely then set the block time to a
+		value that will be recognised as an indefinite delay inside the
+		prvAddCurrentTaskToDelayedList() function. */
+		if( xWaitIndefinitely != pdFALSE )
+		{
+			xTicksToWait = portMAX_DELAY;
+		}
+
+		traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
+		prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+	}
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+{
+TCB_t *pxUnblockedTCB;
+BaseType_t xReturn;
+
+	/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+	called from a critical section within an ISR. */
+
+	/* The event list is sorted in priority order, so the first in the list can
+	be removed as it is known to be the highest priority.  Remove the TCB from
+	the delayed list, and add it to the ready list.
+
+	If an event is for a queue that is locked then this function will never
+	get called - the lock count on the queue will get modified instead.  This
+	means exclusive access to the event list is guaranteed here.
+
+	This function assumes that a check has already been made to ensure that
+	pxEventList is not empty. */
+	pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+	configASSERT( pxUnblockedTCB );
+	( void ) uxListRemove( &( pxUnblockedTCB->xEventListItem ) );
+
+	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+	{
+		( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+		prvAddTaskToReadyList( pxUnblockedTCB );
+
+		#if( configUSE_TICKLESS_IDLE != 0 )
+		{
+			/* If a task is blocked on a kernel object then xNextTaskUnblockTime
+			might be set to the blocked task's time out time.  If the task is
+			unblocked for a reason other than a timeout xNextTaskUnblockTime is
+			normally left unchanged, because it is automatically reset to a new
+			value when the tick count equals xNextTaskUnblockTime.  However if
+			tickless idling is used it might be more important to enter sleep mode
+			at the earliest possible time - so reset xNextTaskUnblockTime here to
+			ensure it is updated at the earliest possible time. */
+			prvResetNextTaskUnblockTime();
+		}
+		#endif
+	}
+	else
+	{
+		/* The delayed and ready lists cannot be accessed, so hold this task
+		pending until the scheduler is resumed. */
+		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+	}
+
+	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	{
+		/* Return true if the task removed from the event list has a higher
+		priority than the calling task.  This allows the calling task to know if
+		it should force a context switch now. */
+		xReturn = pdTRUE;
+
+		/* Mark that a yield is pending in case the user is not using the
+		"xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+		xYieldPending = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+{
+TCB_t *pxUnblockedTCB;
+
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+	the event flags implementation. */
+	configASSERT( uxSchedulerSuspended != pdFALSE );
+
+	/* Store the new item value in the event list. */
+	listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	/* Remove the event list form the event flag.  Interrupts do not access
+	event flags. */
+	pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+	configASSERT( pxUnblockedTCB );
+	( void ) uxListRemove( pxEventListItem );
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+	{
+		/* If a task is blocked on a kernel object then xNextTaskUnblockTime
+		might be set to the blocked task's time out time.  If the task is
+		unblocked for a reason other than a timeout xNextTaskUnblockTime is
+		normally left unchanged, because it is automatically reset to a new
+		value when the tick count equals xNextTaskUnblockTime.  However if
+		tickless idling is used it might be more important to enter sleep mode
+		at the earliest possible time - so reset xNextTaskUnblockTime here to
+		ensure it is updated at the earliest possible time. */
+		prvResetNextTaskUnblockTime();
+	}
+	#endif
+
+	/* Remove the task from the delayed list and add it to the ready list.  The
+	scheduler is suspended so interrupts will not be accessing the ready
+	lists. */
+	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+	prvAddTaskToReadyList( pxUnblockedTCB );
+
+	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	{
+		/* The unblocked task has a priority above that of the calling task, so
+		a context switch is required.  This function is called with the
+		scheduler suspended so xYieldPending is set so the context switch
+		occurs immediately that the scheduler is resumed (unsuspended). */
+		xYieldPending = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTaskStageFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue, List_t * pxStagingList )
+{
+TCB_t *pxUnblockedTCB;
+
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+	configASSERT( uxSchedulerSuspended != pdFALSE );
+
+	listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+	configASSERT( pxUnblockedTCB );
+	( void ) uxListRemove( pxEventListItem );
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+	{
+		/* See vTaskRemoveFromUnorderedEventList(). */
+		prvResetNextTaskUnblockTime();
+	}
+	#endif
+
+	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		/* Only the other tasks readied by the same call are searched here,
+		the ready list itself is walked once by
+		vTaskAddStagedTasksToReadyList(). */
+		if( prvStageReadyTask( pxUnblockedTCB, pxStagingList ) != pdFALSE )
+		{
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		/* Inserting into a priority ready list is already constant time. */
+		( void ) pxStagingList;
+		prvAddTaskToReadyList( pxUnblockedTCB );
+
+		if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+		{
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_EDF_SCHEDULER */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static BaseType_t prvStageReadyTask( TCB_t * const pxTCB, List_t * const pxStagingList )
+	{
+	BaseType_t xReturn = pdFALSE;
+
+		#if ( configUSE_EDF_SLACK_STEALING == 1 )
+			if( pxTCB->xTaskPeriod == tskBEST_EFFORT_PERIOD )
+			{
+				/* Best-effort tasks are appended to their own list, which
+				costs nothing to do straight away. */
+				prvAddTaskToReadyList( pxTCB );
+				xReturn = pdTRUE;
+			}
+			else
+		#endif
+			{
+				#if ( configUSE_EDF_SLACK_STEALING == 1 )
+				{
+					xSystemSlackIsStale = pdTRUE;
+				}
+				#endif
+
+				/* Only the other staged tasks are searched here. */
+				listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), pxTCB->xJobDeadline );
+				prvInsertInTimeOrder( pxStagingList, &( pxTCB->xStateListItem ) );
+			}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvAddStagedTasksToReadyList( List_t * const pxStagingList )
+	{
+	ListItem_t *pxInsertAfter, *pxStaged;
+	BaseType_t xReturn = pdFALSE;
+
+		if( listLIST_IS_EMPTY( pxStagingList ) == pdFALSE )
+		{
+			/* Both lists are in deadline order, so each staged task is
+			inserted after the position the previous one was inserted at -
+			equal deadlines go after the tasks already in the ready list, as
+			they would with vListInsert(). */
+			pxInsertAfter = ( ListItem_t * ) &( xReadyTasksListEDF.xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+
+			while( listLIST_IS_EMPTY( pxStagingList ) == pdFALSE )
+			{
+				pxStaged = listGET_HEAD_ENTRY( pxStagingList );
+				( void ) uxListRemove( pxStaged );
+
+				while( ( pxInsertAfter->pxNext != ( ListItem_t * ) &( xReadyTasksListEDF.xListEnd ) ) &&
+					   ( taskTIME_IS_BEFORE( listGET_LIST_ITEM_VALUE( pxStaged ), listGET_LIST_ITEM_VALUE( pxInsertAfter->pxNext ) ) == pdFALSE ) ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+				{
+					pxInsertAfter = pxInsertAfter->pxNext;
+				}
+
+				traceMOVED_TASK_TO_READY_STATE( ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxStaged ) );
+
+				pxStaged->pxNext = pxInsertAfter->pxNext;
+				pxStaged->pxNext->pxPrevious = pxStaged;
+				pxStaged->pxPrevious = pxInsertAfter;
+				pxInsertAfter->pxNext = pxStaged;
+				pxStaged->pxContainer = &xReadyTasksListEDF;
+				( xReadyTasksListEDF.uxNumberOfItems )++;
+
+				tracePOST_MOVED_TASK_TO_READY_STATE( ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxStaged ) );
+
+				pxInsertAfter = pxStaged;
+			}
+
+			/* One preemption decision for the whole batch - only the earliest
+			deadline can displace the running task. */
+			if( prvPreemptsRunningTask( listGET_ITEM_VALUE_OF_HEAD_ENTRY( &xReadyTasksListEDF ) ) != pdFALSE )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvInsertInTimeOrder( List_t * const pxList, ListItem_t * const pxNewListItem )
+	{
+	ListItem_t *pxIterator;
+	const TickType_t xValueOfInsertion = listGET_LIST_ITEM_VALUE( pxNewListItem );
+
+		for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+			 ( pxIterator->pxNext != ( ListItem_t * ) &( pxList->xListEnd ) ) && /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+			 ( taskTIME_IS_BEFORE( xValueOfInsertion, listGET_LIST_ITEM_VALUE( pxIterator->pxNext ) ) == pdFALSE );
+			 pxIterator = pxIterator->pxNext )
+		{
+			/* There is nothing to do here, just iterating to the wanted
+			insertion position. */
+		}
+
+		pxNewListItem->pxNext = pxIterator->pxNext;
+		pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+		pxNewListItem->pxPrevious = pxIterator;
+		pxIterator->pxNext = pxNewListItem;
+		pxNewListItem->pxContainer = pxList;
+
+		( pxList->uxNumberOfItems )++;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvPreemptsRunningTask( const TickType_t xDeadline )
+	{
+	BaseType_t xReturn;
+
+		if( pxCurrentTCB == xIdleTaskHandle )
+		{
+			/* The idle task runs only while no job is ready. */
+			xReturn = pdTRUE;
+		}
+		#if ( configUSE_EDF_SLACK_STEALING == 1 )
+			else if( pxCurrentTCB->xTaskPeriod == tskBEST_EFFORT_PERIOD )
+			{
+				/* A best-effort task only runs while no deadline task is
+				ready. */
+				xReturn = pdTRUE;
+			}
+		#endif
+		else if( taskTIME_IS_BEFORE( xDeadline, pxCurrentTCB->xJobDeadline ) )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReleaseJob( TCB_t * const pxTCB, const TickType_t xRelease )
+	{
+		pxTCB->xJobDeadline = xRelease + pxTCB->xRelativeDeadline;
+
+		#if ( configUSE_EDF_SLACK_STEALING == 1 )
+		{
+			pxTCB->xJobExecutionTime = ( TickType_t ) 0U;
+		}
+		#endif /* configUSE_EDF_SLACK_STEALING */
+
+		#if ( configUSE_WCET_PROFILER == 1 )
+		{
+			prvWcetJobReleased( pxTCB );
+		}
+		#endif /* configUSE_WCET_PROFILER */
+	}
+	/*-----------------------------------------------------------*/
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+		static TickType_t prvTimeToNextArrival( const TCB_t * const pxTCB, const TickType_t xTimeNow )
+		{
+		TickType_t xSinceArrival, xMinimumGap, xReturn = ( TickType_t ) 0U;
+
+			if( pxTCB->ucReleasedFromISR != pdFALSE )
+			{
+				/* Measured from the last arrival rather than the last
+				release, which can have been deferred into the future.  Both
+				differences are elapsed times, so they stay correct however
+				long the task has been waiting. */
+				xSinceArrival = xTimeNow - pxTCB->xLastArrival;
+				xMinimumGap = ( pxTCB->xLastRelease - pxTCB->xLastArrival ) + pxTCB->xTaskPeriod;
+
+				if( xSinceArrival < xMinimumGap )
+				{
+					xReturn = xMinimumGap - xSinceArrival;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Nothing limits the first release. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			return xReturn;
+		}
+		/*-----------------------------------------------------------*/
+
+		static void prvStartPendingRelease( void )
+		{
+			if( pxCurrentTCB->uxPendingReleases == ( UBaseType_t ) 0U )
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			else if( pxCurrentTCB->ulNotifiedValue[ tskDEFAULT_INDEX_TO_NOTIFY ] == 0UL )
+			{
+				/* The releases were cleared from the notification value
+				without being taken. */
+				pxCurrentTCB->uxPendingReleases = ( UBaseType_t ) 0U;
+			}
+			else
+			{
+				prvReleaseJob( pxCurrentTCB, pxCurrentTCB->xPendingRelease );
+				( pxCurrentTCB->uxPendingReleases )--;
+
+				/* Each release after the oldest was at least a period after
+				the one before it. */
+				pxCurrentTCB->xPendingRelease += pxCurrentTCB->xTaskPeriod;
+
+				/* The new deadline is later than the one the task was running
+				to, so another job can now be due first. */
+				( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxCurrentTCB );
+
+				if( prvPreemptsRunningTask( listGET_ITEM_VALUE_OF_HEAD_ENTRY( &xReadyTasksListEDF ) ) != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+
+	#endif /* configUSE_TASK_NOTIFICATIONS */
+	/*-----------------------------------------------------------*/
+
+	#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+
+		static BaseType_t prvReleaseDueJobs( void )
+		{
+		TCB_t *pxTCB;
+		TickType_t xRelease;
+
+			while( listLIST_IS_EMPTY( &xEdfReleaseList ) == pdFALSE )
+			{
+				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( &xEdfReleaseList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				xRelease = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+				if( taskTIME_IS_BEFORE( portEDF_GET_HIGH_RES_TIME(), xRelease ) )
+				{
+					/* The alarm does not fire for a time that has already
+					passed, so check the time again once it is set. */
+					portEDF_SET_HIGH_RES_ALARM( xRelease );
+
+					if( taskTIME_IS_BEFORE( portEDF_GET_HIGH_RES_TIME(), xRelease ) )
+					{
+						break;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The job is released at its release time rather than at the
+				time the alarm was handled, so its deadline is exact. */
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				pxTCB->xLastRelease = xRelease;
+				prvReleaseJob( pxTCB, xRelease );
+				( void ) prvStageReadyTask( pxTCB, &xStagedReadyList );
+			}
+
+			/* Releases that fall due together are merged into the ready list
+			in one pass. */
+			return prvAddStagedTasksToReadyList( &xStagedReadyList );
+		}
+
+	#endif /* configUSE_EDF_HIGH_RES_TIME */
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+void vTaskAddStagedTasksToReadyList( List_t * pxStagingList )
+{
+	configASSERT( uxSchedulerSuspended != pdFALSE );
+
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		if( prvAddStagedTasksToReadyList( pxStagingList ) != pdFALSE )
+		{
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		/* Tasks were added to the ready lists as they were staged. */
+		( void ) pxStagingList;
+	}
+	#endif /* configUSE_EDF_SCHEDULER */
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+	configASSERT( pxTimeOut );
+	taskENTER_CRITICAL();
+	{
+		pxTimeOut->xOverflowCount = xNumOfOverflows;
+		pxTimeOut->xTimeOnEntering = xTickCount;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+	/* For internal use only as it does not use a critical section. */
+	pxTimeOut->xOverflowCount = xNumOfOverflows;
+	pxTimeOut->xTimeOnEntering = xTickCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut, TickType_t * const pxTicksToWait )
+{
+BaseType_t xReturn;
+
+	configASSERT( pxTimeOut );
+	configASSERT( pxTicksToWait );
+
+	taskENTER_CRITICAL();
+	{
+		/* Minor optimisation.  The tick count cannot change in this block. */
+		const TickType_t xConstTickCount = xTickCount;
+		const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+
+		#if( INCLUDE_xTaskAbortDelay == 1 )
+			if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+			{
+				/* The delay was aborted, which is not the same as a time out,
+				but has the same result. */
+				pxCurrentTCB->ucDelayAborted = pdFALSE;
+				xReturn = pdTRUE;
+			}
+			else
+		#endif
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+			if( *pxTicksToWait == portMAX_DELAY )
+			{
+				/* If INCLUDE_vTaskSuspend is set to 1 and the block time
+				specified is the maximum block time then the task should block
+				indefinitely, and therefore never time out. */
+				xReturn = pdFALSE;
+			}
+			else
+		#endif
+
+		if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+		{
+			/* The tick count is greater than the time at which
+			vTaskSetTimeout() was called, but has also overflowed since
+			vTaskSetTimeOut() was called.  It must have wrapped all the way
+			around and gone past again. This passed since vTaskSetTimeout()
+			was called. */
+			xReturn = pdTRUE;
+		}
+		else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+		{
+			/* Not a genuine timeout. Adjust parameters for time remaining. */
+			*pxTicksToWait -= xElapsedTime;
+			vTaskInternalSetTimeOutState( pxTimeOut );
+			xReturn = pdFALSE;
+		}
+		else
+		{
+			*pxTicksToWait = 0;
+			xReturn = pdTRUE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskMissedYield( void )
+{
+	xYieldPending = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+	{
+	UBaseType_t uxReturn;
+	TCB_t const *pxTCB;
+
+		if( xTask != NULL )
+		{
+			pxTCB = xTask;
+			uxReturn = pxTCB->uxTaskNumber;
+		}
+		else
+		{
+			uxReturn = 0U;
+		}
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vTaskSetTaskNumber( TaskHandle_t xTask, const UBaseType_t uxHandle )
+	{
+	TCB_t * pxTCB;
+
+		if( xTask != NULL )
+		{
+			pxTCB = xTask;
+			pxTCB->uxTaskNumber = uxHandle;
+		}
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+
+/*
+ * -----------------------------------------------------------
+ * The Idle task.
+ * ----------------------------------------------------------
+ *
+ * The portTASK_FUNCTION() macro is used to allow port/compiler specific
+ * language extensions.  The equivalent prototype for this function is:
+ *
+ * void prvIdleTask( void *pvParameters );
+ *
+ */
+static portTASK_FUNCTION( prvIdleTask, pvParameters )
+{
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	/** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
+	SCHEDULER IS STARTED. **/
+
+	/* In case a task that has a secure context deletes itself, in which case
+	the idle task is responsible for deleting the task's secure context, if
+	any. */
+	portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
+
+	for( ;; )
+	{
+		/* See if any tasks have deleted themselves - if so then the idle task
+		is responsible for freeing the deleted task's TCB and stack. */
+		prvCheckTasksWaitingTermination();
+
+		#if ( configUSE_STACK_PROFILER == 1 )
+		{
+			/* Update the peak stack usage of one task a few words at a time, so
+			the cost is spread over many passes of this loop rather than paid
+			on every context switch. */
+			prvStackProfilerStep();
+		}
+		#endif /* configUSE_STACK_PROFILER */
+
+		#if ( configUSE_PREEMPTION == 0 )
+		{
+			/* If we are not using preemption we keep forcing a task switch to
+			see if any other task has become available.  If we are using
+			preemption we don't need to do this as any task becoming available
+			will automatically get the processor anyway. */
+			taskYIELD();
+		}
+		#endif /* configUSE_PREEMPTION */
+
+		#if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+		{
+			/* When using preemption tasks of equal priority will be
+			timesliced.  If a task that is sharing the idle priority is ready
+			to run then the idle task should yield before the end of the
+			timeslice.
+
+			A critical region is not required here as we are just reading from
+			the list, and an occasional incorrect value will not matter.  If
+			the ready list at the idle priority contains more than one task
+			then a task other than the idle task is ready to execute. */
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+			{
+				taskYIELD();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+		#if ( configUSE_IDLE_HOOK == 1 )
+		{
+			extern void vApplicationIdleHook( void );
+
+			/* Call the user defined function from within the idle task.  This
+			allows the application designer to add background functionality
+			without the overhead of a separate task.
+			NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
+			CALL A FUNCTION THAT MIGHT BLOCK. */
+			vApplicationIdleHook();
+		}
+		#endif /* configUSE_IDLE_HOOK */
+
+		/* This conditional compilation should use inequality to 0, not equality
+		to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
+		user defined low power mode	implementations require
+		configUSE_TICKLESS_IDLE to be set to a value other than 1. */
+		#if ( configUSE_TICKLESS_IDLE != 0 )
+		{
+		TickType_t xExpectedIdleTime;
+
+			/* It is not desirable to suspend then resume the scheduler on
+			each iteration of the idle task.  Therefore, a preliminary
+			test of the expected idle time is performed without the
+			scheduler suspended.  The result here is not necessarily
+			valid. */
+			xExpectedIdleTime = prvGetExpectedIdleTime();
+
+			if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+			{
+				vTaskSuspendAll();
+				{
+					/* Now the scheduler is suspended, the expected idle
+					time can be sampled again, and this time its value can
+					be used.  The delay wheel lets vTaskStepTick() move the
+					tick count past xNextTaskUnblockTime. */
+					#if ( configUSE_DELAY_WHEEL == 0 )
+					{
+						configASSERT( xNextTaskUnblockTime >= xTickCount );
+					}
+					#endif
+					xExpectedIdleTime = prvGetExpectedIdleTime();
+
+					/* Define the following macro to set xExpectedIdleTime to 0
+					if the application does not want
+					portSUPPRESS_TICKS_AND_SLEEP() to be called. */
+					configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+
+					if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+					{
+						traceLOW_POWER_IDLE_BEGIN();
+						portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+						traceLOW_POWER_IDLE_END();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				( void ) xTaskResumeAll();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TICKLESS_IDLE */
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE != 0 )
+
+	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+	{
+	/* The idle task exists in addition to the application tasks. */
+	const UBaseType_t uxNonApplicationTasks = 1;
+	eSleepModeStatus eReturn = eStandardSleep;
+
+		/* This function must be called from a critical section. */
+
+		if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+		{
+			/* A task was made ready while the scheduler was suspended. */
+			eReturn = eAbortSleep;
+		}
+		else if( xYieldPending != pdFALSE )
+		{
+			/* A yield was pended while the scheduler was suspended. */
+			eReturn = eAbortSleep;
+		}
+		else
+		{
+			/* If all the tasks are in the suspended list (which might mean they
+			have an infinite block time rather than actually being suspended)
+			then it is safe to turn all clocks off and just wait for external
+			interrupts. */
+			if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+			{
+				eReturn = eNoTasksWaitingTimeout;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return eReturn;
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+
+	void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue )
+	{
+	TCB_t *pxTCB;
+
+		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+		{
+			pxTCB = prvGetTCBFromHandle( xTaskToSet );
+			configASSERT( pxTCB != NULL );
+			pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+		}
+	}
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
 
-	BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask, void *pvParameter )
+	void *pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery, BaseType_t xIndex )
 	{
-	TCB_t *xTCB;
-	BaseType_t xReturn;
+	void *pvReturn = NULL;
+	TCB_t *pxTCB;
 
-		/* If xTask is NULL then we are calling our own task hook. */
-		if( xTask == NULL )
+		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
 		{
-			xTCB = pxCurrentTCB;
+			pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+			pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
 		}
 		else
 		{
-			xTCB = xTask;
+			pvReturn = NULL;
 		}
 
-		if( xTCB->pxTaskTag != NULL )
-		{
-			xReturn = xTCB->pxTaskTag( pvParameter );
-		}
-		else
-		{
-			xReturn = pdFAIL;
-		}
+		return pvReturn;
+	}
 
-		return xReturn;
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_MPU_WRAPPERS == 1 )
+
+	void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify, const MemoryRegion_t * const xRegions )
+	{
+	TCB_t *pxTCB;
+
+		/* If null is passed in here then we are modifying the MPU settings of
+		the calling task. */
+		pxTCB = prvGetTCBFromHandle( xTaskToModify );
+
+		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
 	}
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* portUSING_MPU_WRAPPERS */
 /*-----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
+static void prvInitialiseTaskLists( void )
 {
-	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+UBaseType_t uxPriority;
+
+	for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
 	{
-		/* The scheduler is currently suspended - do not allow a context
-		switch. */
-		xYieldPending = pdTRUE;
+		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
-	else
+
+	#if ( configUSE_DELAY_WHEEL == 1 )
 	{
-		xYieldPending = pdFALSE;
-		traceTASK_SWITCHED_OUT();
+	UBaseType_t uxLevel, uxSlot;
 
-		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configDELAY_WHEEL_LEVELS; uxLevel++ )
 		{
-			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-			#else
-				ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-			#endif
-
-			/* Add the amount of time the task has been running to the
-			accumulated time so far.  The time the task started running was
-			stored in ulTaskSwitchedInTime.  Note that there is no overflow
-			protection here so count values are only valid until the timer
-			overflows.  The guard against negative values is to protect
-			against suspect run time stat counter implementations - which
-			are provided by the application, not the kernel. */
-			if( ulTotalRunTime > ulTaskSwitchedInTime )
-			{
-				pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
-			}
-			else
+			for( uxSlot = ( UBaseType_t ) 0U; uxSlot < taskDELAY_WHEEL_SLOTS; uxSlot++ )
 			{
-				mtCOVERAGE_TEST_MARKER();
+				vListInitialise( &( xDelayWheel[ uxLevel ][ uxSlot ] ) );
 			}
-			ulTaskSwitchedInTime = ulTotalRunTime;
 		}
-		#endif /* configGENERATE_RUN_TIME_STATS */
-
-		/* Check for stack overflow, if configured. */
-		taskCHECK_FOR_STACK_OVERFLOW();
-
-		/* Before the currently running task is switched out, save its errno. */
-		#if( configUSE_POSIX_ERRNO == 1 )
-		{
-			pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
-		}
-		#endif
 
-		/* Select a new task to run using either the generic C or port
-		optimised asm code. */
-		#if (configUSE_EDF_SCHEDULER == 0)
-		{
-			taskSELECT_HIGHEST_PRIORITY_TASK();
-		}
-		#else
-		{
-			/* Switch to task with nearest deadline */
-			pxCurrentTCB = (TCB_t*)listGET_OWNER_OF_HEAD_ENTRY(&( xReadyTasksListEDF ) );
-		}
-		#endif
-		
-		traceTASK_SWITCHED_IN();
+		vListInitialise( &xDelayWheelFarList );
+		xDelayWheelTime = xTickCount;
+	}
+	#else
+	{
+		vListInitialise( &xDelayedTaskList1 );
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#endif /* configUSE_DELAY_WHEEL */
 
-		/* After the new task is switched in, update the global errno. */
-		#if( configUSE_POSIX_ERRNO == 1 )
-		{
-			FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
-		}
-		#endif
+	vListInitialise( &xPendingReadyList );
 
-		#if ( configUSE_NEWLIB_REENTRANT == 1 )
-		{
-			/* Switch Newlib's _impure_ptr variable to point to the _reent
-			structure specific to this task.
-			See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
-			for additional information. */
-			_impure_ptr = &( pxCurrentTCB->xNewLib_reent );
-		}
-		#endif /* configUSE_NEWLIB_REENTRANT */
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		vListInitialise(&xReadyTasksListEDF);
+		vListInitialise( &xStagedReadyList );
 	}
-}
-/*-----------------------------------------------------------*/
+	#endif /* configUSE_EDF_SCHEDULER */
 
-void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
-{
-	configASSERT( pxEventList );
+	#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+	{
+		vListInitialise( &xEdfReleaseList );
+	}
+	#endif /* configUSE_EDF_HIGH_RES_TIME */
 
-	/* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
-	SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+	#if ( configUSE_EDF_SLACK_STEALING == 1 )
+	{
+		vListInitialise( &xBestEffortTasksList );
+	}
+	#endif /* configUSE_EDF_SLACK_STEALING */
+	
+	#if ( INCLUDE_vTaskDelete == 1 )
+	{
+		vListInitialise( &xTasksWaitingTermination );
+	}
+	#endif /* INCLUDE_vTaskDelete */
 
-	/* Place the event list item of the TCB in the appropriate event list.
-	This is placed in the list in priority order so the highest priority task
-	is the first to be woken by the event.  The queue that contains the event
-	list is locked, preventing simultaneous access from interrupts. */
-	vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+	#if ( INCLUDE_vTaskSuspend == 1 )
+	{
+		vListInitialise( &xSuspendedTaskList );
+	}
+	#endif /* INCLUDE_vTaskSuspend */
 
-	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+	#if ( configUSE_DELAY_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the
+		pxOverflowDelayedTaskList using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif /* configUSE_DELAY_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xItemValue, const TickType_t xTicksToWait )
+static void prvCheckTasksWaitingTermination( void )
 {
-	configASSERT( pxEventList );
 
-	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-	the event groups implementation. */
-	configASSERT( uxSchedulerSuspended != 0 );
+	/** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
 
-	/* Store the item value in the event list item.  It is safe to access the
-	event list item here as interrupts won't access the event list item of a
-	task that is not in the Blocked state. */
-	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+	#if ( INCLUDE_vTaskDelete == 1 )
+	{
+		TCB_t *pxTCB;
 
-	/* Place the event list item of the TCB at the end of the appropriate event
-	list.  It is safe to access the event list here because it is part of an
-	event group implementation - and interrupts don't access event groups
-	directly (instead they access them indirectly by pending function calls to
-	the task level). */
-	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+		/* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
+		being called too often in the idle task. */
+		while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				--uxCurrentNumberOfTasks;
+				--uxDeletedTasksWaitingCleanUp;
+			}
+			taskEXIT_CRITICAL();
 
-	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+			prvDeleteTCB( pxTCB );
+		}
+	}
+	#endif /* INCLUDE_vTaskDelete */
 }
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TIMERS == 1 )
+#if( configUSE_TRACE_FACILITY == 1 )
 
-	void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely )
+	void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace, eTaskState eState )
 	{
-		configASSERT( pxEventList );
+	TCB_t *pxTCB;
 
-		/* This function should not be called by application code hence the
-		'Restricted' in its name.  It is not part of the public API.  It is
-		designed for use by kernel code, and has special calling requirements -
-		it should be called with the scheduler suspended. */
+		/* xTask is NULL then get the state of the calling task. */
+		pxTCB = prvGetTCBFromHandle( xTask );
 
+		pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
+		pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName [ 0 ] );
+		pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
+		pxTaskStatus->pxStackBase = pxTCB->pxStack;
+		pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
 
-		/* Place the event list item of the TCB in the appropriate event list.
-		In this case it is assume that this is the only task that is going to
-		be waiting on this event list, so the faster vListInsertEnd() function
-		can be used in place of vListInsert. */
-		vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+		}
+		#else
+		{
+			pxTaskStatus->uxBasePriority = 0;
+		}
+		#endif
 
-		/* If the task should block indefinitely then set the block time to a
-		value that will be recognised as an indefinite delay inside the
-		prvAddCurrentTaskToDelayedList() function. */
-		if( xWaitIndefinitely != pdFALSE )
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+		}
+		#else
+		{
+			pxTaskStatus->ulRunTimeCounter = 0;
+		}
+		#endif
+
+		/* Obtaining the task state is a little fiddly, so is only done if the
+		value of eState passed into this function is eInvalid - otherwise the
+		state is just set to whatever is passed in. */
+		if( eState != eInvalid )
+		{
+			if( pxTCB == pxCurrentTCB )
+			{
+				pxTaskStatus->eCurrentState = eRunning;
+			}
+			else
+			{
+				pxTaskStatus->eCurrentState = eState;
+
+				#if ( INCLUDE_vTaskSuspend == 1 )
+				{
+					/* If the task is in the suspended list then there is a
+					chance it is actually just blocked indefinitely - so really
+					it should be reported as being in the Blocked state. */
+					if( eState == eSuspended )
+					{
+						vTaskSuspendAll();
+						{
+							if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+							{
+								pxTaskStatus->eCurrentState = eBlocked;
+							}
+						}
+						( void ) xTaskResumeAll();
+					}
+				}
+				#endif /* INCLUDE_vTaskSuspend */
+			}
+		}
+		else
 		{
-			xTicksToWait = portMAX_DELAY;
+			pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
 		}
 
-		traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
-		prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+		/* Obtaining the stack space takes some time, so the xGetFreeStackSpace
+		parameter is provided to allow it to be skipped. */
+		if( xGetFreeStackSpace != pdFALSE )
+		{
+			#if ( portSTACK_GROWTH > 0 )
+			{
+				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+			}
+			#else
+			{
+				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+			}
+			#endif
+		}
+		else
+		{
+			pxTaskStatus->usStackHighWaterMark = 0;
+		}
 	}
 
-#endif /* configUSE_TIMERS */
+#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
-{
-TCB_t *pxUnblockedTCB;
-BaseType_t xReturn;
-
-	/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
-	called from a critical section within an ISR. */
-
-	/* The event list is sorted in priority order, so the first in the list can
-	be removed as it is known to be the highest priority.  Remove the TCB from
-	the delayed list, and add it to the ready list.
-
-	If an event is for a queue that is locked then this function will never
-	get called - the lock count on the queue will get modified instead.  This
-	means exclusive access to the event list is guaranteed here.
-
-	This function assumes that a check has already been made to ensure that
-	pxEventList is not empty. */
-	pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-	configASSERT( pxUnblockedTCB );
-	( void ) uxListRemove( &( pxUnblockedTCB->xEventListItem ) );
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+	static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t *pxTaskStatusArray, List_t *pxList, eTaskState eState )
 	{
-		( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
-		prvAddTaskToReadyList( pxUnblockedTCB );
+	configLIST_VOLATILE TCB_t *pxNextTCB, *pxFirstTCB;
+	UBaseType_t uxTask = 0;
 
-		#if( configUSE_TICKLESS_IDLE != 0 )
+		if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
 		{
-			/* If a task is blocked on a kernel object then xNextTaskUnblockTime
-			might be set to the blocked task's time out time.  If the task is
-			unblocked for a reason other than a timeout xNextTaskUnblockTime is
-			normally left unchanged, because it is automatically reset to a new
-			value when the tick count equals xNextTaskUnblockTime.  However if
-			tickless idling is used it might be more important to enter sleep mode
-			at the earliest possible time - so reset xNextTaskUnblockTime here to
-			ensure it is updated at the earliest possible time. */
-			prvResetNextTaskUnblockTime();
-		}
-		#endif
-	}
-	else
-	{
-		/* The delayed and ready lists cannot be accessed, so hold this task
-		pending until the scheduler is resumed. */
-		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
-	}
+			listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
-	{
-		/* Return true if the task removed from the event list has a higher
-		priority than the calling task.  This allows the calling task to know if
-		it should force a context switch now. */
-		xReturn = pdTRUE;
+			/* Populate an TaskStatus_t structure within the
+			pxTaskStatusArray array for each task that is referenced from
+			pxList.  See the definition of TaskStatus_t in task.h for the
+			meaning of each TaskStatus_t structure member. */
+			do
+			{
+				listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+				uxTask++;
+			} while( pxNextTCB != pxFirstTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-		/* Mark that a yield is pending in case the user is not using the
-		"xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-		xYieldPending = pdTRUE;
-	}
-	else
-	{
-		xReturn = pdFALSE;
+		return uxTask;
 	}
 
-	return xReturn;
-}
+#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue )
-{
-TCB_t *pxUnblockedTCB;
-
-	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-	the event flags implementation. */
-	configASSERT( uxSchedulerSuspended != pdFALSE );
-
-	/* Store the new item value in the event list. */
-	listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
-
-	/* Remove the event list form the event flag.  Interrupts do not access
-	event flags. */
-	pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-	configASSERT( pxUnblockedTCB );
-	( void ) uxListRemove( pxEventListItem );
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
-	#if( configUSE_TICKLESS_IDLE != 0 )
+	static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
 	{
-		/* If a task is blocked on a kernel object then xNextTaskUnblockTime
-		might be set to the blocked task's time out time.  If the task is
-		unblocked for a reason other than a timeout xNextTaskUnblockTime is
-		normally left unchanged, because it is automatically reset to a new
-		value when the tick count equals xNextTaskUnblockTime.  However if
-		tickless idling is used it might be more important to enter sleep mode
-		at the earliest possible time - so reset xNextTaskUnblockTime here to
-		ensure it is updated at the earliest possible time. */
-		prvResetNextTaskUnblockTime();
-	}
-	#endif
+	uint32_t ulCount = 0U;
 
-	/* Remove the task from the delayed list and add it to the ready list.  The
-	scheduler is suspended so interrupts will not be accessing the ready
-	lists. */
-	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
-	prvAddTaskToReadyList( pxUnblockedTCB );
+		while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+		{
+			pucStackByte -= portSTACK_GROWTH;
+			ulCount++;
+		}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
-	{
-		/* The unblocked task has a priority above that of the calling task, so
-		a context switch is required.  This function is called with the
-		scheduler suspended so xYieldPending is set so the context switch
-		occurs immediately that the scheduler is resumed (unsuspended). */
-		xYieldPending = pdTRUE;
-	}
-}
-/*-----------------------------------------------------------*/
+		ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
 
-void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-	configASSERT( pxTimeOut );
-	taskENTER_CRITICAL();
-	{
-		pxTimeOut->xOverflowCount = xNumOfOverflows;
-		pxTimeOut->xTimeOnEntering = xTickCount;
+		return ( configSTACK_DEPTH_TYPE ) ulCount;
 	}
-	taskEXIT_CRITICAL();
-}
-/*-----------------------------------------------------------*/
 
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-	/* For internal use only as it does not use a critical section. */
-	pxTimeOut->xOverflowCount = xNumOfOverflows;
-	pxTimeOut->xTimeOnEntering = xTickCount;
-}
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut, TickType_t * const pxTicksToWait )
-{
-BaseType_t xReturn;
-
-	configASSERT( pxTimeOut );
-	configASSERT( pxTicksToWait );
+#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
 
-	taskENTER_CRITICAL();
+	/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
+	same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
+	user to determine the return type.  It gets around the problem of the value
+	overflowing on 8-bit types without breaking backward compatibility for
+	applications that expect an 8-bit return type. */
+	configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
 	{
-		/* Minor optimisation.  The tick count cannot change in this block. */
-		const TickType_t xConstTickCount = xTickCount;
-		const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+	TCB_t *pxTCB;
+	uint8_t *pucEndOfStack;
+	configSTACK_DEPTH_TYPE uxReturn;
 
-		#if( INCLUDE_xTaskAbortDelay == 1 )
-			if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
-			{
-				/* The delay was aborted, which is not the same as a time out,
-				but has the same result. */
-				pxCurrentTCB->ucDelayAborted = pdFALSE;
-				xReturn = pdTRUE;
-			}
-			else
-		#endif
+		/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
+		the same except for their return type.  Using configSTACK_DEPTH_TYPE
+		allows the user to determine the return type.  It gets around the
+		problem of the value overflowing on 8-bit types without breaking
+		backward compatibility for applications that expect an 8-bit return
+		type. */
 
-		#if ( INCLUDE_vTaskSuspend == 1 )
-			if( *pxTicksToWait == portMAX_DELAY )
-			{
-				/* If INCLUDE_vTaskSuspend is set to 1 and the block time
-				specified is the maximum block time then the task should block
-				indefinitely, and therefore never time out. */
-				xReturn = pdFALSE;
-			}
-			else
-		#endif
+		pxTCB = prvGetTCBFromHandle( xTask );
 
-		if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
-		{
-			/* The tick count is greater than the time at which
-			vTaskSetTimeout() was called, but has also overflowed since
-			vTaskSetTimeOut() was called.  It must have wrapped all the way
-			around and gone past again. This passed since vTaskSetTimeout()
-			was called. */
-			xReturn = pdTRUE;
-		}
-		else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+		#if portSTACK_GROWTH < 0
 		{
-			/* Not a genuine timeout. Adjust parameters for time remaining. */
-			*pxTicksToWait -= xElapsedTime;
-			vTaskInternalSetTimeOutState( pxTimeOut );
-			xReturn = pdFALSE;
+			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
 		}
-		else
+		#else
 		{
-			*pxTicksToWait = 0;
-			xReturn = pdTRUE;
+			pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
 		}
-	}
-	taskEXIT_CRITICAL();
+		#endif
 
-	return xReturn;
-}
-/*-----------------------------------------------------------*/
+		uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
 
-void vTaskMissedYield( void )
-{
-	xYieldPending = pdTRUE;
-}
+		return uxReturn;
+	}
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
 
-	UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+	UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
 	{
+	TCB_t *pxTCB;
+	uint8_t *pucEndOfStack;
 	UBaseType_t uxReturn;
-	TCB_t const *pxTCB;
 
-		if( xTask != NULL )
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		#if portSTACK_GROWTH < 0
 		{
-			pxTCB = xTask;
-			uxReturn = pxTCB->uxTaskNumber;
+			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
 		}
-		else
+		#else
 		{
-			uxReturn = 0U;
+			pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
 		}
+		#endif
+
+		uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
 
 		return uxReturn;
 	}
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_STACK_PROFILER == 1 )
 
-	void vTaskSetTaskNumber( TaskHandle_t xTask, const UBaseType_t uxHandle )
+	static void prvStackProfilerStep( void )
 	{
-	TCB_t * pxTCB;
+	TCB_t *pxTCB;
+	UBaseType_t uxWords;
 
-		if( xTask != NULL )
+		/* Suspending the scheduler stops the task being deleted while its
+		stack is read. */
+		vTaskSuspendAll();
 		{
-			pxTCB = xTask;
-			pxTCB->uxTaskNumber = uxHandle;
+			if( pxStackProfileCursor == NULL )
+			{
+				pxStackProfileCursor = pxRegisteredTasks;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB = pxStackProfileCursor;
+
+			if( pxTCB != NULL )
+			{
+				for( uxWords = ( UBaseType_t ) 0U; uxWords < ( UBaseType_t ) configSTACK_PROFILER_WORDS_PER_CALL; uxWords++ )
+				{
+					if( pxTCB->uxStackScanIndex >= pxTCB->uxStackFreeWords )
+					{
+						/* The whole unused part still holds the fill value. */
+						pxTCB->uxStackScanIndex = ( configSTACK_DEPTH_TYPE ) 0;
+						pxStackProfileCursor = pxTCB->pxNextRegisteredTask;
+						break;
+					}
+					else if( taskSTACK_WORD( pxTCB, pxTCB->uxStackScanIndex ) != tskSTACK_FILL_WORD )
+					{
+						/* The stack has been used down to this word, which is
+						the new peak.  The next check of this task starts again
+						from the end of the stack. */
+						pxTCB->uxStackFreeWords = pxTCB->uxStackScanIndex;
+						pxTCB->uxStackScanIndex = ( configSTACK_DEPTH_TYPE ) 0;
+						pxStackProfileCursor = pxTCB->pxNextRegisteredTask;
+						break;
+					}
+					else
+					{
+						( pxTCB->uxStackScanIndex )++;
+					}
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
+		( void ) xTaskResumeAll();
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* configUSE_TRACE_FACILITY */
+	UBaseType_t uxTaskGetStackProfile( TaskStackProfile_t * const pxProfileArray, const UBaseType_t uxArraySize )
+	{
+	UBaseType_t uxTask = ( UBaseType_t ) 0U;
+	TCB_t *pxTCB;
+	configSTACK_DEPTH_TYPE uxPeak, uxRecommended;
 
-/*
- * -----------------------------------------------------------
- * The Idle task.
- * ----------------------------------------------------------
- *
- * The portTASK_FUNCTION() macro is used to allow port/compiler specific
- * language extensions.  The equivalent prototype for this function is:
- *
- * void prvIdleTask( void *pvParameters );
- *
- */
-static portTASK_FUNCTION( prvIdleTask, pvParameters )
-{
-	/* Stop warnings. */
-	( void ) pvParameters;
+		vTaskSuspendAll();
+		{
+			for( pxTCB = pxRegisteredTasks; ( pxTCB != NULL ) && ( uxTask < uxArraySize ); pxTCB = pxTCB->pxNextRegisteredTask )
+			{
+				uxPeak = pxTCB->uxStackDepth - pxTCB->uxStackFreeWords;
 
-	/** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
-	SCHEDULER IS STARTED. **/
+				/* Add the margin, then round up so the top of a stack of the
+				recommended size stays aligned. */
+				uxRecommended = uxPeak + ( configSTACK_DEPTH_TYPE ) ( ( ( uint32_t ) uxPeak * ( uint32_t ) configSTACK_PROFILER_MARGIN_PERCENT + 99UL ) / 100UL );
+				uxRecommended = ( configSTACK_DEPTH_TYPE ) ( ( ( uxRecommended + taskSTACK_ALIGNMENT_WORDS - 1U ) / taskSTACK_ALIGNMENT_WORDS ) * taskSTACK_ALIGNMENT_WORDS );
 
-	/* In case a task that has a secure context deletes itself, in which case
-	the idle task is responsible for deleting the task's secure context, if
-	any. */
-	portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
+				pxProfileArray[ uxTask ].xHandle = ( TaskHandle_t ) pxTCB;
+				pxProfileArray[ uxTask ].pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
+				pxProfileArray[ uxTask ].uxStackDepth = pxTCB->uxStackDepth;
+				pxProfileArray[ uxTask ].uxPeakStackUsage = uxPeak;
+				pxProfileArray[ uxTask ].uxRecommendedStackDepth = uxRecommended;
+				uxTask++;
+			}
+		}
+		( void ) xTaskResumeAll();
 
-	for( ;; )
+		return uxTask;
+	}
+
+#endif /* configUSE_STACK_PROFILER */
+/*-----------------------------------------------------------*/
+
+#if ( tskUSE_TASK_REGISTRY == 1 )
+
+	static void prvUnregisterTask( const TCB_t * const pxTCB )
 	{
-		/* See if any tasks have deleted themselves - if so then the idle task
-		is responsible for freeing the deleted task's TCB and stack. */
-		prvCheckTasksWaitingTermination();
+	TCB_t **ppxLink = &pxRegisteredTasks;
 
-		#if ( configUSE_PREEMPTION == 0 )
+		while( *ppxLink != NULL )
 		{
-			/* If we are not using preemption we keep forcing a task switch to
-			see if any other task has become available.  If we are using
-			preemption we don't need to do this as any task becoming available
-			will automatically get the processor anyway. */
-			taskYIELD();
+			if( *ppxLink == pxTCB )
+			{
+				*ppxLink = pxTCB->pxNextRegisteredTask;
+				break;
+			}
+			else
+			{
+				ppxLink = &( ( *ppxLink )->pxNextRegisteredTask );
+			}
 		}
-		#endif /* configUSE_PREEMPTION */
 
-		#if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+		#if ( configUSE_STACK_PROFILER == 1 )
 		{
-			/* When using preemption tasks of equal priority will be
-			timesliced.  If a task that is sharing the idle priority is ready
-			to run then the idle task should yield before the end of the
-			timeslice.
-
-			A critical region is not required here as we are just reading from
-			the list, and an occasional incorrect value will not matter.  If
-			the ready list at the idle priority contains more than one task
-			then a task other than the idle task is ready to execute. */
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+			if( pxStackProfileCursor == pxTCB )
 			{
-				taskYIELD();
+				pxStackProfileCursor = pxTCB->pxNextRegisteredTask;
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+		#endif /* configUSE_STACK_PROFILER */
+	}
 
-		#if ( configUSE_IDLE_HOOK == 1 )
+#endif /* tskUSE_TASK_REGISTRY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WCET_PROFILER == 1 )
+
+	static void prvWcetJobReleased( TCB_t * const pxTCB )
+	{
+	uint32_t ulRunTime, ulJobTime;
+	UBaseType_t uxBucket, x;
+
+		/* Only time in the Running state is added to ulRunTimeCounter, so the
+		difference between two releases leaves out the time the job was
+		preempted or blocked.  The task is normally blocked when it is
+		released, but if it is still running the time since it was switched in
+		has not been added yet. */
+		ulRunTime = pxTCB->ulRunTimeCounter;
+
+		if( pxTCB == pxCurrentTCB )
 		{
-			extern void vApplicationIdleHook( void );
+			ulRunTime += portGET_RUN_TIME_COUNTER_VALUE() - ulTaskSwitchedInTime;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-			/* Call the user defined function from within the idle task.  This
-			allows the application designer to add background functionality
-			without the overhead of a separate task.
-			NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
-			CALL A FUNCTION THAT MIGHT BLOCK. */
-			vApplicationIdleHook();
+		ulJobTime = ulRunTime - pxTCB->ulJobStartRunTime;
+		pxTCB->ulJobStartRunTime = ulRunTime;
+
+		if( ( pxTCB->ulJobCount == 0UL ) || ( ulJobTime < pxTCB->ulMinJobTime ) )
+		{
+			pxTCB->ulMinJobTime = ulJobTime;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif /* configUSE_IDLE_HOOK */
 
-		/* This conditional compilation should use inequality to 0, not equality
-		to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
-		user defined low power mode	implementations require
-		configUSE_TICKLESS_IDLE to be set to a value other than 1. */
-		#if ( configUSE_TICKLESS_IDLE != 0 )
+		if( ulJobTime > pxTCB->ulMaxJobTime )
 		{
-		TickType_t xExpectedIdleTime;
+			pxTCB->ulMaxJobTime = ulJobTime;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-			/* It is not desirable to suspend then resume the scheduler on
-			each iteration of the idle task.  Therefore, a preliminary
-			test of the expected idle time is performed without the
-			scheduler suspended.  The result here is not necessarily
-			valid. */
-			xExpectedIdleTime = prvGetExpectedIdleTime();
+		( pxTCB->ulJobCount )++;
 
-			if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+		/* Widen the buckets until the job fits, merging pairs of buckets so no
+		count is lost.  The buckets therefore always cover the longest job
+		with at least half of them in use. */
+		while( ( ulJobTime >> pxTCB->ucJobHistogramShift ) >= ( uint32_t ) configWCET_HISTOGRAM_BUCKETS )
+		{
+			for( x = 0; x < ( ( UBaseType_t ) configWCET_HISTOGRAM_BUCKETS / 2U ); x++ )
 			{
-				vTaskSuspendAll();
-				{
-					/* Now the scheduler is suspended, the expected idle
-					time can be sampled again, and this time its value can
-					be used. */
-					configASSERT( xNextTaskUnblockTime >= xTickCount );
-					xExpectedIdleTime = prvGetExpectedIdleTime();
-
-					/* Define the following macro to set xExpectedIdleTime to 0
-					if the application does not want
-					portSUPPRESS_TICKS_AND_SLEEP() to be called. */
-					configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
-
-					if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
-					{
-						traceLOW_POWER_IDLE_BEGIN();
-						portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
-						traceLOW_POWER_IDLE_END();
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-				}
-				( void ) xTaskResumeAll();
+				ulRunTime = ( uint32_t ) pxTCB->usJobHistogram[ 2U * x ] + ( uint32_t ) pxTCB->usJobHistogram[ ( 2U * x ) + 1U ];
+				pxTCB->usJobHistogram[ x ] = ( ulRunTime > 0xffffUL ) ? ( uint16_t ) 0xffffU : ( uint16_t ) ulRunTime;
 			}
-			else
+
+			for( ; x < ( UBaseType_t ) configWCET_HISTOGRAM_BUCKETS; x++ )
 			{
-				mtCOVERAGE_TEST_MARKER();
+				pxTCB->usJobHistogram[ x ] = ( uint16_t ) 0U;
 			}
-		}
-		#endif /* configUSE_TICKLESS_IDLE */
-	}
-}
-/*-----------------------------------------------------------*/
-
-#if( configUSE_TICKLESS_IDLE != 0 )
 
-	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
-	{
-	/* The idle task exists in addition to the application tasks. */
-	const UBaseType_t uxNonApplicationTasks = 1;
-	eSleepModeStatus eReturn = eStandardSleep;
+			( pxTCB->ucJobHistogramShift )++;
+		}
 
-		/* This function must be called from a critical section. */
+		uxBucket = ( UBaseType_t ) ( ulJobTime >> pxTCB->ucJobHistogramShift );
 
-		if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+		if( pxTCB->usJobHistogram[ uxBucket ] == ( uint16_t ) 0xffffU )
 		{
-			/* A task was made ready while the scheduler was suspended. */
-			eReturn = eAbortSleep;
+			/* Halve every count rather than saturate, which keeps the shape of
+			the histogram and so the percentiles. */
+			for( x = 0; x < ( UBaseType_t ) configWCET_HISTOGRAM_BUCKETS; x++ )
+			{
+				pxTCB->usJobHistogram[ x ] = ( uint16_t ) ( ( pxTCB->usJobHistogram[ x ] + 1U ) >> 1U );
+			}
 		}
-		else if( xYieldPending != pdFALSE )
+		else
 		{
-			/* A yield was pended while the scheduler was suspended. */
-			eReturn = eAbortSleep;
+			mtCOVERAGE_TEST_MARKER();
 		}
-		else
+
+		( pxTCB->usJobHistogram[ uxBucket ] )++;
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint32_t prvWcetPercentile( const TCB_t * const pxTCB, const UBaseType_t uxPercentile )
+	{
+	uint32_t ulTotal = 0UL, ulRank, ulCount = 0UL, ulReturn;
+	UBaseType_t x;
+
+		for( x = 0; x < ( UBaseType_t ) configWCET_HISTOGRAM_BUCKETS; x++ )
 		{
-			/* If all the tasks are in the suspended list (which might mean they
-			have an infinite block time rather than actually being suspended)
-			then it is safe to turn all clocks off and just wait for external
-			interrupts. */
-			if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+			ulTotal += ( uint32_t ) pxTCB->usJobHistogram[ x ];
+		}
+
+		/* The number of jobs, rounded up, that must be covered. */
+		ulRank = ( ( ulTotal * ( uint32_t ) uxPercentile ) + 99UL ) / 100UL;
+		ulReturn = pxTCB->ulMaxJobTime;
+
+		for( x = 0; x < ( UBaseType_t ) configWCET_HISTOGRAM_BUCKETS; x++ )
+		{
+			ulCount += ( uint32_t ) pxTCB->usJobHistogram[ x ];
+
+			if( ( ulCount >= ulRank ) && ( ulCount > 0UL ) )
 			{
-				eReturn = eNoTasksWaitingTimeout;
+				ulReturn = ( ( ( uint32_t ) x + 1UL ) << pxTCB->ucJobHistogramShift ) - 1UL;
+
+				if( ulReturn > pxTCB->ulMaxJobTime )
+				{
+					ulReturn = pxTCB->ulMaxJobTime;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				break;
 			}
 			else
 			{
@@ -3711,432 +6211,756 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			}
 		}
 
-		return eReturn;
+		return ulReturn;
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*-----------------------------------------------------------*/
+	BaseType_t xTaskGetWcetProfile( TaskHandle_t xTask, TaskWcetProfile_t * const pxProfile )
+	{
+	const TCB_t *pxTCB;
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+		configASSERT( pxProfile );
 
-	void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue )
-	{
-	TCB_t *pxTCB;
+		pxTCB = prvGetTCBFromHandle( xTask );
 
-		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+		taskENTER_CRITICAL();
 		{
-			pxTCB = prvGetTCBFromHandle( xTaskToSet );
-			configASSERT( pxTCB != NULL );
-			pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+			pxProfile->xHandle = ( TaskHandle_t ) pxTCB;
+			pxProfile->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
+			pxProfile->ulJobs = pxTCB->ulJobCount;
+			pxProfile->ulMinExecutionTime = pxTCB->ulMinJobTime;
+			pxProfile->ulMaxExecutionTime = pxTCB->ulMaxJobTime;
+			pxProfile->ulMedianExecutionTime = prvWcetPercentile( pxTCB, ( UBaseType_t ) 50U );
+			pxProfile->ul90thPercentileExecutionTime = prvWcetPercentile( pxTCB, ( UBaseType_t ) 90U );
+			pxProfile->ul99thPercentileExecutionTime = prvWcetPercentile( pxTCB, ( UBaseType_t ) 99U );
+			pxProfile->ulBucketWidth = ( uint32_t ) 1UL << pxTCB->ucJobHistogramShift;
+			memcpy( ( void * ) &( pxProfile->usHistogram[ 0 ] ), ( const void * ) &( pxTCB->usJobHistogram[ 0 ] ), sizeof( pxProfile->usHistogram ) );
 		}
-	}
-
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
-/*-----------------------------------------------------------*/
+		taskEXIT_CRITICAL();
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+		return ( pxTCB->ulJobCount > 0UL ) ? pdPASS : pdFAIL;
+	}
+	/*-----------------------------------------------------------*/
 
-	void *pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery, BaseType_t xIndex )
+	size_t xTaskGetWcetFrame( uint8_t * const pucBuffer, const size_t xBufferLength )
 	{
-	void *pvReturn = NULL;
 	TCB_t *pxTCB;
+	size_t xLength = ( size_t ) 0, xTaskRecords = ( size_t ) 0;
+	uint32_t ulValues[ 6 ];
+	uint16_t usCrc = ( uint16_t ) 0xffffU;
+	UBaseType_t x, uxByte, uxBit;
 
-		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+		/* See task.h for the layout of the frame.  Multi-byte fields are
+		written a byte at a time, little endian, so the layout does not depend
+		on the compiler or the processor. */
+		if( xBufferLength >= ( size_t ) ( taskWCET_FRAME_HEADER_LENGTH + taskWCET_FRAME_CRC_LENGTH ) )
 		{
-			pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-			pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
-		}
-		else
-		{
-			pvReturn = NULL;
-		}
+			vTaskSuspendAll();
+			{
+				pucBuffer[ xLength++ ] = ( uint8_t ) 'W';
+				pucBuffer[ xLength++ ] = ( uint8_t ) 'C';
+				pucBuffer[ xLength++ ] = ( uint8_t ) taskWCET_FRAME_VERSION;
+				pucBuffer[ xLength++ ] = ( uint8_t ) 0U; /* The task count, filled in below. */
+				pucBuffer[ xLength++ ] = ( uint8_t ) configMAX_TASK_NAME_LEN;
+				pucBuffer[ xLength++ ] = ( uint8_t ) configWCET_HISTOGRAM_BUCKETS;
+				for( uxByte = 0; uxByte < 4U; uxByte++ )
+				{
+					pucBuffer[ xLength++ ] = ( uint8_t ) ( ( ( uint32_t ) configWCET_COUNTER_HZ ) >> ( 8U * uxByte ) );
+				}
+				for( uxByte = 0; uxByte < 4U; uxByte++ )
+				{
+					pucBuffer[ xLength++ ] = ( uint8_t ) ( ( ( uint32_t ) configTICK_RATE_HZ ) >> ( 8U * uxByte ) );
+				}
 
-		return pvReturn;
-	}
+				for( pxTCB = pxRegisteredTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextRegisteredTask )
+				{
+					/* Leave room for the CRC and stop at 255 tasks, the most
+					the count byte can hold. */
+					if( ( ( xLength + taskWCET_FRAME_RECORD_LENGTH + taskWCET_FRAME_CRC_LENGTH ) > xBufferLength ) || ( xTaskRecords == ( size_t ) 0xff ) )
+					{
+						break;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
-/*-----------------------------------------------------------*/
+					for( x = 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+					{
+						pucBuffer[ xLength++ ] = ( uint8_t ) pxTCB->pcTaskName[ x ];
+					}
 
-#if ( portUSING_MPU_WRAPPERS == 1 )
+					#if ( configUSE_EDF_SCHEDULER == 1 )
+					{
+						ulValues[ 0 ] = ( uint32_t ) pxTCB->xTaskPeriod;
+					}
+					#else
+					{
+						ulValues[ 0 ] = 0UL;
+					}
+					#endif
+					ulValues[ 1 ] = pxTCB->ulJobCount;
+					ulValues[ 2 ] = pxTCB->ulMinJobTime;
+					ulValues[ 3 ] = pxTCB->ulMaxJobTime;
+					ulValues[ 4 ] = prvWcetPercentile( pxTCB, ( UBaseType_t ) 99U );
+					ulValues[ 5 ] = prvWcetPercentile( pxTCB, ( UBaseType_t ) 90U );
 
-	void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify, const MemoryRegion_t * const xRegions )
-	{
-	TCB_t *pxTCB;
+					for( x = 0; x < ( UBaseType_t ) ( sizeof( ulValues ) / sizeof( ulValues[ 0 ] ) ); x++ )
+					{
+						for( uxByte = 0; uxByte < 4U; uxByte++ )
+						{
+							pucBuffer[ xLength++ ] = ( uint8_t ) ( ulValues[ x ] >> ( 8U * uxByte ) );
+						}
+					}
 
-		/* If null is passed in here then we are modifying the MPU settings of
-		the calling task. */
-		pxTCB = prvGetTCBFromHandle( xTaskToModify );
+					pucBuffer[ xLength++ ] = pxTCB->ucJobHistogramShift;
 
-		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
-	}
+					for( x = 0; x < ( UBaseType_t ) configWCET_HISTOGRAM_BUCKETS; x++ )
+					{
+						pucBuffer[ xLength++ ] = ( uint8_t ) pxTCB->usJobHistogram[ x ];
+						pucBuffer[ xLength++ ] = ( uint8_t ) ( pxTCB->usJobHistogram[ x ] >> 8U );
+					}
 
-#endif /* portUSING_MPU_WRAPPERS */
-/*-----------------------------------------------------------*/
+					xTaskRecords++;
+				}
+			}
+			( void ) xTaskResumeAll();
 
-static void prvInitialiseTaskLists( void )
-{
-UBaseType_t uxPriority;
+			pucBuffer[ 3 ] = ( uint8_t ) xTaskRecords;
 
-	for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
-	{
-		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
-	}
+			/* CRC-16/CCITT-FALSE over everything before it. */
+			for( x = 0; x < ( UBaseType_t ) xLength; x++ )
+			{
+				usCrc ^= ( uint16_t ) ( ( uint16_t ) pucBuffer[ x ] << 8U );
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
-	vListInitialise( &xPendingReadyList );
+				for( uxBit = 0; uxBit < 8U; uxBit++ )
+				{
+					if( ( usCrc & 0x8000U ) != 0U )
+					{
+						usCrc = ( uint16_t ) ( ( uint16_t ) ( usCrc << 1U ) ^ 0x1021U );
+					}
+					else
+					{
+						usCrc = ( uint16_t ) ( usCrc << 1U );
+					}
+				}
+			}
 
-	#if ( configUSE_EDF_SCHEDULER == 1 )
-	{
-		vListInitialise(&xReadyTasksListEDF);
-	}
-	#endif /* configUSE_EDF_SCHEDULER */
-	
-	#if ( INCLUDE_vTaskDelete == 1 )
-	{
-		vListInitialise( &xTasksWaitingTermination );
-	}
-	#endif /* INCLUDE_vTaskDelete */
+			pucBuffer[ xLength++ ] = ( uint8_t ) usCrc;
+			pucBuffer[ xLength++ ] = ( uint8_t ) ( usCrc >> 8U );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-	#if ( INCLUDE_vTaskSuspend == 1 )
-	{
-		vListInitialise( &xSuspendedTaskList );
+		return xLength;
 	}
-	#endif /* INCLUDE_vTaskSuspend */
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
-}
+#endif /* configUSE_WCET_PROFILER */
 /*-----------------------------------------------------------*/
 
-static void prvCheckTasksWaitingTermination( void )
-{
-
-	/** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+#if ( INCLUDE_vTaskDelete == 1 )
 
-	#if ( INCLUDE_vTaskDelete == 1 )
+	static void prvDeleteTCB( TCB_t *pxTCB )
 	{
-		TCB_t *pxTCB;
+		/* This call is required specifically for the TriCore port.  It must be
+		above the vPortFree() calls.  The call is also used by ports/demos that
+		want to allocate and clean RAM statically. */
+		portCLEAN_UP_TCB( pxTCB );
 
-		/* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
-		being called too often in the idle task. */
-		while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+		/* Free up the memory allocated by the scheduler for the task.  It is up
+		to the task to free any memory allocated at the application level.
+		See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
+		for additional information. */
+		#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		{
-			taskENTER_CRITICAL();
+			_reclaim_reent( &( pxTCB->xNewLib_reent ) );
+		}
+		#endif /* configUSE_NEWLIB_REENTRANT */
+
+		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+		{
+			/* The task can only have been allocated dynamically - free both
+			the stack and TCB. */
+			vPortFree( pxTCB->pxStack );
+			vPortFree( pxTCB );
+		}
+		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+		{
+			/* The task could have been allocated statically or dynamically, so
+			check what was statically allocated before trying to free the
+			memory. */
+			if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
 			{
-				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-				--uxCurrentNumberOfTasks;
-				--uxDeletedTasksWaitingCleanUp;
+				/* Both the stack and TCB were allocated dynamically, so both
+				must be freed. */
+				vPortFree( pxTCB->pxStack );
+				vPortFree( pxTCB );
+			}
+			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+			{
+				/* Only the stack was statically allocated, so the TCB is the
+				only memory that must be freed. */
+				vPortFree( pxTCB );
+			}
+			else
+			{
+				/* Neither the stack nor the TCB were allocated dynamically, so
+				nothing needs to be freed. */
+				configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB	);
+				mtCOVERAGE_TEST_MARKER();
 			}
-			taskEXIT_CRITICAL();
-
-			prvDeleteTCB( pxTCB );
 		}
+		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 	}
-	#endif /* INCLUDE_vTaskDelete */
-}
+
+#endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_DELAY_WHEEL == 1 )
 
-	void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace, eTaskState eState )
+	static void prvResetNextTaskUnblockTime( void )
 	{
-	TCB_t *pxTCB;
-
-		/* xTask is NULL then get the state of the calling task. */
-		pxTCB = prvGetTCBFromHandle( xTask );
+	TickType_t xNextEvent = ( TickType_t ) 0U;
+	BaseType_t xFound;
 
-		pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
-		pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName [ 0 ] );
-		pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
-		pxTaskStatus->pxStackBase = pxTCB->pxStack;
-		pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+		xFound = prvDelayWheelNextEvent( &xNextEvent );
+		prvDelayWheelSetNextUnblockTime( xFound, xNextEvent );
+	}
+	/*-----------------------------------------------------------*/
 
-		#if ( configUSE_MUTEXES == 1 )
+	static void prvDelayWheelSetNextUnblockTime( const BaseType_t xFound, const TickType_t xNextEvent )
+	{
+		if( xFound == pdFALSE )
 		{
-			pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+			/* The wheel is empty.  Set xNextTaskUnblockTime to the maximum
+			possible value so it is	extremely unlikely that the
+			if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+			there is a task in the wheel. */
+			xNextTaskUnblockTime = portMAX_DELAY;
 		}
-		#else
+		else if( ( xNextEvent - xDelayWheelTime ) <= ( xTickCount - xDelayWheelTime ) )
 		{
-			pxTaskStatus->uxBasePriority = 0;
+			/* vTaskStepTick() moved the tick count past the slot.  Process it
+			on the next tick. */
+			xNextTaskUnblockTime = xTickCount;
 		}
-		#endif
-
-		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		else if( xNextEvent < xTickCount )
 		{
-			pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+			/* The next slot is processed after the tick count overflows.
+			xNextTaskUnblockTime is recalculated when it does. */
+			xNextTaskUnblockTime = portMAX_DELAY;
 		}
-		#else
+		else
 		{
-			pxTaskStatus->ulRunTimeCounter = 0;
+			xNextTaskUnblockTime = xNextEvent;
 		}
-		#endif
-
-		/* Obtaining the task state is a little fiddly, so is only done if the
-		value of eState passed into this function is eInvalid - otherwise the
-		state is just set to whatever is passed in. */
-		if( eState != eInvalid )
-		{
-			if( pxTCB == pxCurrentTCB )
-			{
-				pxTaskStatus->eCurrentState = eRunning;
-			}
-			else
-			{
-				pxTaskStatus->eCurrentState = eState;
+	}
 
-				#if ( INCLUDE_vTaskSuspend == 1 )
-				{
-					/* If the task is in the suspended list then there is a
-					chance it is actually just blocked indefinitely - so really
-					it should be reported as being in the Blocked state. */
-					if( eState == eSuspended )
-					{
-						vTaskSuspendAll();
-						{
-							if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-							{
-								pxTaskStatus->eCurrentState = eBlocked;
-							}
-						}
-						( void ) xTaskResumeAll();
-					}
-				}
-				#endif /* INCLUDE_vTaskSuspend */
-			}
+#else
+
+	static void prvResetNextTaskUnblockTime( void )
+	{
+	TCB_t *pxTCB;
+
+		if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+		{
+			/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+			the maximum possible value so it is	extremely unlikely that the
+			if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+			there is an item in the delayed list. */
+			xNextTaskUnblockTime = portMAX_DELAY;
 		}
 		else
 		{
-			pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
+			/* The new current delayed list is not empty, get the value of
+			the item at the head of the delayed list.  This is the time at
+			which the task at the head of the delayed list should be removed
+			from the Blocked state. */
+			( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
 		}
+	}
 
-		/* Obtaining the stack space takes some time, so the xGetFreeStackSpace
-		parameter is provided to allow it to be skipped. */
-		if( xGetFreeStackSpace != pdFALSE )
+#endif /* configUSE_DELAY_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskGetHandle == 1 ) )
+
+	static List_t * prvGetDelayedList( const UBaseType_t uxIndex )
+	{
+	List_t *pxList;
+
+		configASSERT( uxIndex < taskDELAYED_LIST_COUNT );
+
+		#if ( configUSE_DELAY_WHEEL == 1 )
 		{
-			#if ( portSTACK_GROWTH > 0 )
+			if( uxIndex < ( taskDELAYED_LIST_COUNT - ( UBaseType_t ) 1U ) )
 			{
-				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+				pxList = &( xDelayWheel[ uxIndex / taskDELAY_WHEEL_SLOTS ][ uxIndex % taskDELAY_WHEEL_SLOTS ] );
 			}
-			#else
+			else
 			{
-				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+				pxList = &xDelayWheelFarList;
 			}
-			#endif
 		}
-		else
+		#else
 		{
-			pxTaskStatus->usStackHighWaterMark = 0;
+			if( uxIndex == ( UBaseType_t ) 0U )
+			{
+				pxList = pxDelayedTaskList;
+			}
+			else
+			{
+				pxList = pxOverflowDelayedTaskList;
+			}
 		}
+		#endif /* configUSE_DELAY_WHEEL */
+
+		return pxList;
 	}
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskGetHandle == 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+static BaseType_t prvUnblockDelayedTask( TCB_t * const pxTCB )
+{
+BaseType_t xSwitchRequired = pdFALSE;
 
-	static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t *pxTaskStatusArray, List_t *pxList, eTaskState eState )
+	( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+	/* Is the task waiting on an event also?  If so remove it from the event
+	list. */
+	if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
 	{
-	configLIST_VOLATILE TCB_t *pxNextTCB, *pxFirstTCB;
-	UBaseType_t uxTask = 0;
+		( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
 
-		if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
-		{
-			listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    // h_edf_10. calculate new deadline then add task to EDF Ready list
+    pxTCB->xJobDeadline = taskEDF_TIME_NOW() + pxTCB->xRelativeDeadline;
+#endif
 
-			/* Populate an TaskStatus_t structure within the
-			pxTaskStatusArray array for each task that is referenced from
-			pxList.  See the definition of TaskStatus_t in task.h for the
-			meaning of each TaskStatus_t structure member. */
-			do
-			{
-				listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-				vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
-				uxTask++;
-			} while( pxNextTCB != pxFirstTCB );
+#if ( configUSE_EDF_SLACK_STEALING == 1 )
+    /* A new job has been released. */
+    pxTCB->xJobExecutionTime = ( TickType_t ) 0U;
+#endif
+
+#if ( configUSE_WCET_PROFILER == 1 )
+	prvWcetJobReleased( pxTCB );
+#endif
+
+#if( configUSE_EDF_SCHEDULER == 1 )
+    /* Jobs released on the same tick are merged into the ready list together,
+    and the tick interrupt decides then whether the running job is preempted. */
+	xSwitchRequired = prvStageReadyTask( pxTCB, &xStagedReadyList );
+#else
+    /* Place the unblocked task into the appropriate ready list. */
+	prvAddTaskToReadyList( pxTCB );
+
+    /* A task being unblocked cannot cause an immediate context switch if
+    preemption is turned off. */
+	#if (  configUSE_PREEMPTION == 1 )
+	{
+		/* Preemption is on, but a context switch should only be performed if
+		the unblocked task has a priority that is equal to or higher than the
+		currently executing task. */
+		if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+		{
+			xSwitchRequired = pdTRUE;
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
-
-		return uxTask;
 	}
+	#endif /* configUSE_PREEMPTION */
+#endif /* configUSE_EDF_SCHEDULER */
 
-#endif /* configUSE_TRACE_FACILITY */
+	return xSwitchRequired;
+}
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( configUSE_DELAY_WHEEL == 1 )
 
-	static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+	static TickType_t prvDelayWheelPlace( ListItem_t * const pxStateListItem, const TickType_t xTimeToWake )
 	{
-	uint32_t ulCount = 0U;
+	const TickType_t xTicksAhead = xTimeToWake - xDelayWheelTime;
+	UBaseType_t uxLevel, uxSlot;
 
-		while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+		/* A task that is due when its slot is processed is unblocked then, so
+		a task can only be placed in a slot that has not been processed yet. */
+		configASSERT( xTicksAhead != ( TickType_t ) 0U );
+
+		/* Level uxLevel holds the tasks that wake between
+		2^( uxLevel * configDELAY_WHEEL_SLOT_BITS ) and
+		2^( ( uxLevel + 1 ) * configDELAY_WHEEL_SLOT_BITS ) ticks ahead, so
+		each of its slots is processed once before its tasks are due. */
+		for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configDELAY_WHEEL_LEVELS; uxLevel++ )
 		{
-			pucStackByte -= portSTACK_GROWTH;
-			ulCount++;
+			if( ( xTicksAhead >> taskDELAY_WHEEL_LEVEL_SHIFT( uxLevel + ( UBaseType_t ) 1U ) ) == ( TickType_t ) 0U )
+			{
+				uxSlot = ( UBaseType_t ) ( ( xTimeToWake >> taskDELAY_WHEEL_LEVEL_SHIFT( uxLevel ) ) & taskDELAY_WHEEL_SLOT_MASK );
+				vListInsertEnd( &( xDelayWheel[ uxLevel ][ uxSlot ] ), pxStateListItem );
+				ulDelayWheelOccupied[ uxLevel ] |= ( uint32_t ) 1UL << uxSlot;
+
+				/* The slot comes round when the bits of the tick count below
+				this level are next zero. */
+				return ( xTimeToWake >> taskDELAY_WHEEL_LEVEL_SHIFT( uxLevel ) ) << taskDELAY_WHEEL_LEVEL_SHIFT( uxLevel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 
-		ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+		/* Beyond the range of the wheel.  The far list is looked at each time
+		the top level completes a rotation. */
+		vListInsertEnd( &xDelayWheelFarList, pxStateListItem );
 
-		return ( configSTACK_DEPTH_TYPE ) ulCount;
+		return ( ( xDelayWheelTime >> taskDELAY_WHEEL_RANGE_SHIFT ) + ( TickType_t ) 1U ) << taskDELAY_WHEEL_RANGE_SHIFT;
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
-
-	/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
-	same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
-	user to determine the return type.  It gets around the problem of the value
-	overflowing on 8-bit types without breaking backward compatibility for
-	applications that expect an 8-bit return type. */
-	configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+	static void prvDelayWheelInsert( ListItem_t * const pxStateListItem, TickType_t xTimeToWake )
 	{
-	TCB_t *pxTCB;
-	uint8_t *pucEndOfStack;
-	configSTACK_DEPTH_TYPE uxReturn;
-
-		/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
-		the same except for their return type.  Using configSTACK_DEPTH_TYPE
-		allows the user to determine the return type.  It gets around the
-		problem of the value overflowing on 8-bit types without breaking
-		backward compatibility for applications that expect an 8-bit return
-		type. */
+	TickType_t xEvent;
 
-		pxTCB = prvGetTCBFromHandle( xTask );
+		/* The wheel time only lags the tick count on ticks that needed no
+		processing, so while the next event is still in the future the wheel
+		can be brought up to date for free.  Placing the task relative to the
+		current tick keeps it on the lowest level possible. */
+		if( xNextTaskUnblockTime > xTickCount )
+		{
+			xDelayWheelTime = xTickCount;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-		#if portSTACK_GROWTH < 0
+		/* As with the delayed lists, a task that asks to wake on the current
+		tick wakes on the next one. */
+		if( xTimeToWake == xDelayWheelTime )
 		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+			xTimeToWake++;
 		}
-		#else
+		else
 		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif
 
-		uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+		xEvent = prvDelayWheelPlace( pxStateListItem, xTimeToWake );
 
-		return uxReturn;
+		/* An event that is numerically before the tick count is after the
+		tick count overflows, and is picked up then. */
+		if( ( xEvent >= xTickCount ) && ( xEvent < xNextTaskUnblockTime ) )
+		{
+			xNextTaskUnblockTime = xEvent;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
-/*-----------------------------------------------------------*/
+	static BaseType_t prvDelayWheelFirstSlot( const UBaseType_t uxLevel, UBaseType_t * const puxSlot, TickType_t * const pxEvent )
+	{
+	UBaseType_t uxFirst, uxOffset;
+	uint32_t ulOccupied = ulDelayWheelOccupied[ uxLevel ];
+	TickType_t xRotation;
+	BaseType_t xFound = pdFALSE;
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+		if( ulOccupied != ( uint32_t ) 0UL )
+		{
+			/* Slots are processed in order starting from the one after the
+			wheel time, so rotate the occupied bits to put that slot at bit 0
+			and count up to the first set bit. */
+			xRotation = xDelayWheelTime >> taskDELAY_WHEEL_LEVEL_SHIFT( uxLevel );
+			uxFirst = ( UBaseType_t ) ( ( xRotation + ( TickType_t ) 1U ) & taskDELAY_WHEEL_SLOT_MASK );
 
-	UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
-	{
-	TCB_t *pxTCB;
-	uint8_t *pucEndOfStack;
-	UBaseType_t uxReturn;
+			if( uxFirst != ( UBaseType_t ) 0U )
+			{
+				ulOccupied = ( ulOccupied >> uxFirst ) | ( ulOccupied << ( taskDELAY_WHEEL_SLOTS - uxFirst ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-		pxTCB = prvGetTCBFromHandle( xTask );
+			/* Isolate the lowest set bit, then look its position up with a de
+			Bruijn sequence. */
+			ulOccupied &= ( uint32_t ) 0UL - ulOccupied;
+			uxOffset = ( UBaseType_t ) ucDelayWheelBitPosition[ ( uint32_t ) ( ulOccupied * 0x077CB531UL ) >> 27 ];
 
-		#if portSTACK_GROWTH < 0
-		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+			*puxSlot = ( uxFirst + uxOffset ) & ( UBaseType_t ) taskDELAY_WHEEL_SLOT_MASK;
+			*pxEvent = ( xRotation + ( TickType_t ) 1U + ( TickType_t ) uxOffset ) << taskDELAY_WHEEL_LEVEL_SHIFT( uxLevel );
+			xFound = pdTRUE;
 		}
-		#else
+		else
 		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif
 
-		uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
-
-		return uxReturn;
+		return xFound;
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
-/*-----------------------------------------------------------*/
+	static BaseType_t prvDelayWheelNextEvent( TickType_t * const pxNextEvent )
+	{
+	UBaseType_t uxLevel, uxSlot;
+	TickType_t xEvent = ( TickType_t ) 0U, xTicksAhead = portMAX_DELAY;
+	BaseType_t xFound = pdFALSE;
 
-#if ( INCLUDE_vTaskDelete == 1 )
+		for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configDELAY_WHEEL_LEVELS; uxLevel++ )
+		{
+			if( prvDelayWheelFirstSlot( uxLevel, &uxSlot, &xEvent ) != pdFALSE )
+			{
+				if( ( xEvent - xDelayWheelTime ) <= xTicksAhead )
+				{
+					xTicksAhead = xEvent - xDelayWheelTime;
+					*pxNextEvent = xEvent;
+					xFound = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
 
-	static void prvDeleteTCB( TCB_t *pxTCB )
-	{
-		/* This call is required specifically for the TriCore port.  It must be
-		above the vPortFree() calls.  The call is also used by ports/demos that
-		want to allocate and clean RAM statically. */
-		portCLEAN_UP_TCB( pxTCB );
+		if( listLIST_IS_EMPTY( &xDelayWheelFarList ) == pdFALSE )
+		{
+			xEvent = ( ( xDelayWheelTime >> taskDELAY_WHEEL_RANGE_SHIFT ) + ( TickType_t ) 1U ) << taskDELAY_WHEEL_RANGE_SHIFT;
 
-		/* Free up the memory allocated by the scheduler for the task.  It is up
-		to the task to free any memory allocated at the application level.
-		See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
-		for additional information. */
-		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+			if( ( xEvent - xDelayWheelTime ) <= xTicksAhead )
+			{
+				*pxNextEvent = xEvent;
+				xFound = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
 		{
-			_reclaim_reent( &( pxTCB->xNewLib_reent ) );
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif /* configUSE_NEWLIB_REENTRANT */
 
-		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
-		{
-			/* The task can only have been allocated dynamically - free both
-			the stack and TCB. */
-			vPortFree( pxTCB->pxStack );
-			vPortFree( pxTCB );
-		}
-		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
-		{
-			/* The task could have been allocated statically or dynamically, so
-			check what was statically allocated before trying to free the
-			memory. */
-			if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+		return xFound;
+	}
+	/*-----------------------------------------------------------*/
+
+	#if ( configUSE_TICKLESS_IDLE != 0 )
+
+		static TickType_t prvDelayWheelNextWakeTime( void )
+		{
+		UBaseType_t uxLevel, uxSlot;
+		TickType_t xEvent = ( TickType_t ) 0U, xTicksAhead = portMAX_DELAY, xSlotTicksAhead, xWakeTime;
+		List_t const * pxList;
+		ListItem_t const * pxListItem;
+		ListItem_t const * pxListEnd;
+		BaseType_t xFound = pdFALSE;
+
+			/* Only the first occupied slot of each level can hold the earliest
+			task of that level. */
+			for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configDELAY_WHEEL_LEVELS; uxLevel++ )
+			{
+				if( prvDelayWheelFirstSlot( uxLevel, &uxSlot, &xEvent ) != pdFALSE )
+				{
+					/* The tasks of a level 0 slot are due on the tick it is
+					processed, so the slot time is exact.  Those of a higher
+					level are due anywhere in the range the slot covers, so look
+					for the earliest.  Interrupts only leave the slots alone
+					while the scheduler is suspended, and a slot left empty by
+					tasks that were unblocked early keeps the slot time.  Both
+					are early but safe. */
+					xSlotTicksAhead = xEvent - xDelayWheelTime;
+					pxList = &( xDelayWheel[ uxLevel ][ uxSlot ] );
+
+					if( ( uxLevel > ( UBaseType_t ) 0U ) && ( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE ) && ( listLIST_IS_EMPTY( pxList ) == pdFALSE ) )
+					{
+						xSlotTicksAhead = portMAX_DELAY;
+						pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+
+						for( pxListItem = listGET_HEAD_ENTRY( pxList ); pxListItem != pxListEnd; pxListItem = listGET_NEXT( pxListItem ) )
+						{
+							if( ( listGET_LIST_ITEM_VALUE( pxListItem ) - xDelayWheelTime ) < xSlotTicksAhead )
+							{
+								xSlotTicksAhead = listGET_LIST_ITEM_VALUE( pxListItem ) - xDelayWheelTime;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					if( xSlotTicksAhead < xTicksAhead )
+					{
+						xTicksAhead = xSlotTicksAhead;
+						xFound = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			/* The far list can be long, so it is not walked.  Its tasks are due
+			after the top level next completes a rotation. */
+			if( listLIST_IS_EMPTY( &xDelayWheelFarList ) == pdFALSE )
+			{
+				xEvent = ( ( xDelayWheelTime >> taskDELAY_WHEEL_RANGE_SHIFT ) + ( TickType_t ) 1U ) << taskDELAY_WHEEL_RANGE_SHIFT;
+
+				if( ( xEvent - xDelayWheelTime ) < xTicksAhead )
+				{
+					xTicksAhead = xEvent - xDelayWheelTime;
+					xFound = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xWakeTime = xDelayWheelTime + xTicksAhead;
+
+			if( xFound == pdFALSE )
 			{
-				/* Both the stack and TCB were allocated dynamically, so both
-				must be freed. */
-				vPortFree( pxTCB->pxStack );
-				vPortFree( pxTCB );
+				xWakeTime = portMAX_DELAY;
 			}
-			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+			else if( xTicksAhead <= ( xTickCount - xDelayWheelTime ) )
 			{
-				/* Only the stack was statically allocated, so the TCB is the
-				only memory that must be freed. */
-				vPortFree( pxTCB );
+				/* A task is already due, and is unblocked on the next tick. */
+				xWakeTime = xTickCount;
+			}
+			else if( xWakeTime < xTickCount )
+			{
+				/* Due after the tick count overflows. */
+				xWakeTime = portMAX_DELAY;
 			}
 			else
 			{
-				/* Neither the stack nor the TCB were allocated dynamically, so
-				nothing needs to be freed. */
-				configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB	);
 				mtCOVERAGE_TEST_MARKER();
 			}
-		}
-		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-	}
 
-#endif /* INCLUDE_vTaskDelete */
-/*-----------------------------------------------------------*/
+			return xWakeTime;
+		}
 
-static void prvResetNextTaskUnblockTime( void )
-{
-TCB_t *pxTCB;
+	#endif /* configUSE_TICKLESS_IDLE */
+	/*-----------------------------------------------------------*/
 
-	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-	{
-		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-		the maximum possible value so it is	extremely unlikely that the
-		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-		there is an item in the delayed list. */
-		xNextTaskUnblockTime = portMAX_DELAY;
-	}
-	else
+	static BaseType_t prvDelayWheelAdvance( const TickType_t xTimeNow )
 	{
-		/* The new current delayed list is not empty, get the value of
-		the item at the head of the delayed list.  This is the time at
-		which the task at the head of the delayed list should be removed
-		from the Blocked state. */
-		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+	TickType_t xEvent = ( TickType_t ) 0U;
+	List_t *pxList;
+	TCB_t *pxTCB;
+	UBaseType_t uxLevel, uxSlot, uxItems;
+	BaseType_t xSwitchRequired = pdFALSE, xFound;
+
+		for( xFound = prvDelayWheelNextEvent( &xEvent );
+			 ( xFound != pdFALSE ) && ( ( xEvent - xDelayWheelTime ) <= ( xTimeNow - xDelayWheelTime ) );
+			 xFound = prvDelayWheelNextEvent( &xEvent ) )
+		{
+			xDelayWheelTime = xEvent;
+
+			/* Cascade every level whose slot comes round on this tick, lowest
+			first, so the tasks from each slot are spread over the levels
+			below it.  A level only comes round when every level below it
+			has too, and the far list when the top level has. */
+			for( uxLevel = ( UBaseType_t ) 1U; uxLevel <= ( UBaseType_t ) configDELAY_WHEEL_LEVELS; uxLevel++ )
+			{
+				if( ( xEvent & ( ( ( TickType_t ) 1U << taskDELAY_WHEEL_LEVEL_SHIFT( uxLevel ) ) - ( TickType_t ) 1U ) ) != ( TickType_t ) 0U )
+				{
+					break;
+				}
+				else if( uxLevel < ( UBaseType_t ) configDELAY_WHEEL_LEVELS )
+				{
+					uxSlot = ( UBaseType_t ) ( ( xEvent >> taskDELAY_WHEEL_LEVEL_SHIFT( uxLevel ) ) & taskDELAY_WHEEL_SLOT_MASK );
+					ulDelayWheelOccupied[ uxLevel ] &= ~( ( uint32_t ) 1UL << uxSlot );
+					pxList = &( xDelayWheel[ uxLevel ][ uxSlot ] );
+				}
+				else
+				{
+					pxList = &xDelayWheelFarList;
+				}
+
+				/* Tasks that are still out of range go back on the end of
+				the far list, so only visit the tasks that were there at the
+				start. */
+				for( uxItems = listCURRENT_LIST_LENGTH( pxList ); uxItems > ( UBaseType_t ) 0U; uxItems-- )
+				{
+					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+					/* A task due on this tick lands in the level 0 slot that
+					is processed below. */
+					if( listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) == xEvent )
+					{
+						uxSlot = ( UBaseType_t ) ( xEvent & taskDELAY_WHEEL_SLOT_MASK );
+						vListInsertEnd( &( xDelayWheel[ 0 ][ uxSlot ] ), &( pxTCB->xStateListItem ) );
+					}
+					else
+					{
+						( void ) prvDelayWheelPlace( &( pxTCB->xStateListItem ), listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) );
+					}
+				}
+			}
+
+			/* Unblock the tasks that are due on this tick. */
+			uxSlot = ( UBaseType_t ) ( xEvent & taskDELAY_WHEEL_SLOT_MASK );
+			ulDelayWheelOccupied[ 0 ] &= ~( ( uint32_t ) 1UL << uxSlot );
+			pxList = &( xDelayWheel[ 0 ][ uxSlot ] );
+
+			while( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+			{
+				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+				if( prvUnblockDelayedTask( pxTCB ) != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+
+		/* Nothing else needs processing before xTimeNow, so the event found
+		last is still the next one. */
+		xDelayWheelTime = xTimeNow;
+		prvDelayWheelSetNextUnblockTime( xFound, xEvent );
+
+		return xSwitchRequired;
 	}
-}
+
+#endif /* configUSE_DELAY_WHEEL */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
@@ -4774,6 +7598,63 @@ TCB_t *pxTCB;
 #endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_STACK_PROFILER == 1 ) && ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	void vTaskGetStackProfileReport( char *pcWriteBuffer )
+	{
+	TaskStackProfile_t *pxProfileArray;
+	UBaseType_t uxArraySize, x;
+	uint32_t ulTotalDepth = 0UL, ulTotalRecommended = 0UL;
+
+		/*
+		 * PLEASE NOTE:
+		 *
+		 * This function is provided for convenience only, in the same way as
+		 * vTaskList(), and has the same dependency on sprintf().  Production
+		 * systems should call uxTaskGetStackProfile() directly.
+		 */
+
+		/* Make sure the write buffer does not contain a string. */
+		*pcWriteBuffer = ( char ) 0x00;
+
+		/* Take a snapshot of the number of tasks in case it changes while this
+		function is executing. */
+		uxArraySize = uxCurrentNumberOfTasks;
+
+		pxProfileArray = pvPortMalloc( uxArraySize * sizeof( TaskStackProfile_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+		if( pxProfileArray != NULL )
+		{
+			uxArraySize = uxTaskGetStackProfile( pxProfileArray, uxArraySize );
+
+			/* A line per task giving the stack size, the peak usage and the
+			recommended size, all in words. */
+			for( x = 0; x < uxArraySize; x++ )
+			{
+				pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxProfileArray[ x ].pcTaskName );
+				sprintf( pcWriteBuffer, "\t%u\t%u\t%u\r\n", ( unsigned int ) pxProfileArray[ x ].uxStackDepth, ( unsigned int ) pxProfileArray[ x ].uxPeakStackUsage, ( unsigned int ) pxProfileArray[ x ].uxRecommendedStackDepth ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+				pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+
+				ulTotalDepth += ( uint32_t ) pxProfileArray[ x ].uxStackDepth;
+				ulTotalRecommended += ( uint32_t ) pxProfileArray[ x ].uxRecommendedStackDepth;
+			}
+
+			/* Finish with the totals, so the memory the recommended sizes
+			would free can be read off directly. */
+			pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, "Total" );
+			sprintf( pcWriteBuffer, "\t%u\t\t%u\r\n", ( unsigned int ) ulTotalDepth, ( unsigned int ) ulTotalRecommended ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+
+			vPortFree( pxProfileArray );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* ( ( configUSE_STACK_PROFILER == 1 ) && ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 TickType_t uxTaskResetEventItemValue( void )
 {
 TickType_t uxReturn;
@@ -4807,17 +7688,34 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
+			#if ( configUSE_EDF_SCHEDULER == 1 )
+			{
+				/* A sporadic task that was released again while it ran
+				starts its next job here. */
+				if( uxIndexToWaitOn == tskDEFAULT_INDEX_TO_NOTIFY )
+				{
+					prvStartPendingRelease();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_SCHEDULER */
+
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4845,17 +7743,32 @@ TickType_t uxReturn;
 		taskENTER_CRITICAL();
 		{
 			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] = 0UL;
+
+					#if ( configUSE_EDF_SCHEDULER == 1 )
+					{
+						/* The job just started serves every release that
+						was still waiting. */
+						if( uxIndexToWaitOn == tskDEFAULT_INDEX_TO_NOTIFY )
+						{
+							pxCurrentTCB->uxPendingReleases = ( UBaseType_t ) 0U;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_EDF_SCHEDULER */
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] = ulReturn - ( uint32_t ) 1;
 				}
 			}
 			else
@@ -4863,7 +7776,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4875,22 +7788,24 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4923,14 +7838,14 @@ TickType_t uxReturn;
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
 			}
 
-			/* If ucNotifyValue is set then either the task never entered the
+			/* If ucNotifyState is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4939,11 +7854,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4955,44 +7870,45 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 		pxTCB = xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -5010,7 +7926,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
 
 					break;
 			}
@@ -5069,7 +7985,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -5077,6 +7993,7 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -5102,30 +8019,30 @@ TickType_t uxReturn;
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -5143,7 +8060,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
 					break;
 			}
 
@@ -5198,13 +8115,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -5228,12 +8146,12 @@ TickType_t uxReturn;
 
 		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
 			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
@@ -5282,22 +8200,147 @@ TickType_t uxReturn;
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
+
+	BaseType_t xTaskReleaseSporadicFromISR( TaskHandle_t xTaskToRelease, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	TCB_t * pxTCB;
+	uint8_t ucOriginalNotifyState;
+	UBaseType_t uxSavedInterruptStatus;
+	TickType_t xTimeNow, xDeferral, xRelease;
+	BaseType_t xReturn = pdFALSE;
+
+		configASSERT( xTaskToRelease );
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		pxTCB = xTaskToRelease;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			/* A release that comes sooner than the minimum inter-arrival time
+			after the previous one would break the analysis the task set was
+			admitted with.  Count it, and release the job at the earliest time
+			the task model allows instead, which defers its deadline. */
+			xTimeNow = taskEDF_TIME_NOW();
+			xDeferral = prvTimeToNextArrival( pxTCB, xTimeNow );
+
+			if( xDeferral != ( TickType_t ) 0U )
+			{
+				( pxTCB->uxInterArrivalViolations )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xRelease = xTimeNow + xDeferral;
+			pxTCB->xLastArrival = xTimeNow;
+			pxTCB->xLastRelease = xRelease;
+			pxTCB->ucReleasedFromISR = pdTRUE;
+
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ tskDEFAULT_INDEX_TO_NOTIFY ];
+			pxTCB->ucNotifyState[ tskDEFAULT_INDEX_TO_NOTIFY ] = taskNOTIFICATION_RECEIVED;
+
+			/* Count the release as a give, so a release that arrives while
+			the previous job is still running is not lost. */
+			( pxTCB->ulNotifiedValue[ tskDEFAULT_INDEX_TO_NOTIFY ] )++;
+
+			traceTASK_NOTIFY_GIVE_FROM_ISR();
+
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+				prvReleaseJob( pxTCB, xRelease );
+
+				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					prvAddTaskToReadyList( pxTCB );
+				}
+				else
+				{
+					/* xTaskResumeAll() orders the task by the deadline set
+					above. */
+					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+
+				/* Preempt the running job if the released job is due first. */
+				if( prvPreemptsRunningTask( pxTCB->xJobDeadline ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+
+					xYieldPending = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				/* The previous job is still running.  This job starts, with
+				the deadline of its own release, when the task next calls
+				ulTaskNotifyTake(). */
+				if( pxTCB->uxPendingReleases == ( UBaseType_t ) 0U )
+				{
+					pxTCB->xPendingRelease = xRelease;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				( pxTCB->uxPendingReleases )++;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxTaskGetInterArrivalViolations( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxInterArrivalViolations;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS && configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
@@ -5315,11 +8358,13 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear )
+	uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear )
 	{
 	TCB_t *pxTCB;
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
@@ -5328,8 +8373,8 @@ TickType_t uxReturn;
 		{
 			/* Return the notification as it was before the bits were cleared,
 			then clear the bit mask. */
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
-			pxTCB->ulNotifiedValue &= ~ulBitsToClear;
+			ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
+			pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
 		}
 		taskEXIT_CRITICAL();
 
@@ -5395,30 +8440,38 @@ const TickType_t xConstTickCount = xTickCount;
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-			if( xTimeToWake < xConstTickCount )
+			#if ( configUSE_DELAY_WHEEL == 1 )
 			{
-				/* Wake time has overflowed.  Place this item in the overflow
-				list. */
-				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+				prvDelayWheelInsert( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 			}
-			else
+			#else
 			{
-				/* The wake time has not overflowed, so the current block list
-				is used. */
-				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-				/* If the task entering the blocked state was placed at the
-				head of the list of blocked tasks then xNextTaskUnblockTime
-				needs to be updated too. */
-				if( xTimeToWake < xNextTaskUnblockTime )
+				if( xTimeToWake < xConstTickCount )
 				{
-					xNextTaskUnblockTime = xTimeToWake;
+					/* Wake time has overflowed.  Place this item in the overflow
+					list. */
+					vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 				}
 				else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* The wake time has not overflowed, so the current block list
+					is used. */
+					vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+					/* If the task entering the blocked state was placed at the
+					head of the list of blocked tasks then xNextTaskUnblockTime
+					needs to be updated too. */
+					if( xTimeToWake < xNextTaskUnblockTime )
+					{
+						xNextTaskUnblockTime = xTimeToWake;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 			}
+			#endif /* configUSE_DELAY_WHEEL */
 		}
 	}
 	#else /* INCLUDE_vTaskSuspend */
@@ -5431,28 +8484,36 @@ const TickType_t xConstTickCount = xTickCount;
 		/* The list item will be inserted in wake time order. */
 		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-		if( xTimeToWake < xConstTickCount )
+		#if ( configUSE_DELAY_WHEEL == 1 )
 		{
-			/* Wake time has overflowed.  Place this item in the overflow list. */
-			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			prvDelayWheelInsert( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 		}
-		else
+		#else
 		{
-			/* The wake time has not overflowed, so the current block list is used. */
-			vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-			/* If the task entering the blocked state was placed at the head of the
-			list of blocked tasks then xNextTaskUnblockTime needs to be updated
-			too. */
-			if( xTimeToWake < xNextTaskUnblockTime )
+			if( xTimeToWake < xConstTickCount )
 			{
-				xNextTaskUnblockTime = xTimeToWake;
+				/* Wake time has overflowed.  Place this item in the overflow list. */
+				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 			}
 			else
 			{
-				mtCOVERAGE_TEST_MARKER();
+				/* The wake time has not overflowed, so the current block list is used. */
+				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+				/* If the task entering the blocked state was placed at the head of the
+				list of blocked tasks then xNextTaskUnblockTime needs to be updated
+				too. */
+				if( xTimeToWake < xNextTaskUnblockTime )
+				{
+					xNextTaskUnblockTime = xTimeToWake;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 		}
+		#endif /* configUSE_DELAY_WHEEL */
 
 		/* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
 		( void ) xCanBlockIndefinitely;
@@ -64,6 +64,10 @@ defining trmTIMER_SERVICE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configTIMER_SERVICE_TASK_NAME "Tmr Svc"
 #endif
 
+#if ( configUSE_TIMER_COALESCING == 1 )
+	#define tmrBUCKET_MASK					( ( TickType_t ) configTIMER_BUCKETS - ( TickType_t ) 1U )
+#endif
+
 /* Bit definitions used in the ucStatus member of a timer structure. */
 #define tmrSTATUS_IS_ACTIVE					( ( uint8_t ) 0x01 )
 #define tmrSTATUS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 0x02 )
@@ -75,6 +79,9 @@ typedef struct tmrTimerControl /* The old naming convention is used to prevent b
 	const char				*pcTimerName;		/*<< Text name.  This is not used by the kernel, it is included simply to make debugging easier. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 	ListItem_t				xTimerListItem;		/*<< Standard linked list item as used by all kernel features for event management. */
 	TickType_t				xTimerPeriodInTicks;/*<< How quickly and often the timer expires. */
+	#if( configUSE_TIMER_COALESCING == 1 )
+		TickType_t			xTimerSlackInTicks;	/*<< How many ticks after its expiry time the timer can be run, so it can be run along with other timers. */
+	#endif
 	void 					*pvTimerID;			/*<< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
 	TimerCallbackFunction_t	pxCallbackFunction;	/*<< The function that will be called when the timer expires. */
 	#if( configUSE_TRACE_FACILITY == 1 )
@@ -126,16 +133,32 @@ typedef struct tmrTimerQueueMessage
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access these lists.
-xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
-breaks some kernel aware debuggers, and debuggers that reply on removing the
-static qualifier. */
-PRIVILEGED_DATA static List_t xActiveTimerList1;
-PRIVILEGED_DATA static List_t xActiveTimerList2;
-PRIVILEGED_DATA static List_t *pxCurrentTimerList;
-PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+#if ( configUSE_TIMER_COALESCING == 1 )
+
+	/* Active timers are hashed on their expiry time into unsorted lists, one
+	per tick of a rotation of configTIMER_BUCKETS ticks, so a timer can be
+	started in constant time.  A list can hold timers from later rotations.
+	Only the timer service task is allowed to access these variables. */
+	PRIVILEGED_DATA static List_t xActiveTimerBuckets[ configTIMER_BUCKETS ];
+	PRIVILEGED_DATA static TickType_t xBucketDeadlines[ configTIMER_BUCKETS ];	/*< The earliest expiry time plus slack in each bucket.  Not raised when a timer is stopped, so can be early. */
+	PRIVILEGED_DATA static uint32_t ulOccupiedBuckets = 0UL;					/*< A bit per bucket, set while xBucketDeadlines[] is valid for the bucket. */
+	PRIVILEGED_DATA static TickType_t xLastProcessTime;						/*< The time the buckets were last processed.  Every active timer expires after this time. */
+	PRIVILEGED_DATA static List_t xExpiredTimerList;						/*< Timers being run by the current pass of prvProcessExpiredTimers(). */
+
+#else
+
+	/* The list in which active timers are stored.  Timers are referenced in expire
+	time order, with the nearest expiry time at the front of the list.  Only the
+	timer service task is allowed to access these lists.
+	xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
+	breaks some kernel aware debuggers, and debuggers that reply on removing the
+	static qualifier. */
+	PRIVILEGED_DATA static List_t xActiveTimerList1;
+	PRIVILEGED_DATA static List_t xActiveTimerList2;
+	PRIVILEGED_DATA static List_t *pxCurrentTimerList;
+	PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+
+#endif /* configUSE_TIMER_COALESCING */
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -176,21 +199,41 @@ static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * depending on if the expire time causes a timer counter overflow.  With
+ * configUSE_TIMER_COALESCING set to 1 the timer is instead added to the bucket
+ * for its expiry time.
  */
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
-/*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto-reload timer, then call its callback.
- */
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+#if ( configUSE_TIMER_COALESCING == 1 )
 
-/*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
- */
-static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+	/*
+	 * Add the timer to the bucket for the expiry time held in its list item,
+	 * which must be after xLastProcessTime.
+	 */
+	static void prvAddTimerToBucket( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Run every timer whose expiry time has been reached, whether or not the
+	 * end of its slack window has, reloading the auto-reload timers.
+	 */
+	static void prvProcessExpiredTimers( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * An active timer has reached its expire time.  Reload the timer if it is an
+	 * auto-reload timer, then call its callback.
+	 */
+	static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_COALESCING */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -202,7 +245,9 @@ static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched
  * If the timer list contains any active timers then return the expire time of
  * the timer that will expire first and set *pxListWasEmpty to false.  If the
  * timer list does not contain any timers then return 0 and set *pxListWasEmpty
- * to pdTRUE.
+ * to pdTRUE.  With configUSE_TIMER_COALESCING set to 1 the time returned is the
+ * earliest end of a slack window instead, by which time other timers may also
+ * have reached their expiry time.
  */
 static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
 
@@ -366,6 +411,11 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 		parameters. */
 		pxNewTimer->pcTimerName = pcTimerName;
 		pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
+		#if( configUSE_TIMER_COALESCING == 1 )
+		{
+			pxNewTimer->xTimerSlackInTicks = ( TickType_t ) 0U;
+		}
+		#endif
 		pxNewTimer->pvTimerID = pvTimerID;
 		pxNewTimer->pxCallbackFunction = pxCallbackFunction;
 		vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
@@ -484,6 +534,36 @@ UBaseType_t uxReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_COALESCING == 1 )
+
+	void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlackInTicks )
+	{
+	Timer_t * pxTimer =  xTimer;
+
+		configASSERT( xTimer );
+		taskENTER_CRITICAL();
+		{
+			pxTimer->xTimerSlackInTicks = xSlackInTicks;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_COALESCING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_COALESCING == 1 )
+
+	TickType_t xTimerGetSlack( TimerHandle_t xTimer )
+	{
+	Timer_t * pxTimer =  xTimer;
+
+		configASSERT( xTimer );
+		return pxTimer->xTimerSlackInTicks;
+	}
+
+#endif /* configUSE_TIMER_COALESCING */
+/*-----------------------------------------------------------*/
+
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer )
 {
 Timer_t * pxTimer =  xTimer;
@@ -504,45 +584,169 @@ Timer_t *pxTimer = xTimer;
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
-{
-BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
-	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-	traceTIMER_EXPIRED( pxTimer );
+#if ( configUSE_TIMER_COALESCING == 1 )
 
-	/* If the timer is an auto-reload timer then calculate the next
-	expiry time and re-insert the timer in the list of active timers. */
-	if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+	static void prvAddTimerToBucket( Timer_t * const pxTimer )
 	{
-		/* The timer is inserted into a list using a time relative to anything
-		other than the current time.  It will therefore be inserted into the
-		correct list relative to the time this task thinks it is now. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
+	const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+	const TickType_t xDeadline = xExpiryTime + pxTimer->xTimerSlackInTicks;
+	const UBaseType_t uxBucket = ( UBaseType_t ) ( xExpiryTime & tmrBUCKET_MASK );
+	const uint32_t ulBucketBit = ( uint32_t ) 1UL << uxBucket;
+
+		vListInsertEnd( &( xActiveTimerBuckets[ uxBucket ] ), &( pxTimer->xTimerListItem ) );
+
+		/* Deadlines are compared relative to xLastProcessTime, which every
+		active timer expires after, so the comparison survives the tick count
+		overflowing. */
+		if( ( ulOccupiedBuckets & ulBucketBit ) == 0UL )
+		{
+			xBucketDeadlines[ uxBucket ] = xDeadline;
+			ulOccupiedBuckets |= ulBucketBit;
+		}
+		else if( ( TickType_t ) ( xDeadline - xLastProcessTime ) < ( TickType_t ) ( xBucketDeadlines[ uxBucket ] - xLastProcessTime ) )
 		{
-			/* The timer expired before it was added to the active timer
-			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-			configASSERT( xResult );
-			( void ) xResult;
+			xBucketDeadlines[ uxBucket ] = xDeadline;
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
-	else
+	/*-----------------------------------------------------------*/
+
+	static void prvProcessExpiredTimers( const TickType_t xTimeNow )
 	{
-		pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
-		mtCOVERAGE_TEST_MARKER();
+	const TickType_t xPreviousProcessTime = xLastProcessTime;
+	const TickType_t xTicksElapsed = xTimeNow - xPreviousProcessTime;
+	TickType_t xTicksToScan, xTick, xExpiryTime;
+	UBaseType_t uxBucket, uxItems;
+	List_t *pxBucket;
+	Timer_t *pxTimer;
+	BaseType_t xResult;
+
+		/* Only the buckets for the ticks since the buckets were last processed
+		can hold timers that have expired.  If a full rotation has passed then
+		every bucket must be checked. */
+		if( xTicksElapsed < ( TickType_t ) configTIMER_BUCKETS )
+		{
+			xTicksToScan = xTicksElapsed;
+		}
+		else
+		{
+			xTicksToScan = ( TickType_t ) configTIMER_BUCKETS;
+		}
+
+		/* Timers that remain in a bucket are re-added relative to the new
+		process time, as are the auto-reload timers reloaded below. */
+		xLastProcessTime = xTimeNow;
+
+		for( xTick = ( TickType_t ) 1U; xTick <= xTicksToScan; xTick++ )
+		{
+			uxBucket = ( UBaseType_t ) ( ( xPreviousProcessTime + xTick ) & tmrBUCKET_MASK );
+			pxBucket = &( xActiveTimerBuckets[ uxBucket ] );
+			ulOccupiedBuckets &= ~( ( uint32_t ) 1UL << uxBucket );
+
+			/* Move the expired timers out of the bucket.  The bucket can also
+			hold timers that expire in a later rotation, which are re-added so
+			the bucket deadline is recalculated. */
+			for( uxItems = listCURRENT_LIST_LENGTH( pxBucket ); uxItems > ( UBaseType_t ) 0U; uxItems-- )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxBucket ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+				if( ( TickType_t ) ( xExpiryTime - xPreviousProcessTime ) <= xTicksElapsed )
+				{
+					vListInsertEnd( &xExpiredTimerList, &( pxTimer->xTimerListItem ) );
+				}
+				else
+				{
+					prvAddTimerToBucket( pxTimer );
+				}
+			}
+		}
+
+		/* Run every timer that has expired, whether or not the end of its
+		slack window has been reached, so timers that expire close together
+		share one wake up of this task. */
+		while( listLIST_IS_EMPTY( &xExpiredTimerList ) == pdFALSE )
+		{
+			pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xExpiredTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+			traceTIMER_EXPIRED( pxTimer );
+
+			/* If the timer is an auto-reload timer then calculate the next
+			expiry time from the time it was due, not the time it ran, so the
+			slack does not accumulate into the period. */
+			if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+			{
+				if( prvInsertTimerInActiveList( pxTimer, ( xExpiryTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xExpiryTime ) != pdFALSE )
+				{
+					/* The next expiry time has also passed.  Reload it now. */
+					xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xExpiryTime, NULL, tmrNO_DELAY );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Call the timer callback. */
+			pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+		}
 	}
 
-	/* Call the timer callback. */
-	pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-}
+#else
+
+	static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+	{
+	BaseType_t xResult;
+	Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+		/* Remove the timer from the list of active timers.  A check has already
+		been performed to ensure the list is not empty. */
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		traceTIMER_EXPIRED( pxTimer );
+
+		/* If the timer is an auto-reload timer then calculate the next
+		expiry time and re-insert the timer in the list of active timers. */
+		if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+		{
+			/* The timer is inserted into a list using a time relative to anything
+			other than the current time.  It will therefore be inserted into the
+			correct list relative to the time this task thinks it is now. */
+			if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
+			{
+				/* The timer expired before it was added to the active timer
+				list.  Reload it now.  */
+				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+				configASSERT( xResult );
+				( void ) xResult;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Call the timer callback. */
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+	}
+
+#endif /* configUSE_TIMER_COALESCING */
 /*-----------------------------------------------------------*/
 
 static portTASK_FUNCTION( prvTimerTask, pvParameters )
@@ -581,42 +785,30 @@ BaseType_t xListWasEmpty;
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
-{
-TickType_t xTimeNow;
-BaseType_t xTimerListsWereSwitched;
+#if ( configUSE_TIMER_COALESCING == 1 )
 
-	vTaskSuspendAll();
+	static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
 	{
-		/* Obtain the time now to make an assessment as to whether the timer
-		has expired or not.  If obtaining the time causes the lists to switch
-		then don't process this timer as any timers that remained in the list
-		when the lists were switched will have been processed within the
-		prvSampleTimeNow() function. */
-		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
-		if( xTimerListsWereSwitched == pdFALSE )
+	TickType_t xTimeNow;
+
+		vTaskSuspendAll();
 		{
-			/* The tick count has not overflowed, has the timer expired? */
-			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+			/* There are no timer lists to switch, so the tick count can be
+			read directly.  xNextExpireTime is the end of the earliest slack
+			window, so is compared relative to xLastProcessTime to survive the
+			tick count overflowing. */
+			xTimeNow = xTaskGetTickCount();
+
+			if( ( xListWasEmpty == pdFALSE ) && ( ( TickType_t ) ( xNextExpireTime - xLastProcessTime ) <= ( TickType_t ) ( xTimeNow - xLastProcessTime ) ) )
 			{
 				( void ) xTaskResumeAll();
-				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				prvProcessExpiredTimers( xTimeNow );
 			}
 			else
 			{
-				/* The tick count has not overflowed, and the next expire
-				time has not been reached yet.  This task should therefore
-				block to wait for the next expire time or a command to be
-				received - whichever comes first.  The following line cannot
-				be reached unless xNextExpireTime > xTimeNow, except in the
-				case when the current timer list is empty. */
-				if( xListWasEmpty != pdFALSE )
-				{
-					/* The current timer list is empty - is the overflow list
-					also empty? */
-					xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
-				}
-
+				/* Block to wait for the end of the earliest slack window or a
+				command to be received - whichever comes first.  The block
+				time is ignored if there are no active timers. */
 				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
 
 				if( xTaskResumeAll() == pdFALSE )
@@ -633,102 +825,260 @@ BaseType_t xTimerListsWereSwitched;
 				}
 			}
 		}
-		else
+	}
+
+#else
+
+	static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
+	{
+	TickType_t xTimeNow;
+	BaseType_t xTimerListsWereSwitched;
+
+		vTaskSuspendAll();
 		{
-			( void ) xTaskResumeAll();
+			/* Obtain the time now to make an assessment as to whether the timer
+			has expired or not.  If obtaining the time causes the lists to switch
+			then don't process this timer as any timers that remained in the list
+			when the lists were switched will have been processed within the
+			prvSampleTimeNow() function. */
+			xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+			if( xTimerListsWereSwitched == pdFALSE )
+			{
+				/* The tick count has not overflowed, has the timer expired? */
+				if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+				{
+					( void ) xTaskResumeAll();
+					prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				}
+				else
+				{
+					/* The tick count has not overflowed, and the next expire
+					time has not been reached yet.  This task should therefore
+					block to wait for the next expire time or a command to be
+					received - whichever comes first.  The following line cannot
+					be reached unless xNextExpireTime > xTimeNow, except in the
+					case when the current timer list is empty. */
+					if( xListWasEmpty != pdFALSE )
+					{
+						/* The current timer list is empty - is the overflow list
+						also empty? */
+						xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+					}
+
+					vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						/* Yield to wait for either a command to arrive, or the
+						block time to expire.  If a command arrived between the
+						critical section being exited and this yield then the yield
+						will not cause the task to block. */
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			else
+			{
+				( void ) xTaskResumeAll();
+			}
 		}
 	}
-}
+
+#endif /* configUSE_TIMER_COALESCING */
 /*-----------------------------------------------------------*/
 
-static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
-{
-TickType_t xNextExpireTime;
+#if ( configUSE_TIMER_COALESCING == 1 )
 
-	/* Timers are listed in expiry time order, with the head of the list
-	referencing the task that will expire first.  Obtain the time at which
-	the timer with the nearest expiry time will expire.  If there are no
-	active timers then just set the next expire time to 0.  That will cause
-	this task to unblock when the tick count overflows, at which point the
-	timer lists will be switched and the next expiry time can be
-	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-	if( *pxListWasEmpty == pdFALSE )
+	static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+	TickType_t xEarliest = portMAX_DELAY, xRelativeDeadline;
+	uint32_t ulBuckets = ulOccupiedBuckets;
+	UBaseType_t uxBucket;
+
+		/* The task must next run when the earliest slack window closes.  Each
+		occupied bucket records the earliest window end of the timers it holds,
+		so only configTIMER_BUCKETS values need to be checked however many
+		timers are active. */
+		*pxListWasEmpty = ( ulBuckets == 0UL ) ? pdTRUE : pdFALSE;
+
+		for( uxBucket = ( UBaseType_t ) 0U; ulBuckets != 0UL; uxBucket++ )
+		{
+			if( ( ulBuckets & 1UL ) != 0UL )
+			{
+				xRelativeDeadline = xBucketDeadlines[ uxBucket ] - xLastProcessTime;
+
+				if( xRelativeDeadline < xEarliest )
+				{
+					xEarliest = xRelativeDeadline;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			ulBuckets >>= 1UL;
+		}
+
+		return xLastProcessTime + xEarliest;
 	}
-	else
+
+#else
+
+	static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
 	{
-		/* Ensure the task unblocks when the tick count rolls over. */
-		xNextExpireTime = ( TickType_t ) 0U;
+	TickType_t xNextExpireTime;
+
+		/* Timers are listed in expiry time order, with the head of the list
+		referencing the task that will expire first.  Obtain the time at which
+		the timer with the nearest expiry time will expire.  If there are no
+		active timers then just set the next expire time to 0.  That will cause
+		this task to unblock when the tick count overflows, at which point the
+		timer lists will be switched and the next expiry time can be
+		re-assessed.  */
+		*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+		if( *pxListWasEmpty == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		}
+		else
+		{
+			/* Ensure the task unblocks when the tick count rolls over. */
+			xNextExpireTime = ( TickType_t ) 0U;
+		}
+
+		return xNextExpireTime;
 	}
 
-	return xNextExpireTime;
-}
+#endif /* configUSE_TIMER_COALESCING */
 /*-----------------------------------------------------------*/
 
-static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
-{
-TickType_t xTimeNow;
-PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
-
-	xTimeNow = xTaskGetTickCount();
+#if ( configUSE_TIMER_COALESCING == 1 )
 
-	if( xTimeNow < xLastTime )
-	{
-		prvSwitchTimerLists();
-		*pxTimerListsWereSwitched = pdTRUE;
-	}
-	else
+	static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
 	{
+		/* Expiry times are compared relative to xLastProcessTime, so there are
+		no timer lists to switch when the tick count overflows. */
 		*pxTimerListsWereSwitched = pdFALSE;
+
+		return xTaskGetTickCount();
 	}
 
-	xLastTime = xTimeNow;
+#else
 
-	return xTimeNow;
-}
-/*-----------------------------------------------------------*/
+	static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
+	{
+	TickType_t xTimeNow;
+	PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
-static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
-{
-BaseType_t xProcessTimerNow = pdFALSE;
+		xTimeNow = xTaskGetTickCount();
+
+		if( xTimeNow < xLastTime )
+		{
+			prvSwitchTimerLists();
+			*pxTimerListsWereSwitched = pdTRUE;
+		}
+		else
+		{
+			*pxTimerListsWereSwitched = pdFALSE;
+		}
+
+		xLastTime = xTimeNow;
+
+		return xTimeNow;
+	}
+
+#endif /* configUSE_TIMER_COALESCING */
+/*-----------------------------------------------------------*/
 
-	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
-	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+#if ( configUSE_TIMER_COALESCING == 1 )
 
-	if( xNextExpiryTime <= xTimeNow )
+	static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
 	{
-		/* Has the expiry time elapsed between the command to start/reset a
-		timer was issued, and the time the command was processed? */
-		if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+	BaseType_t xProcessTimerNow = pdFALSE;
+
+		listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+		listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+		/* Has the expiry time elapsed between the command to start/reset the
+		timer being issued and the command being processed?  Both times are
+		relative to the command time so the tick count overflowing in between
+		does not matter. */
+		if( ( TickType_t ) ( xTimeNow - xCommandTime ) >= ( TickType_t ) ( xNextExpiryTime - xCommandTime ) ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 		{
-			/* The time between a command being issued and the command being
-			processed actually exceeds the timers period.  */
 			xProcessTimerNow = pdTRUE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			if( ulOccupiedBuckets == 0UL )
+			{
+				/* No bucket needs processing, so the process time can be
+				brought forward to keep it within range of the new expiry
+				time. */
+				xLastProcessTime = xTimeNow;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvAddTimerToBucket( pxTimer );
 		}
+
+		return xProcessTimerNow;
 	}
-	else
+
+#else
+
+	static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
 	{
-		if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+	BaseType_t xProcessTimerNow = pdFALSE;
+
+		listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+		listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+		if( xNextExpiryTime <= xTimeNow )
 		{
-			/* If, since the command was issued, the tick count has overflowed
-			but the expiry time has not, then the timer must have already passed
-			its expiry time and should be processed immediately. */
-			xProcessTimerNow = pdTRUE;
+			/* Has the expiry time elapsed between the command to start/reset a
+			timer was issued, and the time the command was processed? */
+			if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+			{
+				/* The time between a command being issued and the command being
+				processed actually exceeds the timers period.  */
+				xProcessTimerNow = pdTRUE;
+			}
+			else
+			{
+				vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			}
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+			{
+				/* If, since the command was issued, the tick count has overflowed
+				but the expiry time has not, then the timer must have already passed
+				its expiry time and should be processed immediately. */
+				xProcessTimerNow = pdTRUE;
+			}
+			else
+			{
+				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			}
 		}
+
+		return xProcessTimerNow;
 	}
 
-	return xProcessTimerNow;
-}
+#endif /* configUSE_TIMER_COALESCING */
 /*-----------------------------------------------------------*/
 
 static void	prvProcessReceivedCommands( void )
@@ -879,63 +1229,67 @@ TickType_t xTimeNow;
 }
 /*-----------------------------------------------------------*/
 
-static void prvSwitchTimerLists( void )
-{
-TickType_t xNextExpireTime, xReloadTime;
-List_t *pxTemp;
-Timer_t *pxTimer;
-BaseType_t xResult;
+#if ( configUSE_TIMER_COALESCING == 0 )
 
-	/* The tick count has overflowed.  The timer lists must be switched.
-	If there are any timers still referenced from the current timer list
-	then they must have expired and should be processed before the lists
-	are switched. */
-	while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+	static void prvSwitchTimerLists( void )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+	TickType_t xNextExpireTime, xReloadTime;
+	List_t *pxTemp;
+	Timer_t *pxTimer;
+	BaseType_t xResult;
+
+		/* The tick count has overflowed.  The timer lists must be switched.
+		If there are any timers still referenced from the current timer list
+		then they must have expired and should be processed before the lists
+		are switched. */
+		while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
 
-		/* Remove the timer from the list. */
-		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-		traceTIMER_EXPIRED( pxTimer );
+			/* Remove the timer from the list. */
+			pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+			traceTIMER_EXPIRED( pxTimer );
 
-		/* Execute its callback, then send a command to restart the timer if
-		it is an auto-reload timer.  It cannot be restarted here as the lists
-		have not yet been switched. */
-		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+			/* Execute its callback, then send a command to restart the timer if
+			it is an auto-reload timer.  It cannot be restarted here as the lists
+			have not yet been switched. */
+			pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
 
-		if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-		{
-			/* Calculate the reload value, and if the reload value results in
-			the timer going into the same timer list then it has already expired
-			and the timer should be re-inserted into the current list so it is
-			processed again within this loop.  Otherwise a command should be sent
-			to restart the timer to ensure it is only inserted into a list after
-			the lists have been swapped. */
-			xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
-			if( xReloadTime > xNextExpireTime )
+			if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
 			{
-				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
-				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+				/* Calculate the reload value, and if the reload value results in
+				the timer going into the same timer list then it has already expired
+				and the timer should be re-inserted into the current list so it is
+				processed again within this loop.  Otherwise a command should be sent
+				to restart the timer to ensure it is only inserted into a list after
+				the lists have been swapped. */
+				xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
+				if( xReloadTime > xNextExpireTime )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
+					listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+					vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+				}
+				else
+				{
+					xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
 			}
 			else
 			{
-				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-				configASSERT( xResult );
-				( void ) xResult;
+				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+
+		pxTemp = pxCurrentTimerList;
+		pxCurrentTimerList = pxOverflowTimerList;
+		pxOverflowTimerList = pxTemp;
 	}
 
-	pxTemp = pxCurrentTimerList;
-	pxCurrentTimerList = pxOverflowTimerList;
-	pxOverflowTimerList = pxTemp;
-}
+#endif /* configUSE_TIMER_COALESCING */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
@@ -947,10 +1301,26 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
+			#if( configUSE_TIMER_COALESCING == 1 )
+			{
+			UBaseType_t uxBucket;
+
+				for( uxBucket = ( UBaseType_t ) 0U; uxBucket < ( UBaseType_t ) configTIMER_BUCKETS; uxBucket++ )
+				{
+					vListInitialise( &( xActiveTimerBuckets[ uxBucket ] ) );
+				}
+
+				vListInitialise( &xExpiredTimerList );
+				xLastProcessTime = xTaskGetTickCount();
+			}
+			#else
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#endif /* configUSE_TIMER_COALESCING */
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
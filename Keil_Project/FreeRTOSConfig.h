@@ -39,6 +39,7 @@ extern unsigned int g_u32_periodic_transmitter_in_time, 		g_u32_periodic_transmi
 extern unsigned int g_u32_uart_receiver_in_time, 					g_u32_uart_receiver_out_time, 				g_u32_uart_receiver_total_time;
 extern unsigned int g_u32_system_time;
 extern unsigned int g_u32_cpu_load;
+extern void vUpdateCpuLoad( void );
 
 /*-----------------------------------------------------------
  * Application specific definitions.
@@ -60,22 +61,34 @@ extern unsigned int g_u32_cpu_load;
 #define configMAX_PRIORITIES		    ( 4 )
 #define configMINIMAL_STACK_SIZE	    ( ( unsigned short ) 200 )
 #define configTOTAL_HEAP_SIZE		    ( ( size_t ) 13 * 1024 )
+#define configSUPPORT_STATIC_ALLOCATION	    1		/* The tasks of tasks_cfg.h and the idle task are created statically. */
+#define configTLSF_FL_INDEX_MAX		    ( 14 )	/* heap_tlsf.c: 2^14 bytes is the smallest power of two above the heap size. */
+#define configUSE_HEAP_INSTRUMENTATION	    0		/* Set to 1 and add heap_instrumentation.c to the project to profile the heap. */
 #define configMAX_TASK_NAME_LEN		    ( 8 )
 #define configUSE_TRACE_FACILITY	    1
 #define configUSE_16_BIT_TICKS		    0
 #define configIDLE_SHOULD_YIELD		    1
 
 #define configUSE_MUTEXES               	1
+#define configUSE_QUEUE_LOANS           	1
+#define configUSE_QUEUE_OVERWRITE_OLDEST	1
+#define configUSE_QUEUE_DEADLINE_ORDER  	1
 #define configUSE_APPLICATION_TASK_TAG  	1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES	2	/* Index 0 releases the sporadic tasks, index 1 is the UART transmit complete wait. */
 #define configUSE_EDF_SCHEDULER         	1
+#define configUSE_EDF_SLACK_STEALING    	0
+#define configUSE_EDF_HIGH_RES_TIME     	0	/* Set to 1 to release the periodic jobs on the microsecond, timed by Timer1, instead of on the 1 ms tick. */
+#define configEDF_HIGH_RES_TIME_HZ      	1000000UL
+#define configUSE_DELAY_WHEEL           	0	/* Set to 1 to keep delayed tasks in a timing wheel, which pays off once many tasks block with a timeout. */
+#define configEVENT_GROUP_WAITER_BUCKETS	8	/* Tasks waiting on an event group are spread over 8 lists, so setting bits skips the tasks that wait for other bits. */
+#define configUSE_STACK_PROFILER        	0	/* Set to 1 to have the idle task track peak stack usage, main.c then prints recommended stack sizes. */
+#define configUSE_WCET_PROFILER         	0	/* Set to 1 to histogram the execution time of every job, main.c then sends the histograms over the UART. */
 #define configUSE_TIME_SLICING          	0
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		    0
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
 
-#define edfConfigIDLE_PERIOD            105 /* SYSTEM TASKS' PERIODS MUST NOT EXCEED THIS VALUE */
-
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 
@@ -87,31 +100,64 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil				1
 #define INCLUDE_vTaskDelay						1
 
+/* Task tracing.  Each task tags itself with a trace ID.  With
+configUSE_ENCODED_TRACE_PORT set to 0 the ID is the PORT_0 pin the task drives
+high while it runs, which allows one pin per task.  With it set to 1 the ID is
+written as a binary code on the TRACE_OUTPUT pins of GPIO_cfg.c, so up to 15
+tasks can be traced on four pins. */
+#define configUSE_ENCODED_TRACE_PORT	0
+
+#if ( configUSE_ENCODED_TRACE_PORT == 1 )
+	#define traceID_BUTTON_1			1
+	#define traceID_BUTTON_2			2
+	#define traceID_PERIODIC			3
+	#define traceID_UART				4
+	#define traceID_LOAD_1				5
+	#define traceID_LOAD_2				6
+	#define traceID_IDLE				7
+
+	/* The next task switched in overwrites the code, so there is nothing to
+	do when a task is switched out. */
+	#define traceGPIO_SWITCHED_IN()		GPIO_traceWrite((int)pxCurrentTCB->pxTaskTag)
+	#define traceGPIO_SWITCHED_OUT()
+#else
+	#define traceID_BUTTON_1			PIN2
+	#define traceID_BUTTON_2			PIN3
+	#define traceID_PERIODIC			PIN5
+	#define traceID_UART				PIN6
+	#define traceID_LOAD_1				PIN7
+	#define traceID_LOAD_2				PIN8
+	#define traceID_IDLE				PIN9
+
+	#define traceGPIO_SWITCHED_IN()		GPIO_write(PORT_0, (int)pxCurrentTCB->pxTaskTag, PIN_IS_HIGH)
+	#define traceGPIO_SWITCHED_OUT()	GPIO_write(PORT_0, (int)pxCurrentTCB->pxTaskTag, PIN_IS_LOW)
+#endif
+
 //#define traceTASK_SWITCHED_IN() GPIO_write(PORT_0, (int)pxCurrentTCB->pxTaskTag, PIN_IS_HIGH)
 //#define traceTASK_SWITCHED_OUT() GPIO_write(PORT_0, (int)pxCurrentTCB->pxTaskTag, PIN_IS_LOW)
 #define traceTASK_SWITCHED_IN()			do{																										\
-		GPIO_write(PORT_0, (int)pxCurrentTCB->pxTaskTag, PIN_IS_HIGH);												\
-		if((int)pxCurrentTCB -> pxTaskTag == PIN2)																						\
+		traceGPIO_SWITCHED_IN();																											\
+		if((int)pxCurrentTCB -> pxTaskTag == traceID_BUTTON_1)																						\
 		{																																											\
 			g_u32_button_1_in_time = T1TC;																											\
 		}																																											\
-		else if((int)pxCurrentTCB -> pxTaskTag == PIN3)																				\
+		else if((int)pxCurrentTCB -> pxTaskTag == traceID_BUTTON_2)																				\
 		{																																											\
 			g_u32_button_2_in_time = T1TC;																											\
 		}																																											\
-		else if((int)pxCurrentTCB -> pxTaskTag == PIN5)																				\
+		else if((int)pxCurrentTCB -> pxTaskTag == traceID_PERIODIC)																				\
 		{																																											\
 			g_u32_periodic_transmitter_in_time = T1TC;																					\
 		}																																											\
-		else if((int)pxCurrentTCB -> pxTaskTag == PIN7)																				\
+		else if((int)pxCurrentTCB -> pxTaskTag == traceID_LOAD_1)																				\
 		{																																											\
 			g_u32_load_1_in_time = T1TC;																												\
 		}																																											\
-		else if((int)pxCurrentTCB -> pxTaskTag == PIN8)																				\
+		else if((int)pxCurrentTCB -> pxTaskTag == traceID_LOAD_2)																				\
 		{																																											\
 			g_u32_load_2_in_time = T1TC;																												\
 		}																																											\
-		else if((int)pxCurrentTCB -> pxTaskTag == PIN6)																				\
+		else if((int)pxCurrentTCB -> pxTaskTag == traceID_UART)																				\
 		{																																											\
 			g_u32_uart_receiver_in_time = T1TC;																									\
 		}																																											\
@@ -119,39 +165,38 @@ to exclude the API function. */
 
 
 #define traceTASK_SWITCHED_OUT()		do{																										\
-		GPIO_write(PORT_0, (int)pxCurrentTCB->pxTaskTag, PIN_IS_LOW);													\
-		if((int)pxCurrentTCB -> pxTaskTag == PIN2)																						\
+		traceGPIO_SWITCHED_OUT();																											\
+		if((int)pxCurrentTCB -> pxTaskTag == traceID_BUTTON_1)																						\
 		{																																											\
 			g_u32_button_1_out_time = T1TC;																											\
 			g_u32_button_1_total_time += (g_u32_button_1_out_time - g_u32_button_1_in_time);		\
 		}																																											\
-		else if((int)pxCurrentTCB -> pxTaskTag == PIN3)																				\
+		else if((int)pxCurrentTCB -> pxTaskTag == traceID_BUTTON_2)																				\
 		{																																											\
 			g_u32_button_2_out_time = T1TC;																											\
 			g_u32_button_2_total_time += (g_u32_button_2_out_time - g_u32_button_2_in_time);		\
 		}																																											\
-		else if((int)pxCurrentTCB -> pxTaskTag == PIN5)																				\
+		else if((int)pxCurrentTCB -> pxTaskTag == traceID_PERIODIC)																				\
 		{																																											\
 					g_u32_periodic_transmitter_out_time = T1TC;																			\
 					g_u32_periodic_transmitter_total_time += (g_u32_periodic_transmitter_out_time - g_u32_periodic_transmitter_in_time);\
 		}																																											\
-		else if((int)pxCurrentTCB -> pxTaskTag == PIN7)																				\
+		else if((int)pxCurrentTCB -> pxTaskTag == traceID_LOAD_1)																				\
 		{																																											\
 					g_u32_load_1_out_time = T1TC;																										\
 					g_u32_load_1_total_time += (g_u32_load_1_out_time - g_u32_load_1_in_time);			\
 		}																																											\
-		else if((int)pxCurrentTCB -> pxTaskTag == PIN8)																				\
+		else if((int)pxCurrentTCB -> pxTaskTag == traceID_LOAD_2)																				\
 		{																																											\
 					g_u32_load_2_out_time = T1TC;																										\
 					g_u32_load_2_total_time += (g_u32_load_2_out_time - g_u32_load_2_in_time);			\
 		}																																											\
-		else if((int)pxCurrentTCB -> pxTaskTag == PIN6)																				\
+		else if((int)pxCurrentTCB -> pxTaskTag == traceID_UART)																				\
 		{																																											\
 					g_u32_uart_receiver_out_time = T1TC;																						\
 					g_u32_uart_receiver_total_time += (g_u32_uart_receiver_out_time - g_u32_uart_receiver_in_time);\
 		}																																											\
-		g_u32_system_time = T1TC;																															\
-		g_u32_cpu_load = ((g_u32_button_1_total_time + g_u32_button_2_total_time + g_u32_periodic_transmitter_total_time + g_u32_load_1_total_time + g_u32_load_2_total_time+ g_u32_uart_receiver_total_time)/ (float)g_u32_system_time) * 100;\
+		vUpdateCpuLoad();																																			\
 	}while(0)
 
 /* Optional Task: System Statistics */
@@ -159,6 +204,22 @@ to exclude the API function. */
 #define configUSE_STATS_FORMATTING_FUNCTIONS					1
 #define configGENERATE_RUN_TIME_STATS							1
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+/* The run time stats percentages are taken against the absolute value of T1TC,
+so they are only right until it wraps - after about 20 hours, or 71 minutes when
+configUSE_EDF_HIGH_RES_TIME makes Timer1 count microseconds.  The per task
+times and the WCET profiler only use differences, which survive the wrap. */
 #define portGET_RUN_TIME_COUNTER_VALUE()					(T1TC)
+#if ( configUSE_EDF_HIGH_RES_TIME == 1 )
+	#define configWCET_COUNTER_HZ								configEDF_HIGH_RES_TIME_HZ		/* The port runs Timer1 as the EDF time base. */
+#else
+	#define configWCET_COUNTER_HZ								( configCPU_CLOCK_HZ / 1001UL )	/* Timer1 counts PCLK / ( T1PR + 1 ). */
+#endif
+
+/* Sizes of the benchmarks of FreeRTOS/Demo/Common/Minimal, cut down so their
+tasks fit in the heap alongside the application. */
+#define ebbNUMBER_OF_WAITERS								( 8 )
+#define ebbBENCHMARK_TASK_STACK_SIZE						( ( unsigned short ) 128 )
+#define dtbNUMBER_OF_SLEEPERS								( 12 )
+#define dtbBENCHMARK_TASK_STACK_SIZE						( ( unsigned short ) 128 )
 
 #endif /* FREERTOS_CONFIG_H */
@@ -38,7 +38,8 @@ typedef enum
 typedef enum
 {
 	INPUT,
-	OUTPUT
+	OUTPUT,
+	TRACE_OUTPUT	/* Output that carries one bit of the encoded trace port (PORT_0 only) */
 	
 }pinDir_t;
 
@@ -49,12 +50,52 @@ typedef enum
 
 }pinState_t;
 
+/* Edge that raises an external interrupt */
+typedef enum
+{
+	EDGE_FALLING,
+	EDGE_RISING,
+	EDGE_BOTH
+
+}edge_t;
+
+/* Called from the external interrupt with the pin level after the edge.
+   Returns non zero if a context switch is required before the interrupt exits. */
+typedef uint8_t (*edgeCallback_t)(pinX_t pinNum, pinState_t pinState);
+
+
+/************ Encoded trace port section ***********/
+
+/* The TRACE_OUTPUT pins of GPIO_cfg.c, in table order, carry bit 0, 1, ... of
+   the running task's trace ID, so 2^k - 1 tasks can be traced on k pins (ID 0
+   means no task).  GPIO_init() precomputes the IOSET0 and IOCLR0 words of
+   every ID, so writing an ID costs two stores. */
+#define GPIO_TRACE_MAX_PINS			4
+#define GPIO_TRACE_IDS				(1 << GPIO_TRACE_MAX_PINS)
+
+extern unsigned long GPIO_traceSet[GPIO_TRACE_IDS];
+extern unsigned long GPIO_traceClr[GPIO_TRACE_IDS];
+
+#define GPIO_traceWrite(id)			do{																\
+										IOSET0 = GPIO_traceSet[(id) & (GPIO_TRACE_IDS - 1)];	\
+										IOCLR0 = GPIO_traceClr[(id) & (GPIO_TRACE_IDS - 1)];	\
+									}while(0)
+
 
 /************ Function declaration section ***********/
 
 extern void GPIO_init(void);
 extern pinState_t GPIO_read(portX_t PortName, pinX_t pinNum);
 extern void GPIO_write(portX_t PortName, pinX_t PinNum, pinState_t pinState);
+extern void GPIO_enableEdgeInterrupt(pinX_t pinNum, edgeCallback_t callback);
+extern void vGPIO_EINTHandler(void);
+
+/* Must be called from vApplicationTickHook() when any EDGE_BOTH line is
+   enabled.  An edge that comes within MinInterArrival of the last one passed
+   on is ignored as bounce.  When the window closes this reads the pin, and if
+   it settled at a level other than the one passed on last, passes that level
+   on, so a short press still gets its release. */
+extern void GPIO_tickHandler(void);
 
 
 
@@ -13,9 +13,23 @@ typedef struct
 	
 }PinConfig_t;
 
+/* External interrupt configuration.  Only PORT_0 pins that have an EINT
+   function can be used: PIN0 (P0.16, EINT0), PIN4 (P0.20, EINT3) and
+   PIN14 (P0.30, EINT3). */
+typedef struct
+{
+	pinX_t Pin;
+	edge_t Edge;
+	uint16_t MinInterArrival;	/* Edges closer than this, in ticks, to the last accepted edge are ignored. */
+	
+}EdgeConfig_t;
+
 
 extern PinConfig_t PinConfig_array[];
 extern uint16_t PinConfig_array_size;
 
+extern EdgeConfig_t EdgeConfig_array[];
+extern uint16_t EdgeConfig_array_size;
+
 
 #endif 
@@ -91,5 +91,31 @@ signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsign
 signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar);
 void xSerialPutChar(signed char cOutChar);
 
+/*
+ * vSerialPutString() queues the string for the THRE interrupt and returns
+ * without waiting for it to be sent.  It returns pdFALSE only if the transmit
+ * buffer stayed full for longer than serTX_BLOCK_TIME, in which case part of
+ * the string may not have been queued.  xSerialPutChar() queues a single
+ * character the same way.  Both take a mutex that serialises the writers and
+ * may block, so they must only be called from tasks, never from an interrupt.
+ *
+ * xSerialWaitForTxComplete() blocks the calling task until everything queued so
+ * far has left the transmit FIFO, or until xTicksToWait ticks have passed.  The
+ * task is woken by a direct to task notification from the interrupt.  Returns
+ * pdTRUE if the transmitter went idle, pdFALSE on timeout.
+ */
+BaseType_t xSerialWaitForTxComplete( TickType_t xTicksToWait );
+
+/*
+ * Blocks until the UART interrupt passes on received characters, then copies up
+ * to xBufferLength of them into pvBuffer and returns the number copied, or 0 if
+ * nothing arrived within xTicksToWait ticks.  The interrupt passes characters
+ * on once 32 have been received or the line has been idle for about four
+ * character times, so a reader is woken once per burst rather than once per
+ * character.  xSerialGetChar() reads the same buffer without blocking - only
+ * one task may read from the port.
+ */
+size_t xSerialReceive( void *pvBuffer, size_t xBufferLength, TickType_t xTicksToWait );
+
 #endif
 
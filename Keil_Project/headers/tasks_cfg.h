@@ -0,0 +1,59 @@
+
+
+#ifndef TASKS_CFG_H_
+#define TASKS_CFG_H_
+
+/************* Task table ************/
+
+/* Every task of the application, one TASK() row each:
+
+   TASK( Id, Entry, Name, Period, Deadline, Wcet, Stack, Release )
+
+   Id       - builds the names of the task's constants below and of its static
+              TCB and stack in main.c.
+   Entry    - the task function.
+   Name     - the task name, at most configMAX_TASK_NAME_LEN - 1 characters.
+   Period   - the period in ticks.  For a sporadic task, the minimum time
+              between two releases.
+   Deadline - the relative deadline of each job in ticks, no later than Period.
+   Wcet     - the worst case execution time of one job in microseconds.  Take
+              it from the maximum the WCET profiler reports, plus a margin.
+   Stack    - the stack size in words.  The stack profiler recommends one.
+   Release  - PERIODIC for a task whose jobs are released one Period apart by
+              vTaskDelayUntilNextRelease(), or SPORADIC for one whose jobs are
+              released by xTaskReleaseSporadicFromISR().
+
+   main.c creates the tasks in this order with statically allocated TCBs and
+   stacks, and fails to build if the task set cannot be scheduled. */
+#define APP_TASK_TABLE( TASK ) \
+	TASK( BUTTON_1,	Button_1_Monitor_Task,		"Button 1",	50,		50,		200,	configMINIMAL_STACK_SIZE,	SPORADIC ) \
+	TASK( BUTTON_2,	Button_2_Monitor_Task,		"Button 2",	50,		50,		200,	configMINIMAL_STACK_SIZE,	SPORADIC ) \
+	TASK( PERIODIC,	Periodic_Transmitter_Task,	"Periodic",	100,	100,	200,	configMINIMAL_STACK_SIZE,	PERIODIC ) \
+	TASK( UART,		Uart_Receiver_Task,			"Uart",		20,		20,		1000,	configMINIMAL_STACK_SIZE,	PERIODIC ) \
+	TASK( LOAD_1,	Load_1_Simulation,			"Load 1",	10,		10,		5000,	configMINIMAL_STACK_SIZE,	PERIODIC ) \
+	TASK( LOAD_2,	Load_2_Simulation,			"Load 2",	100,	100,	12000,	configMINIMAL_STACK_SIZE,	PERIODIC )
+
+
+/************* Constants generated from the table ************/
+
+/* APP_TASK_ID_<Id> - the index of the task in g_arr_x_task_handles[]. */
+#define APP_TASK_TABLE_ID( Id, Entry, Name, Period, Deadline, Wcet, Stack, Release )			APP_TASK_ID_##Id,
+
+typedef enum
+{
+	APP_TASK_TABLE( APP_TASK_TABLE_ID )
+	APP_TASK_COUNT
+
+}AppTaskId_t;
+
+/* APP_TASK_PERIOD_<Id> and APP_TASK_DEADLINE_<Id>, in ticks. */
+#define APP_TASK_TABLE_TIMING( Id, Entry, Name, Period, Deadline, Wcet, Stack, Release )		APP_TASK_PERIOD_##Id = ( Period ), APP_TASK_DEADLINE_##Id = ( Deadline ),
+
+enum
+{
+	APP_TASK_TABLE( APP_TASK_TABLE_TIMING )
+	APP_TASK_TIMING_END
+};
+
+
+#endif
@@ -1,12 +1,67 @@
 
 
 #include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
 #include "bit_math.h"
 #include "GPIO.h"
 #include "GPIO_cfg.h"
 #include "lpc21xx.h"
 
 
+/************* Private definitions section ************/
+
+#define EINT_LINES					4
+
+/* VIC channel of EINT0, EINT1..EINT3 follow it. */
+#define EINT_VIC_FIRST_CHANNEL		14
+
+/* VIC vector slot used by EINT0, slots 0 and 1 are used by the tick and the UART. */
+#define EINT_VIC_FIRST_SLOT			2
+#define VIC_SLOT_ENABLE				0x20
+
+#define VIC_VECT_ADDR(slot)			((&VICVectAddr0)[(slot)])
+#define VIC_VECT_CNTL(slot)			((&VICVectCntl0)[(slot)])
+
+/* Pins that have an external interrupt function */
+typedef struct
+{
+	pinX_t Pin;
+	uint8_t Line;
+	uint8_t PinselShift;	/* Position of the pin function in PINSEL1 */
+	uint8_t PinselFunction;
+	
+}EintPin_t;
+
+static const EintPin_t EintPin_array[] =
+							{
+								{PIN0, 0, 0, 1},	/* P0.16 */
+								{PIN4, 3, 8, 3},	/* P0.20 */
+								{PIN14, 3, 28, 2},	/* P0.30 */
+							};
+
+unsigned long GPIO_traceSet[GPIO_TRACE_IDS];
+unsigned long GPIO_traceClr[GPIO_TRACE_IDS];
+
+/* Per line state, only accessed from the edge and tick interrupts once the
+   line is enabled */
+static const EdgeConfig_t *EintConfig[EINT_LINES];
+static edgeCallback_t EintCallback[EINT_LINES];
+static TickType_t EintLastEdge[EINT_LINES];
+static uint8_t EintSeenEdge[EINT_LINES];
+static pinState_t EintLastState[EINT_LINES];	/* Level passed to the callback last */
+static uint8_t EintResample[EINT_LINES];		/* Check the level when the debounce window closes */
+
+/*
+ * The asm wrapper for the interrupt service routine.
+ */
+extern void vGPIO_EINTEntry(void);
+
+static void GPIO_configureEdge(const EdgeConfig_t *pxConfig);
+static void GPIO_buildTraceTable(void);
+static void GPIO_armEdge(uint8_t line);
+
+
 void GPIO_init(void)
 {
 	int i;
@@ -20,7 +75,7 @@ void GPIO_init(void)
 				{
 					CLR_BIT(IODIR0, PinConfig_array[i].Pin);
 				}
-				else if (OUTPUT == PinConfig_array[i].Direction)
+				else if ((OUTPUT == PinConfig_array[i].Direction) || (TRACE_OUTPUT == PinConfig_array[i].Direction))
 				{
 					SET_BIT(IODIR0, PinConfig_array[i].Pin);
 				}
@@ -49,6 +104,13 @@ void GPIO_init(void)
 				break;
 		}
 	}
+
+	GPIO_buildTraceTable();
+
+	for(i = 0; i < EdgeConfig_array_size;i++)
+	{
+		GPIO_configureEdge(&EdgeConfig_array[i]);
+	}
 }
 
 
@@ -109,3 +171,203 @@ void GPIO_write(portX_t portName, pinX_t pinNum, pinState_t pinState)
 			}
 	}
 }
+
+
+void GPIO_enableEdgeInterrupt(pinX_t pinNum, edgeCallback_t callback)
+{
+	uint8_t line;
+	
+	for(line = 0; line < EINT_LINES; line++)
+	{
+		if((EintConfig[line] != NULL) && (EintConfig[line]->Pin == pinNum))
+		{
+			EintCallback[line] = callback;
+			EintLastState[line] = GPIO_read(PORT_0, pinNum);
+			EintResample[line] = 0;
+			
+			/* Drop any edge latched before the callback was set */
+			EXTINT = (1 << line);
+			
+			VIC_VECT_ADDR(EINT_VIC_FIRST_SLOT + line) = (unsigned long) vGPIO_EINTEntry;
+			VIC_VECT_CNTL(EINT_VIC_FIRST_SLOT + line) = (EINT_VIC_FIRST_CHANNEL + line) | VIC_SLOT_ENABLE;
+			VICIntSelect &= ~(1 << (EINT_VIC_FIRST_CHANNEL + line));
+			VICIntEnable |= (1 << (EINT_VIC_FIRST_CHANNEL + line));
+			break;
+		}
+	}
+}
+
+
+void vGPIO_EINTHandler(void)
+{
+	uint8_t line;
+	uint8_t switchRequired = 0;
+	pinState_t state;
+	TickType_t now;
+	
+	now = xTaskGetTickCountFromISR();
+	
+	for(line = 0; line < EINT_LINES; line++)
+	{
+		if(((EXTINT & (1 << line)) != 0) && (EintConfig[line] == NULL))
+		{
+			/* No pin is configured on this line, so there is nothing to
+			   read or re-arm.  Clear the flag so it does not fire again. */
+			EXTINT = (1 << line);
+		}
+		else if((EXTINT & (1 << line)) != 0)
+		{
+			state = GPIO_read(PORT_0, EintConfig[line]->Pin);
+			
+			/* Look for the opposite edge next when both are wanted, then clear
+			   the flag - changing the polarity can set it again. */
+			GPIO_armEdge(line);
+			EXTINT = (1 << line);
+			
+			/* Edges that arrive sooner than the minimum inter-arrival time
+			   after the last accepted one are contact bounce. */
+			if((EintSeenEdge[line] == 0) || ((TickType_t) (now - EintLastEdge[line]) >= EintConfig[line]->MinInterArrival))
+			{
+				EintSeenEdge[line] = 1;
+				EintLastEdge[line] = now;
+				EintLastState[line] = state;
+				
+				/* An edge ignored in the window may be a real change, such as
+				   a button released within it, and this level may have been
+				   read mid-bounce, so GPIO_tickHandler() looks at the level
+				   again once the window closes.  With one edge wanted the
+				   level does not tell a bounce from a second edge. */
+				EintResample[line] = (EDGE_BOTH == EintConfig[line]->Edge) ? 1 : 0;
+				
+				if(EintCallback[line] != NULL)
+				{
+					switchRequired |= EintCallback[line](EintConfig[line]->Pin, state);
+				}
+			}
+		}
+	}
+	
+	/* If a callback released a job that is due before the interrupted one a
+	   context switch is required. */
+	portEXIT_SWITCHING_ISR(switchRequired);
+	
+	/* Clear the ISR in the VIC. */
+	VICVectAddr = 0;
+}
+
+
+void GPIO_tickHandler(void)
+{
+	uint8_t line;
+	pinState_t state;
+	TickType_t now;
+	
+	now = xTaskGetTickCountFromISR();
+	
+	for(line = 0; line < EINT_LINES; line++)
+	{
+		if((EintResample[line] != 0) && ((TickType_t) (now - EintLastEdge[line]) >= EintConfig[line]->MinInterArrival))
+		{
+			EintResample[line] = 0;
+			
+			/* Read and re-arm as the edge interrupt does, in case the last
+			   bounce was too short to arm the right polarity. */
+			state = GPIO_read(PORT_0, EintConfig[line]->Pin);
+			GPIO_armEdge(line);
+			EXTINT = (1 << line);
+			
+			/* The pin has settled at a level the callback has not seen, so
+			   pass it on as an edge at the end of the window, which opens a
+			   new window to check at its end. */
+			if(state != EintLastState[line])
+			{
+				EintLastEdge[line] = now;
+				EintLastState[line] = state;
+				EintResample[line] = 1;
+				
+				if(EintCallback[line] != NULL)
+				{
+					/* A task the callback wakes through a FromISR function
+					   with a yield pending is switched to by the tick itself. */
+					(void) EintCallback[line](EintConfig[line]->Pin, state);
+				}
+			}
+		}
+	}
+}
+
+
+static void GPIO_buildTraceTable(void)
+{
+	int i, id, bit;
+	int pinCount = 0;
+	pinX_t pins[GPIO_TRACE_MAX_PINS];
+	unsigned long mask = 0;
+	
+	for(i = 0; (i < PinConfig_array_size) && (pinCount < GPIO_TRACE_MAX_PINS); i++)
+	{
+		if((TRACE_OUTPUT == PinConfig_array[i].Direction) && (PORT_0 == PinConfig_array[i].Port))
+		{
+			pins[pinCount] = PinConfig_array[i].Pin;
+			mask |= (1UL << PinConfig_array[i].Pin);
+			pinCount++;
+		}
+	}
+	
+	/* IDs that need more pins than are configured keep only their low bits */
+	for(id = 0; id < GPIO_TRACE_IDS; id++)
+	{
+		GPIO_traceSet[id] = 0;
+		
+		for(bit = 0; bit < pinCount; bit++)
+		{
+			if((id & (1 << bit)) != 0)
+			{
+				GPIO_traceSet[id] |= (1UL << pins[bit]);
+			}
+		}
+		
+		GPIO_traceClr[id] = mask & ~GPIO_traceSet[id];
+	}
+}
+
+
+static void GPIO_configureEdge(const EdgeConfig_t *pxConfig)
+{
+	int i;
+	
+	for(i = 0; i < (int) (sizeof(EintPin_array) / sizeof(EintPin_t)); i++)
+	{
+		if(EintPin_array[i].Pin == pxConfig->Pin)
+		{
+			EintConfig[EintPin_array[i].Line] = pxConfig;
+			
+			PINSEL1 = (PINSEL1 & ~(3UL << EintPin_array[i].PinselShift)) | ((unsigned long) EintPin_array[i].PinselFunction << EintPin_array[i].PinselShift);
+			SET_BIT(EXTMODE, EintPin_array[i].Line);
+			GPIO_armEdge(EintPin_array[i].Line);
+			EXTINT = (1 << EintPin_array[i].Line);
+			break;
+		}
+	}
+}
+
+
+static void GPIO_armEdge(uint8_t line)
+{
+	edge_t edge = EintConfig[line]->Edge;
+	
+	if(EDGE_BOTH == edge)
+	{
+		/* Wait for the pin to leave the level it is at now */
+		edge = (PIN_IS_HIGH == GPIO_read(PORT_0, EintConfig[line]->Pin)) ? EDGE_FALLING : EDGE_RISING;
+	}
+	
+	if(EDGE_RISING == edge)
+	{
+		SET_BIT(EXTPOLAR, line);
+	}
+	else
+	{
+		CLR_BIT(EXTPOLAR, line);
+	}
+}
@@ -1,24 +1,25 @@
 #include <stdint.h>
 #include "GPIO.h"
 #include "GPIO_cfg.h"
+#include "tasks_cfg.h"
 
 
 PinConfig_t PinConfig_array[] = 
 							{
 								{PORT_0, PIN0, INPUT}, /* Button 1 Input */
-								{PORT_0, PIN1, INPUT}, /* Button 2 Input */
+								{PORT_0, PIN1, INPUT}, /* Not used - P0.17 has no external interrupt */
 								{PORT_0, PIN2, OUTPUT}, /* Button 1 Hook output */
 								{PORT_0, PIN3, OUTPUT}, /* Button 2 Hook output */
 								{PORT_0, PIN4, OUTPUT}, /* Tick Hook output */
-								{PORT_0, PIN5, OUTPUT}, /* Periodic task Hoot output */
-								{PORT_0, PIN6, OUTPUT}, /* Uart task */
-								{PORT_0, PIN7, OUTPUT},
-								{PORT_0, PIN8, OUTPUT},
+								{PORT_0, PIN5, TRACE_OUTPUT}, /* Periodic task Hoot output, trace ID bit 0 */
+								{PORT_0, PIN6, TRACE_OUTPUT}, /* Uart task, trace ID bit 1 */
+								{PORT_0, PIN7, TRACE_OUTPUT}, /* Trace ID bit 2 */
+								{PORT_0, PIN8, TRACE_OUTPUT}, /* Trace ID bit 3 */
 								{PORT_0, PIN9, OUTPUT},
 								{PORT_0, PIN10, OUTPUT},
 								{PORT_0, PIN11, OUTPUT},
 								{PORT_0, PIN13, OUTPUT},
-								{PORT_0, PIN14, OUTPUT},
+								{PORT_0, PIN14, INPUT}, /* Button 2 Input */
 								{PORT_0, PIN15, OUTPUT},
 								
 								{PORT_1, PIN0, OUTPUT},
@@ -39,3 +40,16 @@ PinConfig_t PinConfig_array[] =
 							};
 
 uint16_t PinConfig_array_size = sizeof(PinConfig_array)/sizeof(PinConfig_t);
+
+
+/* The buttons report both press and release.  The minimum inter-arrival time
+   is the period of the button tasks in tasks_cfg.h.  It debounces them and
+   matches the 50 tick period the buttons used to be polled at, so the worst
+   case load of the button tasks is unchanged. */
+EdgeConfig_t EdgeConfig_array[] = 
+							{
+								{PIN0, EDGE_BOTH, APP_TASK_PERIOD_BUTTON_1}, /* Button 1 - EINT0 */
+								{PIN14, EDGE_BOTH, APP_TASK_PERIOD_BUTTON_2}, /* Button 2 - EINT3 */
+							};
+
+uint16_t EdgeConfig_array_size = sizeof(EdgeConfig_array)/sizeof(EdgeConfig_t);
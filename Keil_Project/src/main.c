@@ -55,6 +55,7 @@
 /* Standard includes. */
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 /* Scheduler includes. */
 #include "FreeRTOS.h"
@@ -65,6 +66,12 @@
 /* Peripheral includes. */
 #include "serial.h"
 #include "GPIO.h"
+#include "tasks_cfg.h"
+
+/* Demo app includes. */
+#include "HeapBenchmark.h"
+#include "EventGroupsBenchmark.h"
+#include "DelayedTasksBenchmark.h"
 
 
 /*-----------------------------------------------------------*/
@@ -75,12 +82,8 @@
 /* Constants for the ComTest demo application tasks. */
 #define mainCOM_TEST_BAUD_RATE	( ( unsigned long ) 115200 )
 
-#define BUTTON_1_MONITOR_TASK_DELAY 50
-#define BUTTON_2_MONITOR_TASK_DELAY 50
-#define PERIODIC_TASK_DELAY         100
-#define UART_RECEIVER_TASK_DELAY    20
-#define LOAD_1_SIMULATION_DELAY     10
-#define LOAD_2_SIMULATION_DELAY     100
+/* The periods, deadlines, execution times and stack sizes of the tasks are in
+the task table in tasks_cfg.h. */
 #define TICKS_TO_WAIT               20
 #define USR_STRING_LEN              15 
 #define LOAD_1                      (37313)
@@ -89,14 +92,57 @@
 #define QUEUE_SIZE                  10
 #define QUEUE_MEMBER_SIZE           15
 #define APP_STATS_BUFFER_SIZE				240
-
-
-TaskHandle_t Button_1_Monitor_TASK_TaskHandler  = NULL;
-TaskHandle_t Button_2_Monitor_TASK_TaskHandler  = NULL;
-TaskHandle_t Uart_Receiver_TaskHandler          = NULL;
-TaskHandle_t Periodic_Transmitter_TaskHandler   = NULL;
-TaskHandle_t Load_1_Simulation_TaskHandler      = NULL;
-TaskHandle_t Load_2_Simulation_TaskHandler      = NULL;
+#define APP_STACK_REPORT_BUFFER_SIZE		400
+#define APP_STACK_REPORT_PERIODS			500	/* Print the stack report every 10s. */
+#define APP_WCET_FRAME_BUFFER_SIZE			512	/* Room for the frame of up to 7 tasks with the default configuration. */
+#define APP_WCET_FRAME_PERIODS				500	/* Send the execution time frame every 10s. */
+#define APP_BENCHMARK_REPORT_BUFFER_SIZE	120
+#define APP_BENCHMARK_REPORT_PERIODS		500	/* Print the benchmark results every 10s. */
+
+/* Set to 1 to run the benchmark of HeapBenchmark.c alongside the tasks.  It
+takes up to 4 KB of the heap, plus its own task.  Build with heap_2.c, heap_4.c
+and heap_tlsf.c in turn to compare them. */
+#define mainCREATE_HEAP_BENCHMARK			0
+
+/* Set to 1 to run the benchmark of EventGroupsBenchmark.c alongside the tasks.
+Its nine tasks take about 6 KB of the heap, so run it with the heap benchmark
+off.  Set configEVENT_GROUP_WAITER_BUCKETS to 1 and to 8 in turn to compare. */
+#define mainCREATE_EVENT_GROUPS_BENCHMARK	0
+
+/* Set to 1 to run the benchmark of DelayedTasksBenchmark.c alongside the
+tasks.  Its twelve tasks take about 8 KB of the heap, so run it on its own.
+Set configUSE_DELAY_WHEEL to 0 and to 1 in turn to compare. */
+#define mainCREATE_DELAYED_TASKS_BENCHMARK	0
+
+/* 1 if Uart_Receiver_Task writes any of the periodic reports. */
+#define mainWRITE_REPORTS					( ( configUSE_STACK_PROFILER == 1 ) || ( configUSE_WCET_PROFILER == 1 ) || ( mainCREATE_HEAP_BENCHMARK == 1 ) || ( mainCREATE_EVENT_GROUPS_BENCHMARK == 1 ) || ( mainCREATE_DELAYED_TASKS_BENCHMARK == 1 ) )
+
+
+/* Task handles, indexed by APP_TASK_ID_<Id>. */
+TaskHandle_t g_arr_x_task_handles[ APP_TASK_COUNT ];
+
+/* The task functions. */
+#define APP_TASK_PROTOTYPE( Id, Entry, Name, Period, Deadline, Wcet, Stack, Release )		void Entry( void *pvParameters );
+APP_TASK_TABLE( APP_TASK_PROTOTYPE )
+
+/* Statically allocated TCBs and stacks, so creating the tasks takes nothing
+from the heap. */
+#define APP_TASK_STORAGE( Id, Entry, Name, Period, Deadline, Wcet, Stack, Release )	\
+	static StaticTask_t g_x_tcb_##Id;												\
+	static StackType_t g_arr_x_stack_##Id[ Stack ];
+APP_TASK_TABLE( APP_TASK_STORAGE )
+
+/* Each deadline must be no later than the period. */
+#define APP_TASK_CHECK_DEADLINE( Id, Entry, Name, Period, Deadline, Wcet, Stack, Release )	\
+	typedef char APP_TASK_DEADLINE_AFTER_PERIOD_##Id[ ( ( Deadline ) <= ( Period ) ) ? 1 : -1 ];
+APP_TASK_TABLE( APP_TASK_CHECK_DEADLINE )
+
+/* EDF meets every deadline if the densities, Wcet / Deadline, of the tasks add
+up to no more than 1.  Each density is in millionths, rounded up.  With every
+deadline equal to the period this is the utilization. */
+#define APP_TASK_DENSITY( Id, Entry, Name, Period, Deadline, Wcet, Stack, Release )	\
+	+ ( ( ( unsigned long ) ( Wcet ) * ( unsigned long ) configTICK_RATE_HZ + ( unsigned long ) ( Deadline ) - 1UL ) / ( unsigned long ) ( Deadline ) )
+typedef char APP_TASK_SET_NOT_SCHEDULABLE[ ( ( 0UL APP_TASK_TABLE( APP_TASK_DENSITY ) ) <= 1000000UL ) ? 1 : -1 ];
 
 /* Queue handler */
 QueueHandle_t xQueue = NULL;
@@ -125,25 +171,61 @@ unsigned int g_u32_system_time;
 unsigned int g_u32_cpu_load;
 
 unsigned char g_arr_u8_runtime_stats_buff [APP_STATS_BUFFER_SIZE];
+
+#if ( configUSE_STACK_PROFILER == 1 )
+	/* Kept off the task stack, which is what is being measured. */
+	char g_arr_c_stack_report_buff [APP_STACK_REPORT_BUFFER_SIZE];
+#endif
+
+#if ( configUSE_WCET_PROFILER == 1 )
+	uint8_t g_arr_u8_wcet_frame_buff [APP_WCET_FRAME_BUFFER_SIZE];
+#endif
+
+#if ( ( mainCREATE_HEAP_BENCHMARK == 1 ) || ( mainCREATE_EVENT_GROUPS_BENCHMARK == 1 ) || ( mainCREATE_DELAYED_TASKS_BENCHMARK == 1 ) )
+	char g_arr_c_benchmark_report_buff [APP_BENCHMARK_REPORT_BUFFER_SIZE];
+#endif
+
+/* Memory of the idle task, which is created statically like the others. */
+static StaticTask_t g_x_idle_tcb;
+static StackType_t g_arr_x_idle_stack[ configMINIMAL_STACK_SIZE ];
 /*
  * Configure the processor for use with the Keil demo board.  This is very
  * minimal as most of the setup is managed by the settings in the project
  * file.
  */
 static void prvSetupHardware( void );
+
+/*
+ * Called from the external interrupt when a button changes state.  Releases a
+ * job of the task that monitors the button.
+ */
+static uint8_t prvButtonEdge( pinX_t pinNum, pinState_t pinState );
+
+/*
+ * Creates the tasks of the task table in tasks_cfg.h.
+ */
+static void prvCreateTasks( void );
+
+#if ( mainWRITE_REPORTS == 1 )
+/*
+ * Writes a report on the terminal once the messages already queued for the
+ * UART have gone out.  Returns pdFALSE if the report could not be written in
+ * full, in which case Uart_Receiver_Task tries again the next period.
+ */
+static BaseType_t prvWriteReport( const void *pvReport, size_t xLength );
+#endif
 /*-----------------------------------------------------------*/
 
 /* ---------------------------- Task implementation starts here. ---------------------------- */
 
 void Button_1_Monitor_Task (void *pvParameters) {
-  TickType_t currentTick = 0;
-  currentTick = xTaskGetTickCount();
-  
-  vTaskSetApplicationTaskTag(NULL, (void *) PIN2);
+  vTaskSetApplicationTaskTag(NULL, (void *) traceID_BUTTON_1);
   
   for ( ;; ) 
 	{
-    g_Button_1_currentState = GPIO_read(PORT_0, PIN0);
+    /* Wait for the edge interrupt to release the next job.  The interrupt
+    stores the level of the button in g_Button_1_currentState. */
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
     
 		/* If push button is pressed, take the semaphore if avialable. */
     if (g_Button_1_previousState == PIN_IS_LOW && g_Button_1_currentState == PIN_IS_HIGH) 
@@ -163,20 +245,18 @@ void Button_1_Monitor_Task (void *pvParameters) {
 		{
       /* Do nothing. */
     }
-    vTaskDelayUntil(&currentTick, BUTTON_1_MONITOR_TASK_DELAY);
 		GPIO_write(PORT_0, PIN9, PIN_IS_LOW);
   }
 }
 
 void Button_2_Monitor_Task (void *pvParameters) {
-  TickType_t currentTick = 0;
-  currentTick = xTaskGetTickCount();
-  
-  vTaskSetApplicationTaskTag(NULL, (void *) PIN3);
+  vTaskSetApplicationTaskTag(NULL, (void *) traceID_BUTTON_2);
   
   for ( ;; ) 
 	{
-    g_Button_2_currentState = GPIO_read(PORT_0, PIN1);
+    /* Wait for the edge interrupt to release the next job.  The interrupt
+    stores the level of the button in g_Button_2_currentState. */
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
     
     /* If push button is pressed, take the semaphore if avialable. */
     if (g_Button_2_previousState == PIN_IS_LOW && g_Button_2_currentState == PIN_IS_HIGH)
@@ -197,41 +277,68 @@ void Button_2_Monitor_Task (void *pvParameters) {
 		{    
       /* Do nothing. */
     }
-    vTaskDelayUntil(&currentTick, BUTTON_2_MONITOR_TASK_DELAY);
 		GPIO_write(PORT_0, PIN9, PIN_IS_LOW);
   }
 }
   
 void Periodic_Transmitter_Task (void *pvParameters) {
-  TickType_t currentTick = 0;
-  currentTick = xTaskGetTickCount();
-  
-  vTaskSetApplicationTaskTag(NULL, (void *) PIN5);
+  vTaskSetApplicationTaskTag(NULL, (void *) traceID_PERIODIC);
   
   for ( ;; ) 
 	{
     xQueueSend(xQueue, (void *)&Msg_3, ( TickType_t ) TICKS_TO_WAIT);
-    vTaskDelayUntil(&currentTick, PERIODIC_TASK_DELAY);
+    vTaskDelayUntilNextRelease();
 		GPIO_write(PORT_0, PIN9, PIN_IS_LOW);
   }
 } 
 
 void Uart_Receiver_Task (void *pvParameters) {
-  TickType_t currentTick = 0;
-  uint8_t xRxedString[ USR_STRING_LEN ];
-  currentTick = xTaskGetTickCount();
-  
-  vTaskSetApplicationTaskTag(NULL, (void *) PIN6);
+  const uint8_t *pxRxedString;
+  UBaseType_t uxReceived;
+  BaseType_t xWritten;
+#if ( configUSE_STACK_PROFILER == 1 )
+  unsigned int periods = 0;
+#endif
+#if ( configUSE_WCET_PROFILER == 1 )
+  unsigned int wcetPeriods = 0;
+  size_t wcetFrameLength;
+#endif
+#if ( mainCREATE_HEAP_BENCHMARK == 1 )
+  unsigned int benchmarkPeriods = 0;
+  HeapBenchmarkResults_t xHeapResults;
+#endif
+#if ( mainCREATE_EVENT_GROUPS_BENCHMARK == 1 )
+  unsigned int eventGroupPeriods = 0;
+  EventGroupBenchmarkResults_t xEventGroupResults;
+#endif
+#if ( mainCREATE_DELAYED_TASKS_BENCHMARK == 1 )
+  unsigned int delayedTasksPeriods = 0;
+  DelayedTasksBenchmarkResults_t xDelayedTasksResults;
+#endif
+  vTaskSetApplicationTaskTag(NULL, (void *) traceID_UART);
   
   for ( ;; ) 
 	{
     if( xQueue != NULL ) 
 		{
-      if( xQueueReceive( xQueue, &( xRxedString ), ( TickType_t ) TICKS_TO_WAIT ) == pdPASS ) {
-        /* xRxedStructure now contains a copy of xMessage. */
-        
-        /* Write on the terminal */
-        while ( vSerialPutString( (const signed char *) xRxedString, USR_STRING_LEN) == pdFALSE );
+      /* Drain every message queued since the last period, up to a queue
+      full, so the consumer keeps up when several producers fire on the same
+      tick.  Only the first peek blocks.  Each message is written on the
+      terminal straight from its queue slot - the driver buffers it and the
+      UART interrupt sends it - and the slot is then handed back. */
+      for( uxReceived = 0; uxReceived < QUEUE_SIZE; uxReceived++ ) {
+        pxRxedString = pvQueuePeekSlot( xQueue, ( uxReceived == 0 ) ? ( TickType_t ) TICKS_TO_WAIT : ( TickType_t ) 0 );
+        if( pxRxedString == NULL ) {
+          break;
+        }
+        xWritten = vSerialPutString( (const signed char *) pxRxedString, USR_STRING_LEN );
+        vQueueReleaseSlot( xQueue );
+        if( xWritten == pdFALSE ) {
+          /* The transmit buffer stayed full, so the end of this message is
+          lost.  Leave the rest of the batch queued for the next period rather
+          than spend this one blocked on the UART. */
+          break;
+        }
       }
     }
 		
@@ -241,8 +348,78 @@ void Uart_Receiver_Task (void *pvParameters) {
 		//
 		//vSerialPutString(g_arr_u8_runtime_stats_buff,APP_STATS_BUFFER_SIZE);
 
-
-		vTaskDelayUntil(&currentTick, UART_RECEIVER_TASK_DELAY);
+#if ( configUSE_STACK_PROFILER == 1 )
+		/* Name, stack size, peak use and recommended size of each task, in
+		words.  Copy the recommended sizes into the Stack column of the task
+		table in tasks_cfg.h once every task has been through all its paths. */
+		if( ++periods >= APP_STACK_REPORT_PERIODS ) {
+		  vTaskGetStackProfileReport( g_arr_c_stack_report_buff );
+		  if( prvWriteReport( g_arr_c_stack_report_buff, strlen( g_arr_c_stack_report_buff ) ) != pdFALSE ) {
+		    periods = 0;
+		  }
+		}
+#endif
+
+#if ( configUSE_WCET_PROFILER == 1 )
+		/* Binary frame of the execution time histograms of every task, see
+		xTaskGetWcetFrame() in task.h for the layout.  The maximum of each task
+		is the measured WCET to use in the schedulability analysis. */
+		if( ++wcetPeriods >= APP_WCET_FRAME_PERIODS ) {
+		  wcetFrameLength = xTaskGetWcetFrame( g_arr_u8_wcet_frame_buff, sizeof( g_arr_u8_wcet_frame_buff ) );
+		  if( ( wcetFrameLength == 0 ) || ( prvWriteReport( g_arr_u8_wcet_frame_buff, wcetFrameLength ) != pdFALSE ) ) {
+		    wcetPeriods = 0;
+		  }
+		}
+#endif
+
+#if ( mainCREATE_HEAP_BENCHMARK == 1 )
+		/* Worst case times in Timer1 counts, the allocations that failed for
+		fragmentation, and the free bytes against the largest block that could
+		still be allocated at the end of the last pass. */
+		if( ++benchmarkPeriods >= APP_BENCHMARK_REPORT_PERIODS ) {
+		  vGetHeapBenchmarkResults( &xHeapResults );
+		  sprintf( g_arr_c_benchmark_report_buff, "Heap: %s passes %lu malloc %lu free %lu frag %lu free %lu largest %lu\n",
+		           ( xAreHeapBenchmarkTasksStillRunning() == pdPASS ) ? "OK" : "FAIL",
+		           ( unsigned long ) xHeapResults.ulPasses, ( unsigned long ) xHeapResults.ulMaximumMallocTime,
+		           ( unsigned long ) xHeapResults.ulMaximumFreeTime, ( unsigned long ) xHeapResults.ulFragmentationFailures,
+		           ( unsigned long ) xHeapResults.xFreeBytes, ( unsigned long ) xHeapResults.xLargestAllocation );
+		  if( prvWriteReport( g_arr_c_benchmark_report_buff, strlen( g_arr_c_benchmark_report_buff ) ) != pdFALSE ) {
+		    benchmarkPeriods = 0;
+		  }
+		}
+#endif
+
+#if ( mainCREATE_EVENT_GROUPS_BENCHMARK == 1 )
+		/* Best, worst and total time of xEventGroupSetBits() in Timer1 counts,
+		over the number of calls made. */
+		if( ++eventGroupPeriods >= APP_BENCHMARK_REPORT_PERIODS ) {
+		  vGetEventGroupBenchmarkResults( &xEventGroupResults );
+		  sprintf( g_arr_c_benchmark_report_buff, "EventGroups: %s calls %lu min %lu max %lu total %lu\n",
+		           ( xAreEventGroupBenchmarkTasksStillRunning() == pdPASS ) ? "OK" : "FAIL",
+		           ( unsigned long ) xEventGroupResults.ulSetBitsCalls, ( unsigned long ) xEventGroupResults.ulMinimumSetBitsTime,
+		           ( unsigned long ) xEventGroupResults.ulMaximumSetBitsTime, ( unsigned long ) xEventGroupResults.ulTotalSetBitsTime );
+		  if( prvWriteReport( g_arr_c_benchmark_report_buff, strlen( g_arr_c_benchmark_report_buff ) ) != pdFALSE ) {
+		    eventGroupPeriods = 0;
+		  }
+		}
+#endif
+
+#if ( mainCREATE_DELAYED_TASKS_BENCHMARK == 1 )
+		/* The jobs of the sleepers and the Timer1 counts they took, which is
+		mostly the time spent blocking them again. */
+		if( ++delayedTasksPeriods >= APP_BENCHMARK_REPORT_PERIODS ) {
+		  vGetDelayedTasksBenchmarkResults( &xDelayedTasksResults );
+		  sprintf( g_arr_c_benchmark_report_buff, "DelayedTasks: %s jobs %lu run time %lu per job %lu\n",
+		           ( xAreDelayedTasksBenchmarkTasksStillRunning() == pdPASS ) ? "OK" : "FAIL",
+		           ( unsigned long ) xDelayedTasksResults.ulJobs, ( unsigned long ) xDelayedTasksResults.ulSleeperRunTime,
+		           ( unsigned long ) ( ( xDelayedTasksResults.ulJobs != 0 ) ? ( xDelayedTasksResults.ulSleeperRunTime / xDelayedTasksResults.ulJobs ) : 0 ) );
+		  if( prvWriteReport( g_arr_c_benchmark_report_buff, strlen( g_arr_c_benchmark_report_buff ) ) != pdFALSE ) {
+		    delayedTasksPeriods = 0;
+		  }
+		}
+#endif
+
+		vTaskDelayUntilNextRelease();
 		
 		GPIO_write(PORT_0, PIN9, PIN_IS_LOW);
   }
@@ -250,40 +427,70 @@ void Uart_Receiver_Task (void *pvParameters) {
 
 void Load_1_Simulation( void *pvParameters ) {
   int count;
-  TickType_t xLastWakeTime;
-  xLastWakeTime = xTaskGetTickCount();
 	
-	vTaskSetApplicationTaskTag(NULL, (void *) PIN7);
+	vTaskSetApplicationTaskTag(NULL, (void *) traceID_LOAD_1);
   
   for( ;; ) {	
     for ( count = 0; count < LOAD_1; count++ ) {
       /* for loop to make the excutions time 5ms*/
     }
-    vTaskDelayUntil(&xLastWakeTime, LOAD_1_SIMULATION_DELAY);
+    vTaskDelayUntilNextRelease();
 		GPIO_write(PORT_0, PIN9, PIN_IS_LOW);
   } 
 }
 
 void Load_2_Simulation( void * pvParameters ) {
   int count;
-  TickType_t xLastWakeTime;
-  xLastWakeTime = xTaskGetTickCount();
 	
-	vTaskSetApplicationTaskTag(NULL,(void *) PIN8);
+	vTaskSetApplicationTaskTag(NULL,(void *) traceID_LOAD_2);
     for( ;; ) {
       for ( count = 0; count < LOAD_2; count++) {
         /* for loop to make the excutions time 12ms*/
       }
-      vTaskDelayUntil(&xLastWakeTime, LOAD_2_SIMULATION_DELAY);
+      vTaskDelayUntilNextRelease();
 			GPIO_write(PORT_0, PIN9, PIN_IS_LOW);
     } 
 }
 
 /* ---------------------------- Task implementation ends here. ---------------------------- */
 
+#if ( mainWRITE_REPORTS == 1 )
+static BaseType_t prvWriteReport( const void *pvReport, size_t xLength ) {
+  /* A report is longer than the messages, so it waits for the transmitter to
+  go idle and then has the whole transmit buffer, rather than timing out
+  behind the messages. */
+  if( xSerialWaitForTxComplete( ( TickType_t ) TICKS_TO_WAIT ) == pdFALSE ) {
+    return pdFALSE;
+  }
+  
+  return vSerialPutString( (const signed char *) pvReport, ( unsigned short ) xLength );
+}
+#endif
+
+static uint8_t prvButtonEdge( pinX_t pinNum, pinState_t pinState ) {
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  
+  if ( pinNum == PIN0 ) {
+    g_Button_1_currentState = pinState;
+    ( void ) xTaskReleaseSporadicFromISR( g_arr_x_task_handles[ APP_TASK_ID_BUTTON_1 ], &xHigherPriorityTaskWoken );
+  }
+  else if ( pinNum == PIN14 ) {
+    g_Button_2_currentState = pinState;
+    ( void ) xTaskReleaseSporadicFromISR( g_arr_x_task_handles[ APP_TASK_ID_BUTTON_2 ], &xHigherPriorityTaskWoken );
+  }
+  else {
+    /* No other pin has an edge interrupt enabled. */
+  }
+  
+  return ( uint8_t ) xHigherPriorityTaskWoken;
+}
+
 void vApplicationTickHook(void) {
   GPIO_write(PORT_0, PIN4, PIN_IS_HIGH);
   GPIO_write(PORT_0, PIN4, PIN_IS_LOW);
+  
+  /* Pass on a button level that settled inside the debounce window. */
+  GPIO_tickHandler();
 }
 
 void vApplicationIdleHook()
@@ -292,7 +499,7 @@ void vApplicationIdleHook()
 	if( tagInit == 0 )
 	{
 		GPIO_write(PORT_0, PIN0, PIN_IS_HIGH);
-		vTaskSetApplicationTaskTag(NULL, (void *) PIN9);
+		vTaskSetApplicationTaskTag(NULL, (void *) traceID_IDLE);
 		tagInit = 1;
 	}
 }
@@ -310,126 +517,36 @@ int main( void )
   /* Initialize UART */
   xSerialPortInitMinimal(mainCOM_TEST_BAUD_RATE);
   
-  /* Create a queue capable of containing 10 15 bits values. */
-  xQueue = xQueueCreate( QUEUE_SIZE, QUEUE_MEMBER_SIZE * sizeof( uint8_t ) );
+  /* Create a queue capable of containing 10 15 bits values.  Messages inherit
+  the deadline of the job that sent them, so button events (period 50) are
+  written out ahead of the periodic string (period 100) queued before them. */
+  xQueue = xQueueCreateDeadlineOrdered( QUEUE_SIZE, QUEUE_MEMBER_SIZE * sizeof( uint8_t ) );
+
+  /* Drop the least urgent message rather than blocking the button and
+  periodic tasks when the consumer falls behind. */
+  vQueueSetOverwriteOldest( xQueue, pdTRUE );
 	
-   /* ------------------------------------------ Create Tasks here ------------------------------------------*/
-  
-  /* Create Task 1 (Button 1 Monitor) */
-  xTaskCreatePeriodic(
-  Button_1_Monitor_Task,
-	"Button 1",
-	configMINIMAL_STACK_SIZE,
-	NULL,
-	1,
-	&Button_1_Monitor_TASK_TaskHandler,
-	BUTTON_1_MONITOR_TASK_DELAY);
+  /* ------------------------------------------ Create Tasks here ------------------------------------------*/
   
-  /* Create Task 2 (Button 2 Monitor) */
-  xTaskCreatePeriodic(
-	Button_2_Monitor_Task,
-	"Button 2",
-	configMINIMAL_STACK_SIZE,
-	NULL,
-	1,
-	&Button_2_Monitor_TASK_TaskHandler,
-	BUTTON_2_MONITOR_TASK_DELAY);
-
-  /* Create the periodic task */
-  xTaskCreatePeriodic(
-	Periodic_Transmitter_Task,
-	"Periodic",
-	configMINIMAL_STACK_SIZE,
-	NULL,
-	1,
-	&Periodic_Transmitter_TaskHandler,
-	PERIODIC_TASK_DELAY);
-
-  /* Create the consumer task (UART recieve) */
-  xTaskCreatePeriodic(
-	Uart_Receiver_Task,
-	"Uart",
-	configMINIMAL_STACK_SIZE,
-	NULL,
-	1,
-	&Uart_Receiver_TaskHandler, 
-	UART_RECEIVER_TASK_DELAY);
-  
-  /* Create the load simulation task (Load 1 simulation) */
-  xTaskCreatePeriodic(
-	Load_1_Simulation,
-	"Load 1",
-	configMINIMAL_STACK_SIZE,
-	NULL,
-	1,
-	&Load_1_Simulation_TaskHandler,
-	LOAD_1_SIMULATION_DELAY);
-
-  /* Create the load simulation task (Load 2 simulation) */
-  xTaskCreatePeriodic(
-	Load_2_Simulation,
-	"Load 2",
-	configMINIMAL_STACK_SIZE,
-	NULL,
-	1,
-	&Load_2_Simulation_TaskHandler,
-	LOAD_2_SIMULATION_DELAY);  
-
-
-
-/*---------------------------------*/
-// xTaskCreate(
-//  Button_1_Monitor_Task,
-// "Button 1",
-// configMINIMAL_STACK_SIZE,
-// NULL,
-// 1,
-// &Button_1_Monitor_TASK_TaskHandler);
-//  
-//  /* Create Task 2 (Button 2 Monitor) */
-//  xTaskCreate(
-// Button_2_Monitor_Task,
-// "Button 2",
-// configMINIMAL_STACK_SIZE,
-// NULL,
-// 1,
-// &Button_2_Monitor_TASK_TaskHandler);
-// 
-//  /* Create the periodic task */
-//  xTaskCreate(
-// Periodic_Transmitter_Task,
-// "Periodic",
-// configMINIMAL_STACK_SIZE,
-// NULL,
-// 1,
-// &Periodic_Transmitter_TaskHandler);
-// 
-//  /* Create the consumer task (UART recieve) */
-//  xTaskCreate(
-// Uart_Receiver_Task,
-// "UART",
-// configMINIMAL_STACK_SIZE,
-// NULL,
-// 1,
-// &Uart_Receiver_TaskHandler);
-//  
-//  /* Create the load simulation task (Load 1 simulation) */
-//  xTaskCreate(
-// Load_1_Simulation,
-// "Load 1",
-// configMINIMAL_STACK_SIZE,
-// NULL,
-// 1,
-// &Load_1_Simulation_TaskHandler);
-// 
-//  /* Create the load simulation task (Load 2 simulation) */
-//  xTaskCreate(
-// Load_2_Simulation,
-// "Load 2",
-// configMINIMAL_STACK_SIZE,
-// NULL,
-// 1,
-// &Load_2_Simulation_TaskHandler);  
+  prvCreateTasks();
+
+#if ( mainCREATE_HEAP_BENCHMARK == 1 )
+  vStartHeapBenchmarkTasks();
+#endif
+
+#if ( mainCREATE_EVENT_GROUPS_BENCHMARK == 1 )
+  vStartEventGroupBenchmarkTasks();
+#endif
+
+#if ( mainCREATE_DELAYED_TASKS_BENCHMARK == 1 )
+  vStartDelayedTasksBenchmarkTasks();
+#endif
+
+  /* The button tasks are sporadic - their jobs are released by the edge
+  interrupts.  The handles are needed by prvButtonEdge(), so enable the edge
+  interrupts only once the tasks exist. */
+  GPIO_enableEdgeInterrupt(PIN0, prvButtonEdge);
+  GPIO_enableEdgeInterrupt(PIN14, prvButtonEdge);
 
 /* Now all the tasks have been started - start the scheduler.
 
@@ -446,18 +563,88 @@ int main( void )
 }
 /*-----------------------------------------------------------*/
 
-/* Function to reset timer 1 */
+static void prvCreateTasks( void )
+{
+	/* Create each task with both its period and its relative deadline, by the
+	function for its Release column.  The periodic tasks are then released by
+	vTaskDelayUntilNextRelease() one period apart, and the button tasks by the
+	edge interrupt no sooner than one period apart.  The table is in ticks,
+	which the kernel may time in microseconds instead. */
+	#define APP_TASK_CREATE_PERIODIC	xTaskCreatePeriodicWithDeadlineStatic
+	#define APP_TASK_CREATE_SPORADIC	xTaskCreateSporadicStatic
+
+	#define APP_TASK_CREATE( Id, Entry, Name, Period, Deadline, Wcet, Stack, Release )									\
+		g_arr_x_task_handles[ APP_TASK_ID_##Id ] = APP_TASK_CREATE_##Release( Entry, Name, Stack, NULL, 1,				\
+																			  g_arr_x_stack_##Id, &g_x_tcb_##Id,		\
+																			  tskTICKS_TO_EDF_TIME( Period ),			\
+																			  tskTICKS_TO_EDF_TIME( Deadline ) );		\
+		APP_TASK_SET_WCET( APP_TASK_ID_##Id, Wcet );
+
+	#if ( configUSE_EDF_SLACK_STEALING == 1 )
+		/* The kernel takes the WCET in whole ticks. */
+		#define APP_TASK_SET_WCET( xId, ulWcet )	vTaskSetWcet( g_arr_x_task_handles[ xId ], ( TickType_t ) ( ( ( unsigned long ) ( ulWcet ) * ( unsigned long ) configTICK_RATE_HZ + 999999UL ) / 1000000UL ) )
+	#else
+		#define APP_TASK_SET_WCET( xId, ulWcet )
+	#endif
+
+	APP_TASK_TABLE( APP_TASK_CREATE )
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+{
+	*ppxIdleTaskTCBBuffer = &g_x_idle_tcb;
+	*ppxIdleTaskStackBuffer = g_arr_x_idle_stack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_HIGH_RES_TIME == 0 )
+/* Function to reset timer 1.  Not available when Timer1 is the EDF time base,
+as resetting it would move every release and deadline. */
 void timer1Reset(void)
 {
 	T1TCR |= 0x2;
 	T1TCR &= ~0x2;
 }
+#endif
+
+/* Called by traceTASK_SWITCHED_OUT().  The task times are measured on Timer1,
+which wraps within the hour when it counts microseconds for
+configUSE_EDF_HIGH_RES_TIME.  The system time is therefore added up from
+differences like the task times, and all the totals are halved before they can
+overflow, which keeps the load an average over the recent past. */
+void vUpdateCpuLoad( void )
+{
+static unsigned int u32_last_time = 0;
+unsigned int u32_now = T1TC;
+
+	g_u32_system_time += u32_now - u32_last_time;
+	u32_last_time = u32_now;
+
+	if( g_u32_system_time >= 0x80000000UL )
+	{
+		g_u32_system_time >>= 1;
+		g_u32_button_1_total_time >>= 1;
+		g_u32_button_2_total_time >>= 1;
+		g_u32_periodic_transmitter_total_time >>= 1;
+		g_u32_load_1_total_time >>= 1;
+		g_u32_load_2_total_time >>= 1;
+		g_u32_uart_receiver_total_time >>= 1;
+	}
+
+	g_u32_cpu_load = ((g_u32_button_1_total_time + g_u32_button_2_total_time + g_u32_periodic_transmitter_total_time + g_u32_load_1_total_time + g_u32_load_2_total_time+ g_u32_uart_receiver_total_time)/ (float)g_u32_system_time) * 100;
+}
 
-/* Function to initialize and start timer 1 */
+/* Function to initialize and start timer 1.  With configUSE_EDF_HIGH_RES_TIME
+set to 1 the port starts it instead, counting microseconds for the EDF
+releases. */
 static void configTimer1(void)
 {
+#if ( configUSE_EDF_HIGH_RES_TIME == 0 )
 	T1PR = 1000;
 	T1TCR |= 0x1;
+#endif
 }
 
 static void prvSetupHardware( void )
@@ -40,6 +40,8 @@
 #include "FreeRTOS.h"
 #include "queue.h"
 #include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
 
 /* Demo application includes. */
 #include "serial.h"
@@ -58,6 +60,8 @@
 #define ser8_BIT_CHARS					( ( unsigned char ) 0x03 )
 #define serFIFO_ON						( ( unsigned char ) 0x01 )
 #define serCLEAR_FIFO					( ( unsigned char ) 0x06 )
+#define serRX_TRIGGER_8_CHARS			( ( unsigned char ) 0x80 )
+#define serRX_DATA_READY				( ( unsigned char ) 0x01 )
 #define serWANTED_CLOCK_SCALING			( ( unsigned long ) 16 )
 
 /* Constants to setup and access the VIC. */
@@ -76,13 +80,73 @@
 #define serINTERRUPT_SOURCE_MASK		( ( unsigned char ) 0x0f )
 #define serINTERRUPT_IS_PENDING			( ( unsigned char ) 0x01 )
 
+/* The transmit path.  Strings are queued in a stream buffer and moved into the
+16 byte hardware FIFO a FIFO load at a time by the THRE interrupt, so a writer
+only blocks when the stream buffer itself is full. */
+#define serTX_FIFO_LENGTH				( ( size_t ) 16 )
+#define serTX_BUFFER_SIZE				( ( size_t ) 256 )
+#define serTX_BLOCK_TIME				( pdMS_TO_TICKS( 50 ) )
+
+/* The notification index the interrupt uses to wake a task waiting in
+xSerialWaitForTxComplete().  The last index is used so the wait does not take
+a release or any other notification the task is given on index 0. */
+#define serTX_COMPLETE_NOTIFY_INDEX		( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+
+/* The receive path.  The RX FIFO interrupts at 8 characters, and the interrupt
+collects characters in a staging buffer that is only passed on to the stream
+buffer, waking the reader, once serRX_TRIGGER_LEVEL characters have arrived or
+the line goes idle (serSOURCE_RX_TIMEOUT). */
+#define serRX_FIFO_TRIGGER				( ( size_t ) 8 )
+#define serRX_TRIGGER_LEVEL				( ( size_t ) 32 )
+#define serRX_BUFFER_SIZE				( ( size_t ) 128 )
+
 /*-----------------------------------------------------------*/
-unsigned char receivedChar;
-unsigned char isNewCharAvailable = 0;
+/* Characters received but not yet read by the application. */
+static StreamBufferHandle_t xRxStream = NULL;
+
+/* Characters taken from the RX FIFO since the stream buffer was last written.
+Only accessed from the interrupt. */
+static uint8_t ucRxStaging[ serRX_TRIGGER_LEVEL ];
+static size_t xRxStagedBytes = 0;
+
+/* Bytes waiting to be moved into the transmit FIFO. */
+static StreamBufferHandle_t xTxStream = NULL;
+
+/* Serialises writers, as a stream buffer only supports a single writer. */
+static SemaphoreHandle_t xTxMutex = NULL;
+
+/* pdTRUE from the time the first bytes of a transfer are written to the FIFO
+until a THRE interrupt finds the stream buffer empty.  While it is set the
+interrupt owns the FIFO and writers only add to the stream buffer. */
+static volatile BaseType_t xTxInProgress = pdFALSE;
+
+/* The task, if any, waiting in xSerialWaitForTxComplete(). */
+static TaskHandle_t volatile xTxCompleteTask = NULL;
+
+/*
+ * Moves up to serTX_FIFO_LENGTH bytes from the stream buffer into the transmit
+ * FIFO, returning the number of bytes moved.  Called from the THRE interrupt,
+ * or from a critical section when no transfer is in progress.
+ */
+static size_t prvFillTxFifo( BaseType_t *pxHigherPriorityTaskWoken );
+
+/*
+ * Starts the transmitter if the THRE interrupt is not already draining the
+ * stream buffer.
+ */
+static void prvStartTransmission( void );
+
+/*
+ * Adds a received character to the staging buffer, passing the staging buffer
+ * on to the stream buffer if it is then full.
+ */
+static void prvStageRxChar( uint8_t ucChar, BaseType_t *pxHigherPriorityTaskWoken );
+
+/*
+ * Passes any staged characters on to the stream buffer, waking the reader.
+ */
+static void prvFlushRxStaging( BaseType_t *pxHigherPriorityTaskWoken );
 
-unsigned char txBuffer[250];
-unsigned char txDataSizeToSend;
-unsigned char txDataSizeLeftToSend;
 /*
  * The asm wrapper for the interrupt service routine.
  */
@@ -116,7 +180,7 @@ void xSerialPortInitMinimal( unsigned long ulWantedBaud)
 	U1DLM = ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff );
 
 	/* Turn on the FIFO's and clear the buffers. */
-	U1FCR = ( serFIFO_ON | serCLEAR_FIFO );
+	U1FCR = ( serFIFO_ON | serCLEAR_FIFO | serRX_TRIGGER_8_CHARS );
 
 	/* Setup transmission format. */
 	U1LCR = serNO_PARITY | ser1_STOP_BIT | ser8_BIT_CHARS;
@@ -127,6 +191,18 @@ void xSerialPortInitMinimal( unsigned long ulWantedBaud)
 	VICVectAddr1 = ( unsigned long ) vUART_ISREntry;
 	VICVectCntl1 = serU1VIC_CHANNEL | serU1VIC_ENABLE;
 
+	/* The port can be initialised more than once, but the transmit buffer
+	and its mutex are only created the first time. */
+	if( xTxStream == NULL )
+	{
+		xTxStream = xStreamBufferCreate( serTX_BUFFER_SIZE, ( size_t ) 1 );
+		xTxMutex = xSemaphoreCreateMutex();
+		xRxStream = xStreamBufferCreate( serRX_BUFFER_SIZE, ( size_t ) 1 );
+		configASSERT( xTxStream );
+		configASSERT( xTxMutex );
+		configASSERT( xRxStream );
+	}
+
 	/* Enable UART0 interrupts. */
 	U1IER |= serENABLE_INTERRUPTS;
 }
@@ -135,11 +211,9 @@ void xSerialPortInitMinimal( unsigned long ulWantedBaud)
 signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar)
 {
 	/* Get the next character from the buffer.  Return false if no characters
-	are available, or arrive before xBlockTime expires. */
-	if(isNewCharAvailable == 1U)
+	are available. */
+	if( ( xRxStream != NULL ) && ( xStreamBufferReceive( xRxStream, pcRxedChar, ( size_t ) 1, 0 ) != ( size_t ) 0 ) )
 	{
-		isNewCharAvailable = 0U;
-		*pcRxedChar = receivedChar;
 		return pdTRUE;
 	}
 	else
@@ -149,34 +223,188 @@ signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar)
 }
 /*-----------------------------------------------------------*/
 
+size_t xSerialReceive( void *pvBuffer, size_t xBufferLength, TickType_t xTicksToWait )
+{
+	configASSERT( xRxStream );
+
+	/* Returns as soon as the interrupt passes on a burst, which it only does
+	on the trigger level or when the line goes idle. */
+	return xStreamBufferReceive( xRxStream, pvBuffer, xBufferLength, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
 signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsigned short usStringLength )
 {
-	int i;
+const uint8_t *pucNext = ( const uint8_t * ) pcString;
+size_t xBytesLeft = ( size_t ) usStringLength, xBytesSent;
+TickType_t xTicksToWait = serTX_BLOCK_TIME;
+TimeOut_t xTimeOut;
 
-	if(txDataSizeLeftToSend == 0 && pcString != NULL)
+	if( ( pcString == NULL ) || ( xTxStream == NULL ) )
 	{
-	  txDataSizeToSend = usStringLength;
-	  txDataSizeLeftToSend = usStringLength;
-	
-	  for(i = 0;i < usStringLength; i++)
-	  {
-		  txBuffer[i] = pcString[i];
-	  }
-	
-	  xSerialPutChar(txBuffer[txDataSizeToSend - txDataSizeLeftToSend--]);
-		
-	  return pdTRUE;
+		return pdFALSE;
 	}
-	else
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	if( xSemaphoreTake( xTxMutex, xTicksToWait ) == pdFALSE )
 	{
 		return pdFALSE;
 	}
+
+	for( ;; )
+	{
+		/* Queue as much of the string as fits without blocking, then make sure
+		the transmitter is running so the space is freed again.  The blocking
+		send below may already have queued the rest, and a stream buffer must
+		not be sent zero bytes. */
+		if( xBytesLeft != ( size_t ) 0 )
+		{
+			xBytesSent = xStreamBufferSend( xTxStream, pucNext, xBytesLeft, 0 );
+			pucNext += xBytesSent;
+			xBytesLeft -= xBytesSent;
+		}
+
+		prvStartTransmission();
+
+		if( ( xBytesLeft == ( size_t ) 0 ) || ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE ) )
+		{
+			break;
+		}
+
+		/* The stream buffer is full.  Block until the interrupt has freed a
+		FIFO load of space - xStreamBufferSend() waits for the whole length it
+		is given, so asking for more could block until the time out even though
+		the interrupt is making progress. */
+		xBytesSent = xStreamBufferSend( xTxStream, pucNext, configMIN( xBytesLeft, serTX_FIFO_LENGTH ), xTicksToWait );
+		pucNext += xBytesSent;
+		xBytesLeft -= xBytesSent;
+	}
+
+	( void ) xSemaphoreGive( xTxMutex );
+
+	return ( xBytesLeft == ( size_t ) 0 ) ? pdTRUE : pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
 void xSerialPutChar(signed char cOutChar)
 {
-	U1THR = cOutChar;
+	/* Go through the stream buffer so the character is not written into the
+	middle of a string that is still being sent.  This takes the writers'
+	mutex, so, unlike the original driver, this cannot be called from an
+	interrupt. */
+	( void ) vSerialPutString( &cOutChar, ( unsigned short ) 1 );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSerialWaitForTxComplete( TickType_t xTicksToWait )
+{
+TimeOut_t xTimeOut;
+BaseType_t xReturn;
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	taskENTER_CRITICAL();
+	{
+		xTxCompleteTask = xTaskGetCurrentTaskHandle();
+	}
+	taskEXIT_CRITICAL();
+
+	for( ;; )
+	{
+		if( xTxInProgress == pdFALSE )
+		{
+			xReturn = pdTRUE;
+			break;
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			xReturn = pdFALSE;
+			break;
+		}
+
+		/* The interrupt gives the notification when it finds the stream buffer
+		empty.  The flag is checked again on waking as a notification given for
+		an earlier transfer may still have been pending. */
+		( void ) ulTaskNotifyTakeIndexed( serTX_COMPLETE_NOTIFY_INDEX, pdTRUE, xTicksToWait );
+	}
+
+	taskENTER_CRITICAL();
+	{
+		xTxCompleteTask = NULL;
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvFillTxFifo( BaseType_t *pxHigherPriorityTaskWoken )
+{
+uint8_t ucFifoLoad[ serTX_FIFO_LENGTH ];
+size_t xBytes, x;
+
+	/* THRE means the whole FIFO is empty, so a full FIFO load can be written
+	in one go. */
+	xBytes = xStreamBufferReceiveFromISR( xTxStream, ucFifoLoad, serTX_FIFO_LENGTH, pxHigherPriorityTaskWoken );
+
+	for( x = 0; x < xBytes; x++ )
+	{
+		U1THR = ucFifoLoad[ x ];
+	}
+
+	return xBytes;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartTransmission( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	taskENTER_CRITICAL();
+	{
+		/* If a transfer is in progress the next THRE interrupt will pick up
+		the new bytes, otherwise the FIFO is idle and has to be primed here as
+		no THRE interrupt is pending. */
+		if( xTxInProgress == pdFALSE )
+		{
+			if( prvFillTxFifo( &xHigherPriorityTaskWoken ) != ( size_t ) 0 )
+			{
+				xTxInProgress = pdTRUE;
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xHigherPriorityTaskWoken != pdFALSE )
+	{
+		taskYIELD();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvStageRxChar( uint8_t ucChar, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	ucRxStaging[ xRxStagedBytes ] = ucChar;
+	xRxStagedBytes++;
+
+	if( xRxStagedBytes >= serRX_TRIGGER_LEVEL )
+	{
+		prvFlushRxStaging( pxHigherPriorityTaskWoken );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFlushRxStaging( BaseType_t *pxHigherPriorityTaskWoken )
+{
+	if( xRxStagedBytes != ( size_t ) 0 )
+	{
+		/* Characters that do not fit are dropped, as they would be if the
+		hardware FIFO overran. */
+		( void ) xStreamBufferSendFromISR( xRxStream, ucRxStaging, xRxStagedBytes, pxHigherPriorityTaskWoken );
+		xRxStagedBytes = 0;
+	}
 }
 /*-----------------------------------------------------------*/
 
@@ -184,6 +412,8 @@ void vUART_ISRHandler( void )
 {
 signed char cChar;
 unsigned char ucInterrupt;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+size_t x;
 
 	ucInterrupt = U1IIR;
 
@@ -198,20 +428,41 @@ unsigned char ucInterrupt;
 				break;
 	
 			case serSOURCE_THRE	:	/* The THRE is empty */
-				
-				/* Do nothing */
-				if(txDataSizeLeftToSend > 0)
+
+				/* Refill the FIFO, or if there is nothing left to send end
+				the transfer and tell any task waiting for it. */
+				if( prvFillTxFifo( &xHigherPriorityTaskWoken ) == ( size_t ) 0 )
 				{
-					U1THR = txBuffer[txDataSizeToSend - txDataSizeLeftToSend--];
+					xTxInProgress = pdFALSE;
+
+					if( xTxCompleteTask != NULL )
+					{
+						vTaskNotifyGiveIndexedFromISR( xTxCompleteTask, serTX_COMPLETE_NOTIFY_INDEX, &xHigherPriorityTaskWoken );
+					}
 				}
-				
 				break;
 	
-			case serSOURCE_RX_TIMEOUT :
-			case serSOURCE_RX	:	/* A character was received */
-			
-				receivedChar = U1RBR;
-				isNewCharAvailable = 1U;			
+			case serSOURCE_RX	:	/* The RX FIFO reached its trigger level */
+
+				/* Leave at least one character in the FIFO, otherwise a burst
+				that is a multiple of the trigger level long would never raise
+				the time out interrupt that marks its end. */
+				for( x = 0; x < ( serRX_FIFO_TRIGGER - ( size_t ) 1 ); x++ )
+				{
+					prvStageRxChar( ( uint8_t ) U1RBR, &xHigherPriorityTaskWoken );
+				}
+				break;
+
+			case serSOURCE_RX_TIMEOUT :	/* The line went idle */
+
+				/* The burst has ended, so empty the FIFO and hand everything
+				to the reader in one go. */
+				while( ( U1LSR & serRX_DATA_READY ) != 0 )
+				{
+					prvStageRxChar( ( uint8_t ) U1RBR, &xHigherPriorityTaskWoken );
+				}
+
+				prvFlushRxStaging( &xHigherPriorityTaskWoken );
 				break;
 	
 			default:	/* There is nothing to do, leave the ISR. */
@@ -221,6 +472,11 @@ unsigned char ucInterrupt;
 		ucInterrupt = U1IIR;
 	}
 
+	/* If the interrupt freed space for a blocked writer, ended a transfer a
+	task is waiting on, or passed a burst to the reader, a context switch might
+	be required. */
+	portEXIT_SWITCHING_ISR( xHigherPriorityTaskWoken );
+
 	/* Clear the ISR in the VIC. */
 	VICVectAddr = serCLEAR_VIC_INTERRUPT;
 }
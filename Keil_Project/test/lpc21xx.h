@@ -0,0 +1,55 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Register model of the LPC21xx UART1 for the host test of serial.c, used in
+ * place of the Keil lpc21xx.h.  Registers the driver only writes are plain
+ * variables.  The transmit and receive FIFOs and the interrupt identification
+ * are modelled in serial_test.c, so the registers with side effects are
+ * accessed through functions.
+ */
+
+#ifndef LPC21XX_HOST_MODEL_H
+#define LPC21XX_HOST_MODEL_H
+
+extern volatile unsigned long PINSEL0;
+extern volatile unsigned long VICIntSelect, VICIntEnable, VICVectAddr, VICVectAddr1, VICVectCntl1;
+extern volatile unsigned char U1LCR, U1DLL, U1DLM, U1FCR, U1IER;
+
+/* Writing U1THR adds a byte to the transmit FIFO, reading U1RBR takes a byte
+from the receive FIFO, and reading U1IIR clears a THRE interrupt it reports. */
+unsigned char *pucHostUartTHR( void );
+unsigned char ucHostUartRBR( void );
+unsigned char ucHostUartIIR( void );
+unsigned char ucHostUartLSR( void );
+
+#define U1THR	( *pucHostUartTHR() )
+#define U1RBR	( ucHostUartRBR() )
+#define U1IIR	( ucHostUartIIR() )
+#define U1LSR	( ucHostUartLSR() )
+
+#endif /* LPC21XX_HOST_MODEL_H */
@@ -0,0 +1,130 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * The host port described in portmacro.h.  Each task runs on its own ucontext
+ * with a stack from malloc().  The stack FreeRTOS allocates for the task is
+ * not used, and the top of stack recorded in the TCB points at the context.
+ */
+
+#define _XOPEN_SOURCE 700
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define portHOST_STACK_SIZE		( ( size_t ) ( 256 * 1024 ) )
+
+volatile unsigned long ulCriticalNesting = 0UL;
+
+/* The context main() returns to when the scheduler ends. */
+static ucontext_t xSchedulerContext;
+
+extern void * volatile pxCurrentTCB;
+
+/* The first member of a TCB is its top of stack, which holds the context. */
+#define portTASK_CONTEXT( pxTCB )	( *( ucontext_t ** ) ( pxTCB ) )
+
+/*
+ * makecontext() only passes int arguments, so the task function and its
+ * parameter are passed in halves.
+ */
+static void prvTaskEntry( unsigned int uxCodeHigh, unsigned int uxCodeLow, unsigned int uxParameterHigh, unsigned int uxParameterLow );
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+ucontext_t *pxContext;
+uint64_t ullCode = ( uint64_t ) ( uintptr_t ) pxCode, ullParameter = ( uint64_t ) ( uintptr_t ) pvParameters;
+
+	( void ) pxTopOfStack;
+
+	pxContext = calloc( 1, sizeof( ucontext_t ) );
+	configASSERT( pxContext );
+	( void ) getcontext( pxContext );
+	pxContext->uc_stack.ss_sp = malloc( portHOST_STACK_SIZE );
+	pxContext->uc_stack.ss_size = portHOST_STACK_SIZE;
+	pxContext->uc_link = NULL;
+	configASSERT( pxContext->uc_stack.ss_sp );
+	makecontext( pxContext, ( void ( * )( void ) ) prvTaskEntry, 4, ( unsigned int ) ( ullCode >> 32 ), ( unsigned int ) ullCode, ( unsigned int ) ( ullParameter >> 32 ), ( unsigned int ) ullParameter );
+
+	return ( StackType_t * ) pxContext;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntry( unsigned int uxCodeHigh, unsigned int uxCodeLow, unsigned int uxParameterHigh, unsigned int uxParameterLow )
+{
+TaskFunction_t pxCode = ( TaskFunction_t ) ( uintptr_t ) ( ( ( uint64_t ) uxCodeHigh << 32 ) | uxCodeLow );
+void *pvParameters = ( void * ) ( uintptr_t ) ( ( ( uint64_t ) uxParameterHigh << 32 ) | uxParameterLow );
+
+	pxCode( pvParameters );
+
+	/* Tasks must not return. */
+	fprintf( stderr, "A task returned from its function.\n" );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+	( void ) swapcontext( &xSchedulerContext, portTASK_CONTEXT( pxCurrentTCB ) );
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	( void ) setcontext( &xSchedulerContext );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+void *pxPreviousTCB = pxCurrentTCB;
+
+	vTaskSwitchContext();
+
+	if( pxPreviousTCB != pxCurrentTCB )
+	{
+		( void ) swapcontext( portTASK_CONTEXT( pxPreviousTCB ), portTASK_CONTEXT( pxCurrentTCB ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortHostTick( void )
+{
+	if( xTaskIncrementTick() != pdFALSE )
+	{
+		vPortYield();
+	}
+}
+/*-----------------------------------------------------------*/
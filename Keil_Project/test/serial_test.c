@@ -0,0 +1,425 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Host test of the UART driver in ../src/serial.c.  The driver is built
+ * against the register model declared in lpc21xx.h, which this file
+ * implements:
+ *
+ * + Each tick the transmitter sends everything in the 16 byte transmit FIFO
+ *   and, if it sent anything, raises the THRE interrupt.
+ * + Each tick up to serTEST_RX_CHARS_PER_TICK characters of the scripted input
+ *   arrive in the 16 byte receive FIFO.  The RX interrupt is raised while the
+ *   FIFO holds 8 or more characters, and the character time out interrupt
+ *   while it holds any and nothing arrived in the last tick.
+ *
+ * The idle hook moves time on, and vUART_ISRHandler() is called whenever an
+ * interrupt is pending, so the driver's tasks and its interrupt interleave as they
+ * would on the target.  Build and run with "make" in this directory, which
+ * runs it under both the priority and the EDF scheduler.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Driver includes. */
+#include "serial.h"
+
+#define serTEST_FIFO_LENGTH				( ( size_t ) 16 )
+#define serTEST_RX_FIFO_TRIGGER			( ( size_t ) 8 )
+#define serTEST_RX_CHARS_PER_TICK		( ( size_t ) 11 )	/* About 115200 baud. */
+#define serTEST_LOG_SIZE				( ( size_t ) 2048 )
+
+/* The test task runs once, so under the EDF scheduler its period only has to
+leave its single job a deadline it cannot miss. */
+#define serTEST_TASK_PERIOD				( ( TickType_t ) 100000 )
+
+/* Interrupt identification values, as in serial.c. */
+#define serTEST_IIR_NONE				( ( unsigned char ) 0x01 )
+#define serTEST_IIR_THRE				( ( unsigned char ) 0x02 )
+#define serTEST_IIR_RX					( ( unsigned char ) 0x04 )
+#define serTEST_IIR_RX_TIMEOUT			( ( unsigned char ) 0x0c )
+
+/* The registers that are plain variables. */
+volatile unsigned long PINSEL0, VICIntSelect, VICIntEnable, VICVectAddr, VICVectAddr1, VICVectCntl1;
+volatile unsigned char U1LCR, U1DLL, U1DLM, U1FCR, U1IER;
+
+/* The transmitter.  Everything it has sent is logged. */
+static unsigned char ucTxFifo[ serTEST_FIFO_LENGTH ];
+static size_t xTxFifoCount = 0;
+static BaseType_t xThrePending = pdFALSE;
+static BaseType_t xTxStalled = pdFALSE;
+static unsigned char ucTxLog[ serTEST_LOG_SIZE ];
+static size_t xTxLogCount = 0;
+
+/* The receiver, and the characters still to arrive. */
+static unsigned char ucRxFifo[ serTEST_FIFO_LENGTH ];
+static size_t xRxFifoCount = 0;
+static const unsigned char *pucRxScript = NULL;
+static size_t xRxScriptLeft = 0;
+static BaseType_t xRxIdle = pdTRUE;
+
+static unsigned long ulFailures = 0UL;
+
+#define serTEST_CHECK( xCondition )																\
+	do {																						\
+		if( !( xCondition ) )																	\
+		{																						\
+			printf( "%s:%d: check failed: %s\n", __FILE__, __LINE__, #xCondition );				\
+			ulFailures++;																		\
+		}																						\
+	} while( 0 )
+
+/*
+ * Returns the interrupt identification the UART would give now.  A THRE
+ * interrupt is only cleared by reading it from U1IIR, so the model's own
+ * checks pass pdFALSE.
+ */
+static unsigned char prvIdentifyInterrupt( BaseType_t xClearThre );
+
+/*
+ * Moves the UART on by one tick, calling vUART_ISRHandler() whenever an
+ * interrupt is pending.
+ */
+static void prvUartStep( void );
+
+/*
+ * Calls vUART_ISRHandler() if an interrupt is pending.
+ */
+static void prvServiceInterrupt( void );
+
+/*
+ * Sends ulLength bytes of a pattern and checks what the UART sent.
+ */
+static void prvTestTransmit( unsigned long ulLength );
+
+/*
+ * Stalls the transmitter so a long string times out, then checks that what
+ * was sent is the start of the string.
+ */
+static void prvTestTransmitTimeout( void );
+
+/*
+ * Receives xLength scripted characters and checks they arrive in bursts.
+ */
+static void prvTestReceive( size_t xLength );
+
+static void prvTestTask( void *pvParameters );
+
+/* The driver's asm wrapper, which is only referenced to set up the VIC. */
+void vUART_ISREntry( void );
+void vUART_ISRHandler( void );
+/*-----------------------------------------------------------*/
+
+void vUART_ISREntry( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+unsigned char *pucHostUartTHR( void )
+{
+	/* A write while the FIFO is full would be lost on the target. */
+	if( xTxFifoCount >= serTEST_FIFO_LENGTH )
+	{
+		printf( "transmit FIFO overrun\n" );
+		ulFailures++;
+		xTxFifoCount = serTEST_FIFO_LENGTH - ( size_t ) 1;
+	}
+
+	xThrePending = pdFALSE;
+	xTxFifoCount++;
+	return &( ucTxFifo[ xTxFifoCount - ( size_t ) 1 ] );
+}
+/*-----------------------------------------------------------*/
+
+unsigned char ucHostUartRBR( void )
+{
+unsigned char ucChar = 0;
+
+	if( xRxFifoCount > ( size_t ) 0 )
+	{
+		ucChar = ucRxFifo[ 0 ];
+		xRxFifoCount--;
+		memmove( ucRxFifo, &( ucRxFifo[ 1 ] ), xRxFifoCount );
+	}
+
+	return ucChar;
+}
+/*-----------------------------------------------------------*/
+
+unsigned char ucHostUartIIR( void )
+{
+	return prvIdentifyInterrupt( pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+unsigned char ucHostUartLSR( void )
+{
+	/* Only the data ready bit is modelled. */
+	return ( xRxFifoCount > ( size_t ) 0 ) ? ( unsigned char ) 0x01 : ( unsigned char ) 0x00;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned char prvIdentifyInterrupt( BaseType_t xClearThre )
+{
+unsigned char ucInterrupt;
+
+	if( xRxFifoCount >= serTEST_RX_FIFO_TRIGGER )
+	{
+		ucInterrupt = serTEST_IIR_RX;
+	}
+	else if( ( xRxFifoCount > ( size_t ) 0 ) && ( xRxIdle != pdFALSE ) )
+	{
+		ucInterrupt = serTEST_IIR_RX_TIMEOUT;
+	}
+	else if( xThrePending != pdFALSE )
+	{
+		ucInterrupt = serTEST_IIR_THRE;
+
+		if( xClearThre != pdFALSE )
+		{
+			xThrePending = pdFALSE;
+		}
+	}
+	else
+	{
+		ucInterrupt = serTEST_IIR_NONE;
+	}
+
+	return ucInterrupt;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUartStep( void )
+{
+size_t x;
+
+	if( ( xTxStalled == pdFALSE ) && ( xTxFifoCount > ( size_t ) 0 ) )
+	{
+		for( x = 0; ( x < xTxFifoCount ) && ( xTxLogCount < serTEST_LOG_SIZE ); x++ )
+		{
+			ucTxLog[ xTxLogCount ] = ucTxFifo[ x ];
+			xTxLogCount++;
+		}
+
+		xTxFifoCount = 0;
+		xThrePending = pdTRUE;
+	}
+
+	xRxIdle = ( xRxScriptLeft == ( size_t ) 0 ) ? pdTRUE : pdFALSE;
+
+	for( x = 0; ( x < serTEST_RX_CHARS_PER_TICK ) && ( xRxScriptLeft > ( size_t ) 0 ); x++ )
+	{
+		/* Characters that arrive while the FIFO is full are lost. */
+		if( xRxFifoCount < serTEST_FIFO_LENGTH )
+		{
+			ucRxFifo[ xRxFifoCount ] = *pucRxScript;
+			xRxFifoCount++;
+		}
+		else
+		{
+			printf( "receive FIFO overrun\n" );
+			ulFailures++;
+		}
+
+		pucRxScript++;
+		xRxScriptLeft--;
+
+		/* The RX interrupt is raised by the character that reaches the
+		trigger level, not at the end of the tick. */
+		prvServiceInterrupt();
+	}
+
+	prvServiceInterrupt();
+}
+/*-----------------------------------------------------------*/
+
+static void prvServiceInterrupt( void )
+{
+	if( prvIdentifyInterrupt( pdFALSE ) != serTEST_IIR_NONE )
+	{
+		vUART_ISRHandler();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	/* Time only moves on when every task is blocked. */
+	prvUartStep();
+	vPortHostTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestTransmit( unsigned long ulLength )
+{
+static signed char cPattern[ serTEST_LOG_SIZE ];
+unsigned long ul;
+
+	for( ul = 0; ul < ulLength; ul++ )
+	{
+		cPattern[ ul ] = ( signed char ) ( 'a' + ( ul % 26UL ) );
+	}
+
+	xTxLogCount = 0;
+
+	/* The string is queued, and the first FIFO load written, without waiting
+	for the transmitter. */
+	serTEST_CHECK( vSerialPutString( cPattern, ( unsigned short ) ulLength ) == pdTRUE );
+	serTEST_CHECK( xSerialWaitForTxComplete( pdMS_TO_TICKS( 100 ) ) == pdTRUE );
+	serTEST_CHECK( xTxLogCount == ( size_t ) ulLength );
+	serTEST_CHECK( memcmp( ucTxLog, cPattern, ( size_t ) ulLength ) == 0 );
+
+	/* Nothing is in progress, so the wait returns at once. */
+	serTEST_CHECK( xSerialWaitForTxComplete( 0 ) == pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestTransmitTimeout( void )
+{
+static signed char cPattern[ 1000 ];
+size_t x;
+TickType_t xStart;
+
+	for( x = 0; x < sizeof( cPattern ); x++ )
+	{
+		cPattern[ x ] = ( signed char ) ( '0' + ( x % 10 ) );
+	}
+
+	xTxLogCount = 0;
+	xTxStalled = pdTRUE;
+
+	/* The string does not fit in the stream buffer and the FIFO, and nothing
+	is taken from them, so the write gives up after 50ms. */
+	xStart = xTaskGetTickCount();
+	serTEST_CHECK( vSerialPutString( cPattern, ( unsigned short ) sizeof( cPattern ) ) == pdFALSE );
+	serTEST_CHECK( ( xTaskGetTickCount() - xStart ) >= pdMS_TO_TICKS( 50 ) );
+	serTEST_CHECK( xSerialWaitForTxComplete( pdMS_TO_TICKS( 5 ) ) == pdFALSE );
+
+	/* Once the transmitter runs again what was queued goes out in order. */
+	xTxStalled = pdFALSE;
+	serTEST_CHECK( xSerialWaitForTxComplete( pdMS_TO_TICKS( 100 ) ) == pdTRUE );
+	serTEST_CHECK( ( xTxLogCount > ( size_t ) 0 ) && ( xTxLogCount < sizeof( cPattern ) ) );
+	serTEST_CHECK( memcmp( ucTxLog, cPattern, xTxLogCount ) == 0 );
+
+	/* The port is usable again. */
+	prvTestTransmit( 20UL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestReceive( size_t xLength )
+{
+static unsigned char ucScript[ 256 ], ucReceived[ 256 ];
+size_t x, xReceived = 0, xBytes;
+unsigned long ulReads = 0UL;
+signed char cChar;
+
+	for( x = 0; x < xLength; x++ )
+	{
+		ucScript[ x ] = ( unsigned char ) ( 'A' + ( x % 26 ) );
+	}
+
+	/* Nothing has arrived yet. */
+	serTEST_CHECK( xSerialGetChar( &cChar ) == pdFALSE );
+
+	pucRxScript = ucScript;
+	xRxScriptLeft = xLength;
+
+	while( xReceived < xLength )
+	{
+		xBytes = xSerialReceive( &( ucReceived[ xReceived ] ), sizeof( ucReceived ) - xReceived, pdMS_TO_TICKS( 100 ) );
+
+		if( xBytes == ( size_t ) 0 )
+		{
+			break;
+		}
+
+		xReceived += xBytes;
+		ulReads++;
+	}
+
+	serTEST_CHECK( xReceived == xLength );
+	serTEST_CHECK( memcmp( ucReceived, ucScript, xLength ) == 0 );
+
+	/* The reader is woken once per 32 characters and once when the line goes
+	idle, not once per character. */
+	serTEST_CHECK( ulReads <= ( unsigned long ) ( ( xLength / ( size_t ) 32 ) + ( size_t ) 1 ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	serTEST_CHECK( vSerialPutString( NULL, ( unsigned short ) 1 ) == pdFALSE );
+	prvTestTransmit( 5UL );
+	prvTestTransmit( 16UL );
+	prvTestTransmit( 600UL );
+	prvTestTransmitTimeout();
+
+	/* A burst that is a multiple of the RX FIFO trigger level still ends
+	with a time out interrupt. */
+	prvTestReceive( ( size_t ) 5 );
+	prvTestReceive( ( size_t ) 16 );
+	prvTestReceive( ( size_t ) 100 );
+
+	if( ulFailures == 0UL )
+	{
+		printf( "serial_test: PASS\n" );
+	}
+	else
+	{
+		printf( "serial_test: %lu checks failed\n", ulFailures );
+	}
+
+	exit( ( ulFailures == 0UL ) ? EXIT_SUCCESS : EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xSerialPortInitMinimal( 115200UL );
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		( void ) xTaskCreatePeriodic( prvTestTask, "Test", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL, serTEST_TASK_PERIOD );
+	}
+	#else
+	{
+		( void ) xTaskCreate( prvTestTask, "Test", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL );
+	}
+	#endif
+	vTaskStartScheduler();
+
+	return EXIT_FAILURE;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,213 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Host test of slack stealing under the EDF scheduler.  Two periodic tasks,
+ * A with a period of 4 ticks and a WCET of 2, and B with a period of 7 and a
+ * WCET of 3, use all but 2 ticks of every 28.  Each job runs for exactly its
+ * WCET, by moving time on itself.  A best-effort task runs whenever it is
+ * given slack.
+ *
+ * Right after both tasks are released the slack is 1, not 2: the demand due by
+ * the deadline of A's second job, at tick 8, is 7 ticks.  Giving away 2 ticks
+ * there makes A miss.  The test checks the slack reported at the start, that
+ * no job misses its deadline, and that the best-effort task gets all the idle
+ * time.  Build and run with "make" in this directory.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define slackTEST_HYPERPERIOD			( ( TickType_t ) 28 )
+#define slackTEST_IDLE_PER_HYPERPERIOD	( ( TickType_t ) 2 )
+#define slackTEST_HYPERPERIODS			( ( TickType_t ) 100 )
+#define slackTEST_TASKS					( 2 )
+
+typedef struct xSLACK_TEST_TASK
+{
+	const char *pcName;
+	TickType_t xPeriod;
+	TickType_t xWcet;
+	TaskHandle_t xHandle;
+	unsigned long ulJobs;
+	unsigned long ulMisses;
+} SlackTestTask_t;
+
+static SlackTestTask_t xTasks[ slackTEST_TASKS ] =
+{
+	{ "A", ( TickType_t ) 4, ( TickType_t ) 2, NULL, 0UL, 0UL },
+	{ "B", ( TickType_t ) 7, ( TickType_t ) 3, NULL, 0UL, 0UL }
+};
+
+static unsigned long ulBestEffortTicks = 0UL;
+static unsigned long ulFailures = 0UL;
+
+#define slackTEST_CHECK( xCondition )															\
+	do {																						\
+		if( !( xCondition ) )																	\
+		{																						\
+			printf( "%s:%d: check failed: %s\n", __FILE__, __LINE__, #xCondition );				\
+			ulFailures++;																		\
+		}																						\
+	} while( 0 )
+
+/*
+ * Moves time on by one tick.  Ends the test once the last hyperperiod is
+ * over.
+ */
+static void prvStep( void );
+
+/*
+ * Checks the results and exits.
+ */
+static void prvReport( void );
+
+/*
+ * A periodic task.  Each job runs for the WCET of the task.
+ */
+static void prvPeriodicTask( void *pvParameters );
+
+/*
+ * Runs whenever it is given slack.
+ */
+static void prvBestEffortTask( void *pvParameters );
+/*-----------------------------------------------------------*/
+
+static void prvStep( void )
+{
+	if( xTaskGetTickCount() >= ( slackTEST_HYPERPERIOD * slackTEST_HYPERPERIODS ) )
+	{
+		prvReport();
+	}
+
+	vPortHostTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( void )
+{
+BaseType_t x;
+
+	for( x = 0; x < slackTEST_TASKS; x++ )
+	{
+		slackTEST_CHECK( xTasks[ x ].ulJobs >= ( unsigned long ) ( ( slackTEST_HYPERPERIOD / xTasks[ x ].xPeriod ) * ( slackTEST_HYPERPERIODS - ( TickType_t ) 1 ) ) );
+
+		if( xTasks[ x ].ulMisses != 0UL )
+		{
+			printf( "slack_test: task %s missed %lu of %lu deadlines\n", xTasks[ x ].pcName, xTasks[ x ].ulMisses, xTasks[ x ].ulJobs );
+			ulFailures++;
+		}
+	}
+
+	/* The idle time at the end of the last hyperperiod may not have come
+	yet. */
+	slackTEST_CHECK( ulBestEffortTicks >= ( unsigned long ) ( slackTEST_IDLE_PER_HYPERPERIOD * ( slackTEST_HYPERPERIODS - ( TickType_t ) 1 ) ) );
+
+	if( ulFailures == 0UL )
+	{
+		printf( "slack_test: PASS\n" );
+	}
+	else
+	{
+		printf( "slack_test: %lu checks failed\n", ulFailures );
+	}
+
+	exit( ( ulFailures == 0UL ) ? EXIT_SUCCESS : EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicTask( void *pvParameters )
+{
+SlackTestTask_t *pxTask = ( SlackTestTask_t * ) pvParameters;
+TickType_t xDeadline, xTicks;
+
+	for( ;; )
+	{
+		xDeadline = xTaskGetCurrentDeadline();
+
+		for( xTicks = 0; xTicks < pxTask->xWcet; xTicks++ )
+		{
+			prvStep();
+		}
+
+		/* Finishing on the deadline tick is in time. */
+		if( ( int32_t ) ( xTaskGetTickCount() - xDeadline ) > 0 )
+		{
+			pxTask->ulMisses++;
+		}
+
+		pxTask->ulJobs++;
+		vTaskDelayUntilNextRelease();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBestEffortTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulBestEffortTicks++;
+		prvStep();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	/* The best-effort task is always ready, so this only runs if no slack is
+	given to it. */
+	prvStep();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+BaseType_t x;
+
+	for( x = 0; x < slackTEST_TASKS; x++ )
+	{
+		slackTEST_CHECK( xTaskCreatePeriodic( prvPeriodicTask, xTasks[ x ].pcName, configMINIMAL_STACK_SIZE, &( xTasks[ x ] ), tskIDLE_PRIORITY + 1, &( xTasks[ x ].xHandle ), xTasks[ x ].xPeriod ) == pdPASS );
+		vTaskSetWcet( xTasks[ x ].xHandle, xTasks[ x ].xWcet );
+	}
+
+	slackTEST_CHECK( xTaskCreateBestEffort( prvBestEffortTask, "BE", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL ) == pdPASS );
+
+	/* Both jobs are released at tick 0. */
+	slackTEST_CHECK( xTaskGetSystemSlack() == ( TickType_t ) 1 );
+
+	vTaskStartScheduler();
+
+	return EXIT_FAILURE;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,1059 @@
+/*
+ * Offline EDF schedulability analyzer.
+ *
+ * Checks a task set before it is flashed:
+ *
+ *  - the processor demand criterion, evaluated with Quick Processor-demand
+ *    Analysis (QPA, Zhang and Burns),
+ *  - the worst case response time of each task under EDF (Spuri),
+ *  - a simulation of the EDF schedule over the hyperperiod, which reports
+ *    deadline misses and the longest response time seen, and
+ *  - optionally, a SimSo XML file, in the form of
+ *    Documents/sismo_simulation.xml, to cross check the result in SimSo.
+ *
+ * The analysis assumes the worst case, synchronous, release of all tasks, so
+ * it holds for sporadic tasks released at their minimum inter-arrival time.
+ * Offsets are only used by the simulation.
+ *
+ * Build it on the host, with any C99 compiler:
+ *
+ *     gcc -std=c99 -O2 -Wall -o edf_analyzer Tools/edf_analyzer.c
+ *
+ * or run "make" in Tools, which also checks it against the task sets in
+ * Tools/test and the task table of the demo.
+ *
+ * Usage:
+ *
+ *     edf_analyzer [-t tick_hz] [-w wcet_frame] [-c counter_hz] [-l limit_us]
+ *                  [-s] [-x simso.xml] tasks
+ *
+ *  tasks      Either a header holding the task table, such as
+ *             Keil_Project/headers/tasks_cfg.h, or a text file with a line
+ *             per task:
+ *                 name period deadline wcet [offset]
+ *             Periods, deadlines and offsets are in ticks, WCETs in
+ *             microseconds, as in the task table.  '#' starts a comment.
+ *  -t         The tick rate in Hz.  Defaults to 1000, configTICK_RATE_HZ of
+ *             the demo.
+ *  -w         A capture of the UART output of the demo built with
+ *             configUSE_WCET_PROFILER set to 1.  The last valid frame written
+ *             by xTaskGetWcetFrame() is found in it, and the measured maximum
+ *             execution time of each task replaces the WCET of the task of the
+ *             same name.
+ *  -c         The rate of the profiler's counter in Hz, needed if the frame
+ *             does not give it (configWCET_COUNTER_HZ left at 0).
+ *  -l         The longest simulation, in microseconds.  Defaults to 10 s.
+ *  -s         Print the simulated schedule.
+ *  -x         Write a SimSo XML file of the task set.
+ *
+ * The exit status is 0 if the task set is schedulable, 1 if it is not and 2
+ * on an error.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+#define anMAX_TASKS				64
+#define anMAX_NAME_LEN			32
+#define anDEFAULT_TICK_HZ		1000UL
+#define anDEFAULT_LIMIT_US		10000000ULL
+
+/* Layout of the frame written by xTaskGetWcetFrame(), see task.h. */
+#define anFRAME_VERSION			1U
+#define anFRAME_HEADER_LENGTH	14U
+#define anFRAME_CRC_LENGTH		2U
+#define anFRAME_RECORD_FIXED	25U
+
+typedef struct
+{
+	char cName[ anMAX_NAME_LEN ];
+	uint64_t ullPeriod;		/* All times in microseconds. */
+	uint64_t ullDeadline;
+	uint64_t ullWcet;
+	uint64_t ullOffset;
+	uint64_t ullWcrt;		/* From the analysis. */
+	uint64_t ullMaxResponse;	/* From the simulation. */
+	uint64_t ullJobs;
+	uint64_t ullMisses;
+} Task_t;
+
+static Task_t xTasks[ anMAX_TASKS ];
+static size_t xTaskCount = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvFail( const char *pcMessage, const char *pcDetail )
+{
+	fprintf( stderr, "edf_analyzer: %s%s%s\n", pcMessage, ( pcDetail != NULL ) ? ": " : "", ( pcDetail != NULL ) ? pcDetail : "" );
+	exit( 2 );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvTicksToMicroseconds( uint64_t ullTicks, unsigned long ulTickHz )
+{
+	return ( ullTicks * 1000000ULL ) / ( uint64_t ) ulTickHz;
+}
+/*-----------------------------------------------------------*/
+
+static int prvParseNumber( const char *pcText, uint64_t *pullValue )
+{
+char *pcEnd;
+unsigned long long ullValue;
+
+	while( isspace( ( unsigned char ) *pcText ) )
+	{
+		pcText++;
+	}
+
+	if( isdigit( ( unsigned char ) *pcText ) == 0 )
+	{
+		return 0;
+	}
+
+	ullValue = strtoull( pcText, &pcEnd, 0 );
+
+	/* Allow the U and L suffixes of C constants. */
+	while( ( *pcEnd == 'U' ) || ( *pcEnd == 'u' ) || ( *pcEnd == 'L' ) || ( *pcEnd == 'l' ) )
+	{
+		pcEnd++;
+	}
+
+	while( isspace( ( unsigned char ) *pcEnd ) )
+	{
+		pcEnd++;
+	}
+
+	*pullValue = ( uint64_t ) ullValue;
+	return ( *pcEnd == '\0' ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+static Task_t *prvAddTask( const char *pcName, uint64_t ullPeriod, uint64_t ullDeadline, uint64_t ullWcet, uint64_t ullOffset, unsigned long ulTickHz )
+{
+Task_t *pxTask;
+
+	if( xTaskCount >= anMAX_TASKS )
+	{
+		prvFail( "too many tasks", NULL );
+	}
+
+	if( ( ullPeriod == 0ULL ) || ( ullDeadline == 0ULL ) )
+	{
+		prvFail( "period and deadline must not be 0", pcName );
+	}
+
+	pxTask = &xTasks[ xTaskCount++ ];
+	memset( pxTask, 0, sizeof( *pxTask ) );
+	strncpy( pxTask->cName, pcName, anMAX_NAME_LEN - 1 );
+	pxTask->ullPeriod = prvTicksToMicroseconds( ullPeriod, ulTickHz );
+	pxTask->ullDeadline = prvTicksToMicroseconds( ullDeadline, ulTickHz );
+	pxTask->ullWcet = ullWcet;
+	pxTask->ullOffset = prvTicksToMicroseconds( ullOffset, ulTickHz );
+
+	return pxTask;
+}
+/*-----------------------------------------------------------*/
+
+/* A row of the task table:
+   TASK( Id, Entry, "Name", Period, Deadline, Wcet, Stack, Release ) */
+static void prvParseTableRow( char *pcRow, unsigned long ulTickHz )
+{
+char *pcFields[ 8 ];
+size_t xFields = 0;
+int iDepth = 0;
+char *pcName, *pcEnd;
+uint64_t ullPeriod, ullDeadline, ullWcet;
+
+	pcFields[ xFields++ ] = pcRow;
+
+	for( ; *pcRow != '\0'; pcRow++ )
+	{
+		if( *pcRow == '(' )
+		{
+			iDepth++;
+		}
+		else if( *pcRow == ')' )
+		{
+			if( iDepth == 0 )
+			{
+				*pcRow = '\0';
+				break;
+			}
+
+			iDepth--;
+		}
+		else if( ( *pcRow == ',' ) && ( iDepth == 0 ) )
+		{
+			*pcRow = '\0';
+
+			if( xFields == 8 )
+			{
+				break;
+			}
+
+			pcFields[ xFields++ ] = pcRow + 1;
+		}
+	}
+
+	if( xFields != 8 )
+	{
+		prvFail( "task table row does not have 8 fields", pcFields[ 0 ] );
+	}
+
+	pcName = strchr( pcFields[ 2 ], '"' );
+	pcEnd = ( pcName != NULL ) ? strchr( pcName + 1, '"' ) : NULL;
+
+	if( pcEnd == NULL )
+	{
+		prvFail( "task name is not a string", pcFields[ 2 ] );
+	}
+
+	*pcEnd = '\0';
+
+	if( ( prvParseNumber( pcFields[ 3 ], &ullPeriod ) == 0 ) ||
+		( prvParseNumber( pcFields[ 4 ], &ullDeadline ) == 0 ) ||
+		( prvParseNumber( pcFields[ 5 ], &ullWcet ) == 0 ) )
+	{
+		prvFail( "period, deadline and WCET must be numbers", pcName + 1 );
+	}
+
+	( void ) prvAddTask( pcName + 1, ullPeriod, ullDeadline, ullWcet, 0ULL, ulTickHz );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReadTasks( const char *pcFileName, unsigned long ulTickHz )
+{
+FILE *pxFile;
+char cLine[ 512 ];
+char *pcRow, *pcComment;
+char cName[ anMAX_NAME_LEN ];
+unsigned long long ullPeriod, ullDeadline, ullWcet, ullOffset;
+int iFields, iInComment = 0, iHeader;
+size_t xNameLength = strlen( pcFileName );
+
+	/* In a header only the rows of the task table are read. */
+	iHeader = ( ( xNameLength > 2U ) && ( strcmp( &pcFileName[ xNameLength - 2U ], ".h" ) == 0 ) ) ? 1 : 0;
+
+	pxFile = fopen( pcFileName, "r" );
+
+	if( pxFile == NULL )
+	{
+		prvFail( "cannot open", pcFileName );
+	}
+
+	while( fgets( cLine, sizeof( cLine ), pxFile ) != NULL )
+	{
+		/* Skip block comments, such as the description of the columns of the
+		task table. */
+		pcRow = cLine;
+
+		if( iInComment != 0 )
+		{
+			pcRow = strstr( cLine, "*/" );
+
+			if( pcRow == NULL )
+			{
+				continue;
+			}
+
+			pcRow += 2;
+			iInComment = 0;
+		}
+
+		pcComment = strstr( pcRow, "/*" );
+
+		if( ( pcComment != NULL ) && ( strstr( pcComment, "*/" ) == NULL ) )
+		{
+			*pcComment = '\0';
+			iInComment = 1;
+		}
+
+		/* A row of the task table starts with TASK(. */
+
+		while( isspace( ( unsigned char ) *pcRow ) )
+		{
+			pcRow++;
+		}
+
+		if( strncmp( pcRow, "TASK(", 5 ) == 0 )
+		{
+			prvParseTableRow( pcRow + 5, ulTickHz );
+			continue;
+		}
+
+		if( iHeader != 0 )
+		{
+			continue;
+		}
+
+		pcComment = strchr( pcRow, '#' );
+
+		if( pcComment != NULL )
+		{
+			*pcComment = '\0';
+		}
+
+		ullOffset = 0ULL;
+		iFields = sscanf( pcRow, "%31s %llu %llu %llu %llu", cName, &ullPeriod, &ullDeadline, &ullWcet, &ullOffset );
+
+		if( iFields <= 0 )
+		{
+			continue;
+		}
+		else if( iFields < 4 )
+		{
+			prvFail( "expected: name period deadline wcet [offset]", pcRow );
+		}
+
+		( void ) prvAddTask( cName, ullPeriod, ullDeadline, ullWcet, ullOffset, ulTickHz );
+	}
+
+	fclose( pxFile );
+
+	if( xTaskCount == 0 )
+	{
+		prvFail( "no tasks found in", pcFileName );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvReadU32( const uint8_t *pucBytes )
+{
+	return ( uint32_t ) pucBytes[ 0 ] | ( ( uint32_t ) pucBytes[ 1 ] << 8 ) | ( ( uint32_t ) pucBytes[ 2 ] << 16 ) | ( ( uint32_t ) pucBytes[ 3 ] << 24 );
+}
+/*-----------------------------------------------------------*/
+
+static uint16_t prvCrc16( const uint8_t *pucBytes, size_t xLength )
+{
+uint16_t usCrc = 0xffffU;
+int iBit;
+
+	while( xLength-- > 0U )
+	{
+		usCrc ^= ( uint16_t ) ( ( uint16_t ) *pucBytes++ << 8 );
+
+		for( iBit = 0; iBit < 8; iBit++ )
+		{
+			usCrc = ( ( usCrc & 0x8000U ) != 0U ) ? ( uint16_t ) ( ( usCrc << 1 ) ^ 0x1021U ) : ( uint16_t ) ( usCrc << 1 );
+		}
+	}
+
+	return usCrc;
+}
+/*-----------------------------------------------------------*/
+
+/* Returns the length of the valid frame at pucFrame, or 0. */
+static size_t prvCheckFrame( const uint8_t *pucFrame, size_t xAvailable )
+{
+size_t xRecordLength, xLength;
+uint16_t usCrc;
+
+	if( ( xAvailable < anFRAME_HEADER_LENGTH + anFRAME_CRC_LENGTH ) ||
+		( pucFrame[ 0 ] != 'W' ) || ( pucFrame[ 1 ] != 'C' ) || ( pucFrame[ 2 ] != anFRAME_VERSION ) )
+	{
+		return 0;
+	}
+
+	xRecordLength = ( size_t ) pucFrame[ 4 ] + anFRAME_RECORD_FIXED + ( 2U * ( size_t ) pucFrame[ 5 ] );
+	xLength = anFRAME_HEADER_LENGTH + ( ( size_t ) pucFrame[ 3 ] * xRecordLength ) + anFRAME_CRC_LENGTH;
+
+	if( xLength > xAvailable )
+	{
+		return 0;
+	}
+
+	usCrc = prvCrc16( pucFrame, xLength - anFRAME_CRC_LENGTH );
+
+	if( ( pucFrame[ xLength - 2U ] != ( uint8_t ) usCrc ) || ( pucFrame[ xLength - 1U ] != ( uint8_t ) ( usCrc >> 8 ) ) )
+	{
+		return 0;
+	}
+
+	return xLength;
+}
+/*-----------------------------------------------------------*/
+
+static void prvApplyWcetFrame( const char *pcFileName, unsigned long ulCounterHz )
+{
+FILE *pxFile;
+uint8_t *pucCapture;
+long lSize;
+size_t xCaptureLength, xOffset, xLength, xFrame = 0, xFrameLength = 0, xRecord, xRecordLength, x;
+const uint8_t *pucRecord;
+char cName[ 256 ];
+uint32_t ulFrameCounterHz, ulJobs, ulMax;
+uint64_t ullWcet;
+int iMatched;
+
+	pxFile = fopen( pcFileName, "rb" );
+
+	if( pxFile == NULL )
+	{
+		prvFail( "cannot open", pcFileName );
+	}
+
+	fseek( pxFile, 0L, SEEK_END );
+	lSize = ftell( pxFile );
+	fseek( pxFile, 0L, SEEK_SET );
+
+	if( lSize <= 0L )
+	{
+		prvFail( "empty WCET capture", pcFileName );
+	}
+
+	pucCapture = malloc( ( size_t ) lSize );
+
+	if( pucCapture == NULL )
+	{
+		prvFail( "out of memory", NULL );
+	}
+
+	xCaptureLength = fread( pucCapture, 1U, ( size_t ) lSize, pxFile );
+	fclose( pxFile );
+
+	/* The capture can hold other output and several frames - use the last
+	one that is complete and passes its CRC. */
+	for( xOffset = 0U; xOffset < xCaptureLength; xOffset++ )
+	{
+		xLength = prvCheckFrame( &pucCapture[ xOffset ], xCaptureLength - xOffset );
+
+		if( xLength != 0U )
+		{
+			xFrame = xOffset;
+			xFrameLength = xLength;
+		}
+	}
+
+	if( xFrameLength == 0U )
+	{
+		prvFail( "no valid WCET frame in", pcFileName );
+	}
+
+	ulFrameCounterHz = prvReadU32( &pucCapture[ xFrame + 6U ] );
+
+	if( ulFrameCounterHz != 0UL )
+	{
+		ulCounterHz = ( unsigned long ) ulFrameCounterHz;
+	}
+	else if( ulCounterHz == 0UL )
+	{
+		prvFail( "the frame does not give the counter rate, use -c", NULL );
+	}
+
+	xRecordLength = ( size_t ) pucCapture[ xFrame + 4U ] + anFRAME_RECORD_FIXED + ( 2U * ( size_t ) pucCapture[ xFrame + 5U ] );
+
+	for( xRecord = 0U; xRecord < ( size_t ) pucCapture[ xFrame + 3U ]; xRecord++ )
+	{
+		pucRecord = &pucCapture[ xFrame + anFRAME_HEADER_LENGTH + ( xRecord * xRecordLength ) ];
+		memcpy( cName, pucRecord, pucCapture[ xFrame + 4U ] );
+		cName[ pucCapture[ xFrame + 4U ] ] = '\0';
+		pucRecord += pucCapture[ xFrame + 4U ];
+
+		/* Period, jobs, min, max, 99th and 90th percentiles follow the name. */
+		ulJobs = prvReadU32( &pucRecord[ 4 ] );
+		ulMax = prvReadU32( &pucRecord[ 12 ] );
+		ullWcet = ( ( ( uint64_t ) ulMax * 1000000ULL ) + ( uint64_t ) ulCounterHz - 1ULL ) / ( uint64_t ) ulCounterHz;
+		iMatched = 0;
+
+		for( x = 0U; x < xTaskCount; x++ )
+		{
+			if( ( strcmp( xTasks[ x ].cName, cName ) == 0 ) && ( ulJobs > 0UL ) )
+			{
+				printf( "%-16s WCET %llu us measured over %lu jobs, was %llu us\n", cName, ( unsigned long long ) ullWcet, ( unsigned long ) ulJobs, ( unsigned long long ) xTasks[ x ].ullWcet );
+				xTasks[ x ].ullWcet = ullWcet;
+				iMatched = 1;
+			}
+		}
+
+		if( iMatched == 0 )
+		{
+			printf( "%-16s not in the task set, %lu jobs up to %llu us\n", cName, ( unsigned long ) ulJobs, ( unsigned long long ) ullWcet );
+		}
+	}
+
+	printf( "\n" );
+	free( pucCapture );
+}
+/*-----------------------------------------------------------*/
+
+/* The processor demand of the jobs that are released and have their deadline
+in [ 0, ullTime ], for a synchronous release. */
+static uint64_t prvDemand( uint64_t ullTime )
+{
+uint64_t ullDemand = 0ULL;
+size_t x;
+
+	for( x = 0U; x < xTaskCount; x++ )
+	{
+		if( ullTime >= xTasks[ x ].ullDeadline )
+		{
+			ullDemand += ( ( ( ullTime - xTasks[ x ].ullDeadline ) / xTasks[ x ].ullPeriod ) + 1ULL ) * xTasks[ x ].ullWcet;
+		}
+	}
+
+	return ullDemand;
+}
+/*-----------------------------------------------------------*/
+
+/* The latest absolute deadline before ullTime, or 0 if there is none. */
+static uint64_t prvLastDeadlineBefore( uint64_t ullTime )
+{
+uint64_t ullLast = 0ULL, ullDeadline;
+size_t x;
+
+	for( x = 0U; x < xTaskCount; x++ )
+	{
+		if( ullTime > xTasks[ x ].ullDeadline )
+		{
+			ullDeadline = ( ( ( ullTime - xTasks[ x ].ullDeadline - 1ULL ) / xTasks[ x ].ullPeriod ) * xTasks[ x ].ullPeriod ) + xTasks[ x ].ullDeadline;
+
+			if( ullDeadline > ullLast )
+			{
+				ullLast = ullDeadline;
+			}
+		}
+	}
+
+	return ullLast;
+}
+/*-----------------------------------------------------------*/
+
+/* The length of the busy period that starts with every task released at once. */
+static uint64_t prvSynchronousBusyPeriod( uint64_t ullLimit )
+{
+uint64_t ullLength = 0ULL, ullNext;
+size_t x;
+
+	for( x = 0U; x < xTaskCount; x++ )
+	{
+		ullLength += xTasks[ x ].ullWcet;
+	}
+
+	for( ;; )
+	{
+		ullNext = 0ULL;
+
+		for( x = 0U; x < xTaskCount; x++ )
+		{
+			ullNext += ( ( ullLength + xTasks[ x ].ullPeriod - 1ULL ) / xTasks[ x ].ullPeriod ) * xTasks[ x ].ullWcet;
+		}
+
+		if( ( ullNext == ullLength ) || ( ullNext > ullLimit ) )
+		{
+			return ullNext;
+		}
+
+		ullLength = ullNext;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static int prvQpa( long double xUtilization, uint64_t ullBusyPeriod, uint64_t *pullFailedAt, unsigned long *pulSteps )
+{
+uint64_t ullLength, ullTime, ullDemand, ullMinDeadline = UINT64_MAX;
+long double xBound = 0.0L;
+size_t x;
+
+	for( x = 0U; x < xTaskCount; x++ )
+	{
+		if( xTasks[ x ].ullDeadline < ullMinDeadline )
+		{
+			ullMinDeadline = xTasks[ x ].ullDeadline;
+		}
+	}
+
+	/* Only the deadlines up to L need checking.  L is the synchronous busy
+	period, or, when the utilization is below 1, the bound La if that is
+	shorter. */
+	ullLength = ullBusyPeriod;
+
+	if( xUtilization < 1.0L )
+	{
+		for( x = 0U; x < xTaskCount; x++ )
+		{
+			if( ( long double ) xTasks[ x ].ullDeadline > xBound )
+			{
+				xBound = ( long double ) xTasks[ x ].ullDeadline;
+			}
+		}
+
+		{
+		long double xSum = 0.0L;
+
+			for( x = 0U; x < xTaskCount; x++ )
+			{
+				if( xTasks[ x ].ullPeriod > xTasks[ x ].ullDeadline )
+				{
+					xSum += ( long double ) ( xTasks[ x ].ullPeriod - xTasks[ x ].ullDeadline ) * ( long double ) xTasks[ x ].ullWcet / ( long double ) xTasks[ x ].ullPeriod;
+				}
+			}
+
+			xSum /= ( 1.0L - xUtilization );
+
+			if( xSum > xBound )
+			{
+				xBound = xSum;
+			}
+		}
+
+		if( xBound < ( long double ) ullLength )
+		{
+			ullLength = ( uint64_t ) xBound + 1ULL;
+		}
+	}
+
+	*pulSteps = 0UL;
+	ullTime = prvLastDeadlineBefore( ullLength + 1ULL );
+
+	if( ullTime == 0ULL )
+	{
+		return 1;
+	}
+
+	ullDemand = prvDemand( ullTime );
+
+	while( ( ullDemand <= ullTime ) && ( ullDemand > ullMinDeadline ) )
+	{
+		( *pulSteps )++;
+
+		if( ullDemand < ullTime )
+		{
+			ullTime = ullDemand;
+		}
+		else
+		{
+			ullTime = prvLastDeadlineBefore( ullTime );
+		}
+
+		ullDemand = prvDemand( ullTime );
+	}
+
+	*pullFailedAt = ullTime;
+	return ( ullDemand <= ullMinDeadline ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+/* Spuri's worst case response time of task xTask under EDF.  The job of the
+task released at a, in a busy period that starts at 0, is checked for every a
+at which the job's deadline lines up with the deadline of a job of some task. */
+static uint64_t prvWorstCaseResponseTime( size_t xTask, uint64_t ullBusyPeriod )
+{
+const Task_t *pxTask = &xTasks[ xTask ];
+uint64_t ullWorst = pxTask->ullWcet, ullStart, ullLength, ullNext, ullJobs, ullCap, ullAbsoluteDeadline;
+size_t x, y;
+
+	for( x = 0U; x < xTaskCount; x++ )
+	{
+		for( ullStart = ( xTasks[ x ].ullDeadline >= pxTask->ullDeadline ) ? ( xTasks[ x ].ullDeadline - pxTask->ullDeadline ) : ( ( ( pxTask->ullDeadline - xTasks[ x ].ullDeadline + xTasks[ x ].ullPeriod - 1ULL ) / xTasks[ x ].ullPeriod ) * xTasks[ x ].ullPeriod + xTasks[ x ].ullDeadline - pxTask->ullDeadline );
+			 ullStart < ullBusyPeriod;
+			 ullStart += xTasks[ x ].ullPeriod )
+		{
+			ullAbsoluteDeadline = ullStart + pxTask->ullDeadline;
+			ullLength = 0ULL;
+
+			for( ;; )
+			{
+				/* The jobs of the task itself up to and including the one
+				released at ullStart... */
+				ullNext = ( ( ullStart / pxTask->ullPeriod ) + 1ULL ) * pxTask->ullWcet;
+
+				/* ...and the jobs of the other tasks released in the window
+				with a deadline no later than its deadline. */
+				for( y = 0U; y < xTaskCount; y++ )
+				{
+					if( ( y != xTask ) && ( xTasks[ y ].ullDeadline <= ullAbsoluteDeadline ) )
+					{
+						ullJobs = ( ullLength + xTasks[ y ].ullPeriod - 1ULL ) / xTasks[ y ].ullPeriod;
+						ullCap = ( ( ullAbsoluteDeadline - xTasks[ y ].ullDeadline ) / xTasks[ y ].ullPeriod ) + 1ULL;
+						ullNext += ( ( ullJobs < ullCap ) ? ullJobs : ullCap ) * xTasks[ y ].ullWcet;
+					}
+				}
+
+				if( ullNext == ullLength )
+				{
+					break;
+				}
+
+				ullLength = ullNext;
+			}
+
+			if( ( ullLength > ullStart ) && ( ( ullLength - ullStart ) > ullWorst ) )
+			{
+				ullWorst = ullLength - ullStart;
+			}
+		}
+	}
+
+	return ullWorst;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGcd( uint64_t ullA, uint64_t ullB )
+{
+uint64_t ullRemainder;
+
+	while( ullB != 0ULL )
+	{
+		ullRemainder = ullA % ullB;
+		ullA = ullB;
+		ullB = ullRemainder;
+	}
+
+	return ullA;
+}
+/*-----------------------------------------------------------*/
+
+/* The hyperperiod, or 0 if it is longer than ullLimit. */
+static uint64_t prvHyperperiod( uint64_t ullLimit )
+{
+uint64_t ullHyperperiod = 1ULL, ullFactor;
+size_t x;
+
+	for( x = 0U; x < xTaskCount; x++ )
+	{
+		ullFactor = xTasks[ x ].ullPeriod / prvGcd( ullHyperperiod, xTasks[ x ].ullPeriod );
+
+		if( ullHyperperiod > ( ullLimit / ullFactor ) )
+		{
+			return 0ULL;
+		}
+
+		ullHyperperiod *= ullFactor;
+	}
+
+	return ullHyperperiod;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintSegment( int iPrint, uint64_t ullStart, uint64_t ullEnd, long lTask )
+{
+	if( ( iPrint != 0 ) && ( ullEnd > ullStart ) )
+	{
+		printf( "%12llu %12llu  %s\n", ( unsigned long long ) ullStart, ( unsigned long long ) ullEnd, ( lTask < 0L ) ? "idle" : xTasks[ lTask ].cName );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Preemptive EDF, each job running for its WCET.  Ties go to the job released
+first, then to the task listed first. */
+static uint64_t prvSimulate( uint64_t ullEnd, int iPrint )
+{
+uint64_t ullNextRelease[ anMAX_TASKS ], ullHeadRelease[ anMAX_TASKS ], ullHeadRemaining[ anMAX_TASKS ], ullPending[ anMAX_TASKS ];
+uint64_t ullTime = 0ULL, ullNextEvent, ullRun, ullResponse, ullMisses = 0ULL, ullSegmentStart = 0ULL;
+long lRunning, lSegmentTask = -1L;
+size_t x;
+
+	for( x = 0U; x < xTaskCount; x++ )
+	{
+		ullNextRelease[ x ] = xTasks[ x ].ullOffset;
+		ullPending[ x ] = 0ULL;
+	}
+
+	if( iPrint != 0 )
+	{
+		printf( "\n%12s %12s  %s\n", "from (us)", "to (us)", "task" );
+	}
+
+	while( ullTime < ullEnd )
+	{
+		ullNextEvent = ullEnd;
+
+		for( x = 0U; x < xTaskCount; x++ )
+		{
+			while( ullNextRelease[ x ] <= ullTime )
+			{
+				if( ullPending[ x ] == 0ULL )
+				{
+					ullHeadRelease[ x ] = ullNextRelease[ x ];
+					ullHeadRemaining[ x ] = xTasks[ x ].ullWcet;
+				}
+
+				ullPending[ x ]++;
+				xTasks[ x ].ullJobs++;
+				ullNextRelease[ x ] += xTasks[ x ].ullPeriod;
+			}
+
+			if( ullNextRelease[ x ] < ullNextEvent )
+			{
+				ullNextEvent = ullNextRelease[ x ];
+			}
+		}
+
+		lRunning = -1L;
+
+		for( x = 0U; x < xTaskCount; x++ )
+		{
+			if( ( ullPending[ x ] != 0ULL ) &&
+				( ( lRunning < 0L ) ||
+				  ( ( ullHeadRelease[ x ] + xTasks[ x ].ullDeadline ) < ( ullHeadRelease[ lRunning ] + xTasks[ lRunning ].ullDeadline ) ) ||
+				  ( ( ( ullHeadRelease[ x ] + xTasks[ x ].ullDeadline ) == ( ullHeadRelease[ lRunning ] + xTasks[ lRunning ].ullDeadline ) ) && ( ullHeadRelease[ x ] < ullHeadRelease[ lRunning ] ) ) ) )
+			{
+				lRunning = ( long ) x;
+			}
+		}
+
+		if( lRunning != lSegmentTask )
+		{
+			prvPrintSegment( iPrint, ullSegmentStart, ullTime, lSegmentTask );
+			ullSegmentStart = ullTime;
+			lSegmentTask = lRunning;
+		}
+
+		if( lRunning < 0L )
+		{
+			ullTime = ullNextEvent;
+			continue;
+		}
+
+		ullRun = ullNextEvent - ullTime;
+
+		if( ullHeadRemaining[ lRunning ] < ullRun )
+		{
+			ullRun = ullHeadRemaining[ lRunning ];
+		}
+
+		ullTime += ullRun;
+		ullHeadRemaining[ lRunning ] -= ullRun;
+
+		if( ullHeadRemaining[ lRunning ] == 0ULL )
+		{
+			ullResponse = ullTime - ullHeadRelease[ lRunning ];
+
+			if( ullResponse > xTasks[ lRunning ].ullMaxResponse )
+			{
+				xTasks[ lRunning ].ullMaxResponse = ullResponse;
+			}
+
+			if( ullResponse > xTasks[ lRunning ].ullDeadline )
+			{
+				xTasks[ lRunning ].ullMisses++;
+				ullMisses++;
+			}
+
+			ullPending[ lRunning ]--;
+
+			if( ullPending[ lRunning ] != 0ULL )
+			{
+				ullHeadRelease[ lRunning ] += xTasks[ lRunning ].ullPeriod;
+				ullHeadRemaining[ lRunning ] = xTasks[ lRunning ].ullWcet;
+			}
+		}
+	}
+
+	prvPrintSegment( iPrint, ullSegmentStart, ullTime, lSegmentTask );
+
+	/* Jobs still waiting at the end that are already late. */
+	for( x = 0U; x < xTaskCount; x++ )
+	{
+		if( ( ullPending[ x ] != 0ULL ) && ( ( ullHeadRelease[ x ] + xTasks[ x ].ullDeadline ) < ullEnd ) )
+		{
+			xTasks[ x ].ullMisses++;
+			ullMisses++;
+		}
+	}
+
+	return ullMisses;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteSimso( const char *pcFileName, uint64_t ullDuration )
+{
+FILE *pxFile;
+size_t x;
+
+	pxFile = fopen( pcFileName, "w" );
+
+	if( pxFile == NULL )
+	{
+		prvFail( "cannot create", pcFileName );
+	}
+
+	/* SimSo takes times in ms.  At 1000000 cycles per ms a cycle is a ns. */
+	fprintf( pxFile, "<?xml version=\"1.0\" ?>\n" );
+	fprintf( pxFile, "<simulation cycles_per_ms=\"1000000\" duration=\"%llu\" etm=\"wcet\">\n", ( unsigned long long ) ( ullDuration * 1000ULL ) );
+	fprintf( pxFile, "\t<sched class=\"simso.schedulers.EDF\" overhead=\"0\" overhead_activate=\"0\" overhead_terminate=\"0\"/>\n" );
+	fprintf( pxFile, "\t<caches memory_access_time=\"100\"/>\n" );
+	fprintf( pxFile, "\t<processors>\n" );
+	fprintf( pxFile, "\t\t<processor cl_overhead=\"0\" cs_overhead=\"0\" id=\"1\" name=\"CPU 1\" speed=\"1.0\"/>\n" );
+	fprintf( pxFile, "\t</processors>\n" );
+	fprintf( pxFile, "\t<tasks>\n" );
+
+	for( x = 0U; x < xTaskCount; x++ )
+	{
+		fprintf( pxFile, "\t\t<task ACET=\"0\" WCET=\"%.3f\" abort_on_miss=\"yes\" activationDate=\"%.3f\" base_cpi=\"1.0\" deadline=\"%.3f\" et_stddev=\"0\" id=\"%u\" instructions=\"0\" list_activation_dates=\"\" mix=\"0.5\" name=\"%s\" period=\"%.3f\" preemption_cost=\"0\" task_type=\"Periodic\"/>\n",
+				 ( double ) xTasks[ x ].ullWcet / 1000.0,
+				 ( double ) xTasks[ x ].ullOffset / 1000.0,
+				 ( double ) xTasks[ x ].ullDeadline / 1000.0,
+				 ( unsigned int ) ( x + 1U ),
+				 xTasks[ x ].cName,
+				 ( double ) xTasks[ x ].ullPeriod / 1000.0 );
+	}
+
+	fprintf( pxFile, "\t</tasks>\n" );
+	fprintf( pxFile, "</simulation>\n" );
+	fclose( pxFile );
+}
+/*-----------------------------------------------------------*/
+
+static void prvUsage( void )
+{
+	fprintf( stderr, "usage: edf_analyzer [-t tick_hz] [-w wcet_frame] [-c counter_hz] [-l limit_us] [-s] [-x simso.xml] tasks\n" );
+	exit( 2 );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+unsigned long ulTickHz = anDEFAULT_TICK_HZ, ulCounterHz = 0UL, ulSteps = 0UL;
+uint64_t ullLimit = anDEFAULT_LIMIT_US, ullBusyPeriod = 0ULL, ullHyperperiod, ullMaxOffset = 0ULL, ullDuration, ullFailedAt = 0ULL, ullMisses;
+const char *pcTasks = NULL, *pcFrame = NULL, *pcSimso = NULL;
+long double xUtilization = 0.0L, xDensity = 0.0L;
+int iPrint = 0, iSchedulable, iArg;
+size_t x;
+
+	for( iArg = 1; iArg < argc; iArg++ )
+	{
+		if( ( argv[ iArg ][ 0 ] == '-' ) && ( argv[ iArg ][ 1 ] != '\0' ) && ( argv[ iArg ][ 2 ] == '\0' ) )
+		{
+			if( argv[ iArg ][ 1 ] == 's' )
+			{
+				iPrint = 1;
+				continue;
+			}
+
+			if( iArg + 1 >= argc )
+			{
+				prvUsage();
+			}
+
+			switch( argv[ iArg ][ 1 ] )
+			{
+				case 't': ulTickHz = strtoul( argv[ ++iArg ], NULL, 0 ); break;
+				case 'c': ulCounterHz = strtoul( argv[ ++iArg ], NULL, 0 ); break;
+				case 'l': ullLimit = strtoull( argv[ ++iArg ], NULL, 0 ); break;
+				case 'w': pcFrame = argv[ ++iArg ]; break;
+				case 'x': pcSimso = argv[ ++iArg ]; break;
+				default: prvUsage(); break;
+			}
+		}
+		else if( pcTasks == NULL )
+		{
+			pcTasks = argv[ iArg ];
+		}
+		else
+		{
+			prvUsage();
+		}
+	}
+
+	if( ( pcTasks == NULL ) || ( ulTickHz == 0UL ) || ( ullLimit == 0ULL ) )
+	{
+		prvUsage();
+	}
+
+	prvReadTasks( pcTasks, ulTickHz );
+
+	if( pcFrame != NULL )
+	{
+		prvApplyWcetFrame( pcFrame, ulCounterHz );
+	}
+
+	for( x = 0U; x < xTaskCount; x++ )
+	{
+		xUtilization += ( long double ) xTasks[ x ].ullWcet / ( long double ) xTasks[ x ].ullPeriod;
+		xDensity += ( long double ) xTasks[ x ].ullWcet / ( long double ) ( ( xTasks[ x ].ullDeadline < xTasks[ x ].ullPeriod ) ? xTasks[ x ].ullDeadline : xTasks[ x ].ullPeriod );
+
+		if( xTasks[ x ].ullOffset > ullMaxOffset )
+		{
+			ullMaxOffset = xTasks[ x ].ullOffset;
+		}
+	}
+
+	/* Processor demand criterion. */
+	if( xUtilization > 1.0L )
+	{
+		iSchedulable = 0;
+		printf( "Not schedulable: utilization %.4Lf is above 1.\n", xUtilization );
+	}
+	else
+	{
+		ullBusyPeriod = prvSynchronousBusyPeriod( UINT64_MAX / 2ULL );
+		iSchedulable = prvQpa( xUtilization, ullBusyPeriod, &ullFailedAt, &ulSteps );
+
+		for( x = 0U; x < xTaskCount; x++ )
+		{
+			xTasks[ x ].ullWcrt = prvWorstCaseResponseTime( x, ullBusyPeriod );
+		}
+
+		printf( "Utilization %.4Lf, density %.4Lf, synchronous busy period %llu us.\n", xUtilization, xDensity, ( unsigned long long ) ullBusyPeriod );
+
+		if( iSchedulable != 0 )
+		{
+			printf( "Schedulable: QPA checked the processor demand in %lu steps.\n", ulSteps );
+		}
+		else
+		{
+			printf( "Not schedulable: the demand up to %llu us is %llu us.\n", ( unsigned long long ) ullFailedAt, ( unsigned long long ) prvDemand( ullFailedAt ) );
+		}
+	}
+
+	/* A synchronous schedule repeats every hyperperiod, one with offsets
+	after the largest offset plus two hyperperiods. */
+	ullHyperperiod = prvHyperperiod( ullLimit );
+
+	if( ullHyperperiod == 0ULL )
+	{
+		ullDuration = ullLimit;
+		printf( "The hyperperiod is longer than %llu us, simulating only that long.\n", ( unsigned long long ) ullLimit );
+	}
+	else
+	{
+		ullDuration = ( ullMaxOffset == 0ULL ) ? ullHyperperiod : ( ullMaxOffset + ( 2ULL * ullHyperperiod ) );
+
+		if( ullDuration > ullLimit )
+		{
+			ullDuration = ullLimit;
+		}
+
+		printf( "Hyperperiod %llu us, simulating %llu us.\n", ( unsigned long long ) ullHyperperiod, ( unsigned long long ) ullDuration );
+	}
+
+	ullMisses = prvSimulate( ullDuration, iPrint );
+
+	printf( "\n%-16s %10s %10s %10s %10s %8s %10s %10s %8s %8s\n", "task", "T (us)", "D (us)", "C (us)", "O (us)", "U", "WCRT (us)", "max R (us)", "jobs", "misses" );
+
+	for( x = 0U; x < xTaskCount; x++ )
+	{
+		printf( "%-16s %10llu %10llu %10llu %10llu %8.4f ",
+				xTasks[ x ].cName,
+				( unsigned long long ) xTasks[ x ].ullPeriod,
+				( unsigned long long ) xTasks[ x ].ullDeadline,
+				( unsigned long long ) xTasks[ x ].ullWcet,
+				( unsigned long long ) xTasks[ x ].ullOffset,
+				( double ) xTasks[ x ].ullWcet / ( double ) xTasks[ x ].ullPeriod );
+
+		if( xUtilization > 1.0L )
+		{
+			printf( "%10s ", "-" );
+		}
+		else
+		{
+			printf( "%10llu ", ( unsigned long long ) xTasks[ x ].ullWcrt );
+		}
+
+		printf( "%10llu %8llu %8llu\n", ( unsigned long long ) xTasks[ x ].ullMaxResponse, ( unsigned long long ) xTasks[ x ].ullJobs, ( unsigned long long ) xTasks[ x ].ullMisses );
+	}
+
+	printf( "\nSimulation: %llu deadline misses.\n", ( unsigned long long ) ullMisses );
+
+	if( pcSimso != NULL )
+	{
+		prvWriteSimso( pcSimso, ullDuration );
+		printf( "SimSo task set written to %s.\n", pcSimso );
+	}
+
+	return ( iSchedulable != 0 ) ? 0 : 1;
+}